@@ -5,6 +5,7 @@ import subprocess
 import random
 import timeit
 import socket
+import struct
 
 sysTempDir = None
 if ('SLURM_JOB_ID' in os.environ):
@@ -64,20 +65,36 @@ def genOrigLFR(N, mink=20, maxk=50, mu=0.3, t1=-2, t2=-1, minc=20, maxc=100, on=
             C = graphio.EdgeListCoverReader(1).read(os.path.join(tempdir, "community.dat"), G)
         return (G, C)
 
+def readAdjacencyBlockStream(stream):
+    """Reads the BINSTREAM output of pa_lfr (see include/Utils/AdjacencyBlockStream.h)"""
+    magic, version, n = struct.unpack("=4sIQ", stream.read(16))
+    if magic != b"LFRA" or version != 1:
+        raise IOError("Input is not an adjacency block stream of version 1")
+
+    G = graph.Graph(n)
+    while True:
+        u, count = struct.unpack("=iI", stream.read(8))
+        if u == -1:
+            return G
+
+        for v in struct.unpack("={}i".format(count), stream.read(4 * count)):
+            G.addEdge(u, v)
+
 def genEMLFR(N, mink=20, maxk=50, mu=0.3, t1=-2, t2=-1, minc=20, maxc=100, on=0, om=0, outf=subprocess.STDOUT):
     with tempfile.TemporaryDirectory(dir=sysTempDir) as tempdir:
-        network_filename = os.path.join(tempdir, "foo.metis.graph")
         partition_filename = os.path.join(tempdir, "foo.part")
-        args = ["/usr/bin/time", "-av", "{}/../release/pa_lfr".format(current_directory), "-n", N, "-c", int(N/minc), "-i", mink, "-a", maxk, "-m", mu, "-j", t1, "-z", t2, "-x", minc, "-y", maxc, "-o", network_filename, "-p", partition_filename, "-b", "15Gi"]
+        # the graph is streamed through stdout while it is generated, log messages go to stderr
+        args = ["/usr/bin/time", "-av", "{}/../release/pa_lfr".format(current_directory), "-n", N, "-c", int(N/minc), "-i", mink, "-a", maxk, "-m", mu, "-j", t1, "-z", t2, "-x", minc, "-y", maxc, "-t", "BINSTREAM", "-o", "-", "-p", partition_filename, "-b", "15Gi"]
         if on > 0:
             args.extend(["-l", on, "-k", om])
 
         print("Call " + " ".join(map(str, args)))
 
         with Walltime("EMLFR"):
-           subprocess.call(map(str, args), stdout=outf, stderr=outf)
-
-        G = graphio.readGraph(network_filename, fileformat=graphio.Format.METIS)
+           # stderr must not be merged into the graph stream
+           proc = subprocess.Popen(list(map(str, args)), stdout=subprocess.PIPE, stderr=(None if outf == subprocess.STDOUT else outf))
+           G = readAdjacencyBlockStream(proc.stdout)
+           proc.wait()
 
         if on == 0:
             C = community.readCommunities(partition_filename, format='edgelist-s0')
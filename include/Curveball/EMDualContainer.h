@@ -19,6 +19,7 @@
 #include <Utils/ScopedTimer.h>
 #include <Utils/IntSort.h>
 #include <Utils/AlignedRNGs.h>
+#include <Utils/NumaPlacement.h>
 #include "CurveballHelper.h"
 
 namespace Curveball {
@@ -344,8 +345,12 @@ namespace Curveball {
 			_hash_funcs(hash_funcs),
 			_has_run(false)
 		{
-			// set up common and disjoint vectors for each thread
-			for (int thread_id = 0; thread_id < _num_threads; thread_id++) {
+			// set up common and disjoint vectors for each thread, allocated
+			// by the thread using them to keep them on its NUMA node
+			#pragma omp parallel num_threads(_num_threads)
+			{
+				const int thread_id = omp_get_thread_num();
+				NumaPlacement::ThreadPin pin(thread_id, _num_threads);
 				_t_common_neighbours[thread_id].reserve(static_cast<size_t>(_mc_max_degree));
 				_t_disjoint_neighbours[thread_id].reserve(static_cast<size_t>(_mc_max_degree));
 			}
@@ -554,30 +559,35 @@ namespace Curveball {
 					#endif
 
 					// Building adjacency structure
-					#pragma omp parallel for num_threads(_num_threads)
-					for (degree_t presum_id = 0;
-						 presum_id < static_cast<degree_t>(_mc_thread_bounds.size());
-						 presum_id++) {
-						for (node_t mc_node = _mc_thread_bounds.l_bounds[presum_id];
-							 mc_node < _mc_thread_bounds.u_bounds[presum_id];
-							 mc_node++) {
-							for (degree_t inc_msg_id = 0;
-								 inc_msg_id < _mc_num_inc_msgs[mc_node];
-								 inc_msg_id++) {
-								// insert
-								_mc_adjacency_list.insert_neighbour_at
-									(mc_node,
-									 msgs[_mc_num_inc_msgs_psum[mc_node]
-										  + inc_msg_id].neighbour,
-									 inc_msg_id);
-								#ifndef NDEBUG
-								is_read[_mc_num_inc_msgs_psum[mc_node] + inc_msg_id] = 1;
-								#endif
-							}
-							// set offset
-							_mc_adjacency_list.set_offset(mc_node, _mc_num_inc_msgs[mc_node]);
-						} // insert neighbours
-					} // insert batch of neighbours of nodes (no conflict) in parallel
+					#pragma omp parallel num_threads(_num_threads)
+					{
+						NumaPlacement::ThreadPin pin(omp_get_thread_num(), _num_threads);
+
+						#pragma omp for
+						for (degree_t presum_id = 0;
+							 presum_id < static_cast<degree_t>(_mc_thread_bounds.size());
+							 presum_id++) {
+							for (node_t mc_node = _mc_thread_bounds.l_bounds[presum_id];
+								 mc_node < _mc_thread_bounds.u_bounds[presum_id];
+								 mc_node++) {
+								for (degree_t inc_msg_id = 0;
+									 inc_msg_id < _mc_num_inc_msgs[mc_node];
+									 inc_msg_id++) {
+									// insert
+									_mc_adjacency_list.insert_neighbour_at
+										(mc_node,
+										 msgs[_mc_num_inc_msgs_psum[mc_node]
+											  + inc_msg_id].neighbour,
+										 inc_msg_id);
+									#ifndef NDEBUG
+									is_read[_mc_num_inc_msgs_psum[mc_node] + inc_msg_id] = 1;
+									#endif
+								}
+								// set offset
+								_mc_adjacency_list.set_offset(mc_node, _mc_num_inc_msgs[mc_node]);
+							} // insert neighbours
+						} // insert batch of neighbours of nodes (no conflict) in parallel
+					}
 
 					// if odd number of nodes, insert those messages too
 					// these are later forwarded but not used
@@ -674,85 +684,90 @@ namespace Curveball {
 					assert(_b_largest_hnode <= _mc_largest_hnode);
 
 					// each processor gets its own microchunk here
-					#pragma omp parallel for num_threads(_num_threads)
-					for (uint32_t bound_ix = batch * _num_threads * _num_fanout;
-						 bound_ix < (batch + 1) * _num_threads * _num_fanout;
-						 bound_ix++)
+					#pragma omp parallel num_threads(_num_threads)
 					{
-						// iterate over own microchunk in 2-step
-						for (node_t mc_node = _mc_thread_bounds.l_bounds[bound_ix];
-							 mc_node < make_even_by_sub(_mc_thread_bounds.u_bounds[bound_ix]);
-							 mc_node = mc_node + 2)
-						{
-							if (UNLIKELY(_mc_adjacency_list.has_traded(mc_node)
-										 || _mc_adjacency_list.has_traded(mc_node + 1))) {
-								continue;
-							}
-
-							// we subtract one, so that another thread cannot enter its workstealing phase
-							if (UNLIKELY(std::atomic_fetch_sub(&_active_threads[mc_node], 1) < 0)) {
-								std::atomic_fetch_add(&_active_threads[mc_node], 1);
-								continue;
-							}
-							if (UNLIKELY(std::atomic_fetch_sub(&_active_threads[mc_node + 1], 1) < 0)) {
-								std::atomic_fetch_add(&_active_threads[mc_node], 1);
-								std::atomic_fetch_add(&_active_threads[mc_node + 1], 1);
-								continue;
-							}
-
-							const int thread_id = omp_get_thread_num();
-
-							// again remember:
-							// we identify hash-values with the macrochunk id,
-							// therefore use mc_node
-							const node_t mc_node_u = mc_node;
-							const node_t mc_node_v = mc_node + 1;
-
-							assert(_mc_has_traded[mc_node_u] == _mc_adjacency_list.has_traded(mc_node_u));
-							assert(_mc_has_traded[mc_node_v] == _mc_adjacency_list.has_traded(mc_node_v));
-							assert(_mc_has_traded[mc_node_u] == _mc_has_traded[mc_node_v]);
-
-							if (!_mc_adjacency_list.has_traded(mc_node_u)
-								&& !_mc_adjacency_list.has_traded(mc_node_v)) {
-								// not traded yet
+						NumaPlacement::ThreadPin pin(omp_get_thread_num(), _num_threads);
 
-								// check sentinel
-								assert(*(_mc_adjacency_list.cbegin(mc_node_u + 1) - 1) == LISTROW_END);
-								assert(*(_mc_adjacency_list.cbegin(mc_node_v + 1) - 1) == LISTROW_END);
+						#pragma omp for
+						for (uint32_t bound_ix = batch * _num_threads * _num_fanout;
+							 bound_ix < (batch + 1) * _num_threads * _num_fanout;
+							 bound_ix++)
+						{
+							// iterate over own microchunk in 2-step
+							for (node_t mc_node = _mc_thread_bounds.l_bounds[bound_ix];
+								 mc_node < make_even_by_sub(_mc_thread_bounds.u_bounds[bound_ix]);
+								 mc_node = mc_node + 2)
+							{
+								if (UNLIKELY(_mc_adjacency_list.has_traded(mc_node)
+											 || _mc_adjacency_list.has_traded(mc_node + 1))) {
+									continue;
+								}
 
-								// ========= retrieve respective neighbours ========
+								// we subtract one, so that another thread cannot enter its workstealing phase
+								if (UNLIKELY(std::atomic_fetch_sub(&_active_threads[mc_node], 1) < 0)) {
+									std::atomic_fetch_add(&_active_threads[mc_node], 1);
+									continue;
+								}
+								if (UNLIKELY(std::atomic_fetch_sub(&_active_threads[mc_node + 1], 1) < 0)) {
+									std::atomic_fetch_add(&_active_threads[mc_node], 1);
+									std::atomic_fetch_add(&_active_threads[mc_node + 1], 1);
+									continue;
+								}
 
-								// we use mc_invs[mc_hashes[mc_node_u]] since again,
-								// cleartext in neighbours
+								const int thread_id = omp_get_thread_num();
+
+								// again remember:
+								// we identify hash-values with the macrochunk id,
+								// therefore use mc_node
+								const node_t mc_node_u = mc_node;
+								const node_t mc_node_v = mc_node + 1;
+
+								assert(_mc_has_traded[mc_node_u] == _mc_adjacency_list.has_traded(mc_node_u));
+								assert(_mc_has_traded[mc_node_v] == _mc_adjacency_list.has_traded(mc_node_v));
+								assert(_mc_has_traded[mc_node_u] == _mc_has_traded[mc_node_v]);
+
+								if (!_mc_adjacency_list.has_traded(mc_node_u)
+									&& !_mc_adjacency_list.has_traded(mc_node_v)) {
+									// not traded yet
+
+									// check sentinel
+									assert(*(_mc_adjacency_list.cbegin(mc_node_u + 1) - 1) == LISTROW_END);
+									assert(*(_mc_adjacency_list.cbegin(mc_node_v + 1) - 1) == LISTROW_END);
+
+									// ========= retrieve respective neighbours ========
+
+									// we use mc_invs[mc_hashes[mc_node_u]] since again,
+									// cleartext in neighbours
+
+									// check number inc messages
+									if (!_mc_adjacency_list.tradable(mc_node_u, mc_node_v))
+									{
+										std::atomic_fetch_add(&_active_threads[mc_node_u], 1);
+										std::atomic_fetch_add(&_active_threads[mc_node_v], 1);
+
+										continue;
+									}
+
+									// actual trading happens here
+									// call the lambda here
+									// no works-sttealing therefore false
+									trade(mc_node_u,
+										  mc_node_v,
+										  _mc_adjacency_list.get_edge_in_partner(mc_node_u),
+										  false,
+										  _t_common_neighbours[thread_id],
+										  _t_disjoint_neighbours[thread_id],
+										  thread_id
+									);
+								} else {
+									// if two nodes have already been traded
 
-								// check number inc messages
-								if (!_mc_adjacency_list.tradable(mc_node_u, mc_node_v))
-								{
 									std::atomic_fetch_add(&_active_threads[mc_node_u], 1);
 									std::atomic_fetch_add(&_active_threads[mc_node_v], 1);
-
-									continue;
 								}
-
-								// actual trading happens here
-								// call the lambda here
-								// no works-sttealing therefore false
-								trade(mc_node_u,
-									  mc_node_v,
-									  _mc_adjacency_list.get_edge_in_partner(mc_node_u),
-									  false,
-									  _t_common_neighbours[thread_id],
-									  _t_disjoint_neighbours[thread_id],
-									  thread_id
-								);
-							} else {
-								// if two nodes have already been traded
-
-								std::atomic_fetch_add(&_active_threads[mc_node_u], 1);
-								std::atomic_fetch_add(&_active_threads[mc_node_v], 1);
-							}
-						} // for-loop over nodes in microchunk
-					} // omp parallel for-loop over microchunks
+							} // for-loop over nodes in microchunk
+						} // omp parallel for-loop over microchunks
+					}
 
 					#ifdef BATCH_DEPS
 					std::cout << "Batch dependencies: " << batch_dep_count.load() << std::endl;
@@ -9,6 +9,8 @@
 #include "defs.h"
 #include "IMMacrochunk.h"
 #include "Utils/Hashfuncs.h"
+#include <Utils/NumaPlacement.h>
+#include <omp.h>
 #include <stx/btree_map>
 
 namespace Curveball {
@@ -88,10 +90,13 @@ namespace Curveball {
 				_upper_bounds.insert(upper_bounds[id], id);
 			}
 
-			// initialize insertion buffers
-			_insertion_buffer_vector.reserve(static_cast<size_t>(_num_threads));
-			for (int thread_id = 0; thread_id < _num_threads; thread_id++) {
-				_insertion_buffer_vector.emplace_back();
+			// initialize insertion buffers, allocated by the thread filling
+			// them to keep them on its NUMA node
+			_insertion_buffer_vector.resize(static_cast<size_t>(_num_threads));
+			#pragma omp parallel num_threads(_num_threads)
+			{
+				const int thread_id = omp_get_thread_num();
+				NumaPlacement::ThreadPin pin(thread_id, _num_threads);
 				_insertion_buffer_vector[thread_id].reserve(_num_chunks);
 				for (chunkid_t chunk_id = 0; chunk_id < _num_chunks; chunk_id++) {
 					_insertion_buffer_vector[thread_id].emplace_back();
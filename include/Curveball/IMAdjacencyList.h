@@ -225,6 +225,14 @@ namespace Curveball {
 			}
 		}
 
+		/**
+		 * Clears all flags indicating shared edges with partners without
+		 * deallocating the neighbours.
+		 */
+		void reset_edges_in_partner() {
+			std::fill(_edge_to_partner.begin(), _edge_to_partner.end(), false);
+		}
+
 		/**
 		 * Sets the flag that the given node shares an edge with its partner.
 		 * @param node_id Rank of node in the macrochunk.
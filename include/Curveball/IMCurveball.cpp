@@ -0,0 +1,229 @@
+/**
+ * @file IMCurveball.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ */
+
+#include "IMCurveball.h"
+#include "CurveballHelper.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <stxxl/random>
+
+namespace Curveball {
+
+	IMCurveball::IMCurveball(const degree_vector &degrees,
+							 const edge_vector &edges,
+							 int num_threads,
+							 seed_t seed) :
+		_num_nodes(static_cast<node_t>(degrees.size())),
+		_num_threads(std::max(num_threads, 1)),
+		_degrees(degrees),
+		_num_active_nodes(0),
+		_num_trades(0),
+		_degree_sum(0),
+		_gen(seed ? seed : stxxl::get_next_seed()),
+		_trade_seeds(_gen()),
+		_global_trade(0),
+		_thread_data(static_cast<size_t>(_num_threads)),
+		_next_ranks(degrees.size(), INVALID_NODE)
+	{
+		for (node_t u = 0; u < _num_nodes; ++u) {
+			if (_degrees[u] > 0) {
+				_invs.push_back(u);
+				_degree_sum += _degrees[u];
+			}
+		}
+
+		assert(_degree_sum == 2 * static_cast<edgeid_t>(edges.size()));
+
+		_num_active_nodes = static_cast<node_t>(_invs.size());
+		_num_trades = _num_active_nodes / 2;
+		_next_invs = _invs;
+		_rank_degrees.resize(_invs.size());
+
+		// last node does not trade if the number of nodes is odd
+		_partners.resize(_invs.size());
+		for (node_t r = 0; r < _num_active_nodes; ++r)
+			_partners[r] = (r < 2 * _num_trades ? r ^ 1 : r);
+
+		_adjacency_list.reset(new IMAdjacencyList(_num_active_nodes, _degree_sum));
+		_next_adjacency_list.reset(new IMAdjacencyList(_num_active_nodes, _degree_sum));
+		_pending = pending_vector(static_cast<size_t>(_num_trades));
+
+		_prepare_next_global_trade();
+
+		for (const edge_t &e : edges) {
+			assert(!e.is_loop());
+			_send_to_next(_next_ranks[e.first], _next_ranks[e.second]);
+		}
+	}
+
+	void IMCurveball::_prepare_next_global_trade() {
+		std::shuffle(_next_invs.begin(), _next_invs.end(), _gen);
+
+		for (node_t r = 0; r < _num_active_nodes; ++r) {
+			_next_ranks[_next_invs[r]] = r;
+			_rank_degrees[r] = _degrees[_next_invs[r]];
+		}
+
+		_next_adjacency_list->reset_edges_in_partner();
+		_next_adjacency_list->initialize(_rank_degrees,
+										 _partners,
+										 _num_active_nodes,
+										 _degree_sum);
+	}
+
+	void IMCurveball::run(const uint32_t num_global_trades) {
+		for (uint32_t round = 0; round < num_global_trades; ++round, ++_global_trade) {
+			// the edges are stored in the next container, make it active
+			std::swap(_adjacency_list, _next_adjacency_list);
+			std::swap(_invs, _next_invs);
+			_next_invs = _invs;
+
+			_prepare_next_global_trade();
+
+			// count the messages each trade still waits for
+			node_vector ready;
+			for (node_t t = 0; t < _num_trades; ++t) {
+				const node_t u = 2 * t;
+				const edgeid_t pending = _adjacency_list->degree_at(u)
+										 + _adjacency_list->degree_at(u + 1)
+										 - _adjacency_list->get_edge_in_partner(u)
+										 - _adjacency_list->received_msgs(u)
+										 - _adjacency_list->received_msgs(u + 1);
+				assert(pending >= 0);
+
+				_pending[t].store(pending, std::memory_order_relaxed);
+				if (!pending)
+					ready.push_back(u);
+			}
+
+			// the trade of the smallest ranks has no predecessors
+			assert(!_num_trades || (!ready.empty() && ready.front() == 0));
+
+			#pragma omp parallel num_threads(_num_threads)
+			#pragma omp single
+			{
+				for (size_t i = 0; i < ready.size(); ++i) {
+					node_t u = ready[i];
+					#pragma omp task firstprivate(u)
+					_process(u);
+				}
+			}
+
+			#ifndef NDEBUG
+			for (node_t t = 0; t < _num_trades; ++t)
+				assert(!_pending[t].load() && _adjacency_list->has_traded(2 * t));
+			#endif
+		}
+	}
+
+	void IMCurveball::_process(node_t u) {
+		node_vector ready;
+
+		while (true) {
+			_trade(u, ready);
+
+			if (ready.empty())
+				break;
+
+			// continue with one of the trades, spawn the others
+			for (size_t i = 1; i < ready.size(); ++i) {
+				node_t w = ready[i];
+				#pragma omp task firstprivate(w)
+				_process(w);
+			}
+
+			u = ready.front();
+			ready.clear();
+		}
+	}
+
+	void IMCurveball::_trade(const node_t u, node_vector &ready) {
+		const node_t v = u + 1;
+		assert(u % 2 == 0);
+		assert(_adjacency_list->tradable(u, v));
+
+		ThreadData &data = _thread_data[omp_get_thread_num() % _num_threads];
+		node_vector &common = data.common;
+		node_vector &disjoint = data.disjoint;
+
+		const bool shared_edge = _adjacency_list->get_edge_in_partner(u);
+
+		_adjacency_list->sort_row(u);
+		_adjacency_list->sort_row(v);
+
+		common.clear();
+		disjoint.clear();
+
+		// v may only occur in the row of u as the shared edge is stored at u
+		auto u_it = _adjacency_list->cbegin(u);
+		const auto u_end = _adjacency_list->cend(u);
+		auto v_it = _adjacency_list->cbegin(v);
+		const auto v_end = _adjacency_list->cend(v);
+
+		while (u_it != u_end && v_it != v_end) {
+			if (*u_it == v) {
+				++u_it;
+			} else if (*u_it < *v_it) {
+				disjoint.push_back(*u_it++);
+			} else if (*v_it < *u_it) {
+				disjoint.push_back(*v_it++);
+			} else {
+				common.push_back(*u_it);
+				++u_it;
+				++v_it;
+			}
+		}
+
+		for (; u_it != u_end; ++u_it) {
+			if (*u_it != v)
+				disjoint.push_back(*u_it);
+		}
+		disjoint.insert(disjoint.end(), v_it, v_end);
+
+		const size_t u_disjoint = static_cast<size_t>(_adjacency_list->degree_at(u))
+								  - shared_edge - common.size();
+		assert(u_disjoint <= disjoint.size());
+
+		SplitMix64Engine gen(_trade_seeds.key(_global_trade, static_cast<uint64_t>(u)));
+		CurveballImpl::random_partition(disjoint.begin(), disjoint.end(), u_disjoint, gen);
+
+		_adjacency_list->set_traded(u);
+		_adjacency_list->set_traded(v);
+
+		for (const node_t w : common) {
+			_send(u, w, ready);
+			_send(v, w, ready);
+		}
+
+		for (size_t i = 0; i < disjoint.size(); ++i)
+			_send(i < u_disjoint ? u : v, disjoint[i], ready);
+
+		if (shared_edge)
+			_send_to_next(_next_ranks[_invs[u]], _next_ranks[_invs[v]]);
+	}
+
+	IMCurveball::edge_vector IMCurveball::getEdges() const {
+		edge_vector edges;
+		edges.reserve(static_cast<size_t>(_degree_sum / 2));
+
+		// the edges are stored in the container of the next global trade
+		for (node_t r = 0; r < _num_active_nodes; ++r) {
+			for (auto it = _next_adjacency_list->cbegin(r); it != _next_adjacency_list->cend(r); ++it) {
+				edge_t e(_next_invs[r], _next_invs[*it]);
+				e.normalize();
+				edges.push_back(e);
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		return edges;
+	}
+
+}
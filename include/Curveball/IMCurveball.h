@@ -0,0 +1,197 @@
+/**
+ * @file IMCurveball.h
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ */
+
+#pragma once
+
+#include "defs.h"
+#include "IMAdjacencyList.h"
+#include <Utils/RandomSeeds.h>
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <omp.h>
+
+namespace Curveball {
+
+	/**
+	 * Multithreaded internal memory Curveball randomization of a simple
+	 * undirected graph, meant for graphs that fit into main memory such as
+	 * LFR communities.
+	 *
+	 * A global trade is executed on the nodes in the order of a random
+	 * permutation, trading the neighbourhoods of ranks 2i and 2i+1. As in
+	 * EMDualContainer, every edge is stored only at its endpoint that trades
+	 * first; after a trade the edge is sent to the neighbour if it trades
+	 * later in the same global trade, otherwise it is stored in the container
+	 * of the next global trade. A trade becomes executable as soon as all
+	 * messages of both partners arrived, which is tracked with an atomic
+	 * counter per trade. Executable trades are processed as OpenMP tasks.
+	 * The random bits of a trade are derived from the seed, the global trade
+	 * and the ranks, so the result does not depend on the number of threads.
+	 *
+	 * Nodes with degree zero do not participate in trades.
+	 */
+	class IMCurveball {
+	public:
+		using degree_vector = std::vector<degree_t>;
+		using node_vector = std::vector<node_t>;
+		using edge_vector = std::vector<edge_t>;
+		using pending_vector = std::vector<std::atomic<edgeid_t>>;
+
+	protected:
+		struct ThreadData {
+			node_vector common;
+			node_vector disjoint;
+		};
+
+		const node_t _num_nodes;
+		const int _num_threads;
+		degree_vector _degrees;
+
+		// number of nodes with non-zero degree and of pairs that trade
+		node_t _num_active_nodes;
+		node_t _num_trades;
+		edgeid_t _degree_sum;
+
+		STDRandomEngine _gen;
+		RandomSeeds _trade_seeds;
+		uint64_t _global_trade;
+		std::vector<ThreadData> _thread_data;
+
+		// nodes in the order of the current and next global trade
+		// and the rank of each node in the next global trade
+		node_vector _invs;
+		node_vector _next_invs;
+		node_vector _next_ranks;
+		degree_vector _rank_degrees;
+		node_vector _partners;
+
+		std::unique_ptr<IMAdjacencyList> _adjacency_list;
+		std::unique_ptr<IMAdjacencyList> _next_adjacency_list;
+
+		// number of messages each trade still waits for
+		pending_vector _pending;
+
+	public:
+		IMCurveball() = delete;
+		IMCurveball(const IMCurveball &) = delete;
+
+		/**
+		 * @param degrees Degree sequence of the graph, the node ids are
+		 * the indices.
+		 * @param edges Edges of a simple graph realizing the degree sequence
+		 * in arbitrary order.
+		 * @param num_threads Number of threads used for the trades.
+		 * @param seed Seed of the random generators; 0 selects
+		 * stxxl::get_next_seed().
+		 */
+		IMCurveball(const degree_vector &degrees,
+					const edge_vector &edges,
+					int num_threads = omp_get_max_threads(),
+					seed_t seed = 0);
+
+		/**
+		 * Executes the given number of global trades, may be called
+		 * repeatedly.
+		 * @param num_global_trades Number of global trades.
+		 */
+		void run(const uint32_t num_global_trades);
+
+		/**
+		 * @return Normalized edges of the graph sorted in ascending order.
+		 */
+		edge_vector getEdges() const;
+
+		/**
+		 * @return Number of edges of the graph.
+		 */
+		edgeid_t numEdges() const {
+			return _degree_sum / 2;
+		}
+
+		/**
+		 * @param num_nodes Number of nodes.
+		 * @param num_edges Number of edges.
+		 * @return Upper bound of the number of bytes needed by the algorithm.
+		 */
+		static uint_t memoryUsage(uint_t num_nodes, uint_t num_edges) {
+			// two adjacency lists with a sentinel per node, partners, offsets,
+			// shared-edge flags, row starts, locks and thread counts
+			const uint_t adjacency_list =
+				(2 * num_edges + num_nodes + 1) * sizeof(node_t)
+				+ num_nodes * (2 * sizeof(node_t) + sizeof(int)
+							   + sizeof(degree_t) + sizeof(edgeid_t)
+							   + sizeof(std::mutex) + sizeof(std::atomic<int>));
+
+			return 2 * adjacency_list
+				   + num_nodes * (5 * sizeof(node_t) + 2 * sizeof(degree_t))
+				   + (num_nodes / 2) * sizeof(std::atomic<edgeid_t>)
+				   + sizeof(IMCurveball);
+		}
+
+	protected:
+		/**
+		 * Draws the permutation of the next global trade and initializes
+		 * the next adjacency list accordingly.
+		 */
+		void _prepare_next_global_trade();
+
+		/**
+		 * Executes the trade with the given even rank and all trades that
+		 * become executable by it.
+		 * @param u Rank of the first trading partner.
+		 */
+		void _process(node_t u);
+
+		/**
+		 * Trades the neighbourhoods of ranks u and u + 1 and forwards the
+		 * edges.
+		 * @param u Rank of the first trading partner.
+		 * @param ready Receives the first ranks of trades that became
+		 * executable.
+		 */
+		void _trade(const node_t u, node_vector &ready);
+
+		/**
+		 * Forwards the edge {x, w} after x has been traded.
+		 * @param x Rank of the traded node.
+		 * @param w Rank of the neighbour.
+		 * @param ready Receives the first rank of the trade of w if it
+		 * became executable.
+		 */
+		void _send(const node_t x, const node_t w, node_vector &ready) {
+			const node_t last_traded = x | 1;
+
+			if (w < last_traded || w >= 2 * _num_trades) {
+				// w has been traded before or does not trade at all
+				_send_to_next(_next_ranks[_invs[x]], _next_ranks[_invs[w]]);
+				return;
+			}
+
+			_adjacency_list->insert_neighbour_without_check(w, x);
+			if (_pending[w / 2].fetch_sub(1) == 1)
+				ready.push_back(w & ~1);
+		}
+
+		/**
+		 * Stores the edge {u, v} given by ranks of the next global trade at
+		 * the endpoint that trades first.
+		 */
+		void _send_to_next(node_t u, node_t v) {
+			if (u > v)
+				std::swap(u, v);
+
+			_next_adjacency_list->insert_neighbour_without_check(u, v);
+			if (u % 2 == 0 && v == u + 1)
+				_next_adjacency_list->set_edge_in_partner(u);
+		}
+	};
+
+}
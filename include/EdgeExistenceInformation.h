@@ -1,14 +1,39 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <defs.h>
 #include <atomic>
 #include <thread>
+#include <type_traits>
 #include <Swaps.h>
 
+//! @tparam multigraph  If set, the number of copies of every existing edge is stored as well
+template <bool multigraph = false>
 class EdgeExistenceInformation {
 private:
-    std::vector<edge_t> _edges;
+    struct multigraph_entry_t {
+        edge_t edge;
+        degree_t multiplicity;
+    };
+
+    using entry_t = typename std::conditional<multigraph, multigraph_entry_t, edge_t>::type;
+
+    static multigraph_entry_t _make_entry(const edge_t& e, degree_t multiplicity, std::true_type) {
+        return multigraph_entry_t{e, multiplicity};
+    }
+
+    static edge_t _make_entry(const edge_t& e, degree_t, std::false_type) {
+        return e;
+    }
+
+    static const edge_t& _edge(const multigraph_entry_t& entry) { return entry.edge; }
+    static const edge_t& _edge(const edge_t& entry) { return entry; }
+
+    static degree_t _multiplicity(const multigraph_entry_t& entry) { return entry.multiplicity; }
+    static degree_t _multiplicity(const edge_t&) { return 1; }
+
+    std::vector<entry_t> _edges;
 
     struct swap_info_t {
         std::size_t start_index;
@@ -41,10 +66,10 @@ public:
         _edges.resize(sum);
     };
 
-    void push_exists(const swapid_t swap_id, const edge_t& e) {
+    void push_exists(const swapid_t swap_id, const edge_t& e, const degree_t multiplicity = 1) {
         swap_info_t &si = _swap_info[swap_id];
         uint32_t i = si.num_existing_entries++;
-        _edges[si.start_index + i] = e;
+        _edges[si.start_index + i] = _make_entry(e, multiplicity, std::integral_constant<bool, multigraph>());
         assert(si.start_index + i < _edges.size() && (static_cast<std::size_t>(swap_id + 1) == _swap_info.size() || si.start_index + i < _swap_info[swap_id + 1].start_index));
         --si.num_missing_entries;
     };
@@ -53,6 +78,11 @@ public:
         --_swap_info[swap_id].num_missing_entries;
     };
 
+    //! Number of entries of the swap that have not been pushed yet
+    uint32_t num_missing(const swapid_t swap_id) const {
+        return _swap_info[swap_id].num_missing_entries.load(std::memory_order_acquire);
+    };
+
     void wait_for_missing(const swapid_t swap_id) {
         while (_swap_info[swap_id].num_missing_entries.load(std::memory_order_seq_cst) > 0) {
             std::this_thread::yield();
@@ -60,10 +90,16 @@ public:
     };
 
     bool exists(const swapid_t swap_id, const edge_t& e) {
+        return multiplicity(swap_id, e) > 0;
+    };
+
+    //! Number of copies of edge e known to the swap; 0 if it does not exist
+    degree_t multiplicity(const swapid_t swap_id, const edge_t& e) {
         assert(_swap_info[swap_id].num_missing_entries == 0);
         auto begin_it = _edges.begin() + _swap_info[swap_id].start_index;
         auto end_it = begin_it + _swap_info[swap_id].num_existing_entries;
         // check if linear search is okay here or if we need to sort the existence info
-        return (std::find(begin_it, end_it, e) != end_it);
+        auto it = std::find_if(begin_it, end_it, [&e] (const entry_t& entry) {return _edge(entry) == e;});
+        return (it != end_it) ? _multiplicity(*it) : 0;
     };
 };
\ No newline at end of file
@@ -4,9 +4,87 @@
 #include <stxxl/sequence>
 #include <memory>
 
-class EdgeStream {
+//! Payload of topology-only edges; EdgeStream stores nothing for it
+struct EmptyPayload {};
+
+/**
+ * Payloads of the edges of a BasicEdgeStream in the order of the edges, e.g. weights.
+ * They are kept in a separate sequence, so reading and writing edges is unchanged.
+ */
+template <typename Payload>
+class EdgePayloadBuffer {
+    using em_buffer_t = stxxl::sequence<Payload>;
+    using em_reader_t = typename em_buffer_t::stream;
+
+    std::unique_ptr<em_buffer_t> _em_buffer;
+    std::unique_ptr<em_reader_t> _em_reader;
+    Payload _current;
+
+public:
+    EdgePayloadBuffer() : _current() {}
+
+    EdgePayloadBuffer(EdgePayloadBuffer&&) = default;
+    EdgePayloadBuffer& operator=(EdgePayloadBuffer&&) = default;
+
+    ~EdgePayloadBuffer() {
+        _em_reader.reset(nullptr);
+        _em_buffer.reset(nullptr);
+    }
+
+    void clear() {
+        _em_reader.reset(nullptr);
+        _em_buffer.reset(new em_buffer_t(16, 16));
+    }
+
+    void push(const Payload & payload) {
+        _em_buffer->push_back(payload);
+    }
+
+    void rewind() {
+        _em_reader.reset(new em_reader_t(*_em_buffer));
+    }
+
+    //! Reads the payload of the next edge
+    void next() {
+        assert(!_em_reader->empty());
+        _current = **_em_reader;
+        ++(*_em_reader);
+    }
+
+    const Payload & current() const {
+        return _current;
+    }
+};
+
+//! No storage and no work for topology-only edges
+template <>
+class EdgePayloadBuffer<EmptyPayload> {
+    EmptyPayload _current;
+
+public:
+    void clear() {}
+    void push(const EmptyPayload &) {}
+    void rewind() {}
+    void next() {}
+
+    const EmptyPayload & current() const {
+        return _current;
+    }
+};
+
+/**
+ * External memory stream of edges in lexicographic order, stored as adjacency lists
+ * of the first nodes. Edges are stored as pushed and never normalized, so the stream
+ * also holds the arcs of a digraph sorted by (source, target), e.g. for DirectedEdgeSwapTFP.
+ *
+ * Every edge may carry a Payload (e.g. a weight) available via payload() while reading;
+ * EdgeStream is the topology-only stream without any overhead.
+ */
+template <typename Payload = EmptyPayload>
+class BasicEdgeStream {
 public:
     using value_type = edge_t;
+    using payload_type = Payload;
 
 protected:
     using em_buffer_t = stxxl::sequence<node_t>;
@@ -33,24 +111,26 @@ protected:
     value_type _current;
     bool _empty;
 
+    EdgePayloadBuffer<Payload> _payloads;
+
 public:
-    EdgeStream(bool multi_edges = true, bool loops = true)
+    BasicEdgeStream(bool multi_edges = true, bool loops = true)
         : _allow_multi_edges(multi_edges)
         , _allow_loops(loops)
         , _current(edge_t::invalid())
     {clear();}
 
-    EdgeStream(const EdgeStream &) = delete; // ; , bool multi_edges = false, bool loops = false) = delete;
+    BasicEdgeStream(const BasicEdgeStream &) = delete; // ; , bool multi_edges = false, bool loops = false) = delete;
 
-    ~EdgeStream() {
+    ~BasicEdgeStream() {
         // in this order ;)
         _em_reader.reset(nullptr);
         _em_buffer.reset(nullptr);
     }
 
-    EdgeStream(EdgeStream&&) = default;
+    BasicEdgeStream(BasicEdgeStream&&) = default;
     
-    EdgeStream& operator=(EdgeStream&&) = default;
+    BasicEdgeStream& operator=(BasicEdgeStream&&) = default;
 
     // Hung enable multi-edges and loops
     void enableModifiedTFP() {
@@ -59,7 +139,7 @@ public:
     }
 
 // Write interface
-    void push(const edge_t& edge) {
+    void push(const edge_t& edge, const Payload& payload = Payload()) {
         assert(_mode == WRITING);
 
         // count selfloops and fail if they are illegal
@@ -87,6 +167,7 @@ public:
         }
 
         em_buffer.push_back(edge.second);
+        _payloads.push(payload);
         _number_of_edges++;
 
         _current = edge;
@@ -99,6 +180,7 @@ public:
     void rewind() {
         _mode = READING;
         _em_reader.reset(new em_reader_t(*_em_buffer));
+        _payloads.rewind();
         _current = {0, 0};
         _empty = _em_reader->empty();
 
@@ -115,6 +197,7 @@ public:
         _number_of_selfloops = 0;
         _em_reader.reset(nullptr);
         _em_buffer.reset(new em_buffer_t(16, 16));
+        _payloads.clear();
     }
 
     //! Number of edges available if rewind was called
@@ -146,8 +229,14 @@ public:
         return &_current;
     }
 
+    //! Payload of the current edge
+    const Payload& payload() const {
+        assert(READING == _mode);
+        return _payloads.current();
+    }
 
-    EdgeStream& operator++() {
+
+    BasicEdgeStream& operator++() {
         assert(READING == _mode);
         assert(!_empty);
 
@@ -169,7 +258,10 @@ public:
 
         _current.second = *reader;
         ++reader;
+        _payloads.next();
 
         return *this;
     }
 };
+
+using EdgeStream = BasicEdgeStream<>;
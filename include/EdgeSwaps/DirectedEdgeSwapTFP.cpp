@@ -0,0 +1,34 @@
+#include "DirectedEdgeSwapTFP.h"
+
+#include <stdexcept>
+
+namespace EdgeSwapTFP {
+    DirectedEdgeEncoding::DirectedEdgeEncoding(EdgeStream &arcs, node_t num_nodes)
+        : _num_arc_nodes(num_nodes)
+        , _encoded_edges(false, false)
+    {
+        if (UNLIKELY(num_nodes > (INVALID_NODE - 1) / 2)) {
+            throw std::runtime_error("Error, too many nodes for directed edge swaps; the encoding needs two ids per node");
+        }
+
+        for (arcs.rewind(); !arcs.empty(); ++arcs) {
+            assert(arcs->first < num_nodes && arcs->second < num_nodes);
+            _encoded_edges.push(encode(*arcs, num_nodes));
+        }
+        _encoded_edges.consume();
+
+        // only one copy of the graph is kept
+        arcs.clear();
+    }
+
+    void DirectedEdgeSwapTFP::run() {
+        EdgeSwapTFP::run();
+
+        _arcs.clear();
+        for (_encoded_edges.rewind(); !_encoded_edges.empty(); ++_encoded_edges) {
+            _arcs.push(decode(*_encoded_edges, _num_arc_nodes));
+        }
+        _arcs.consume();
+        _encoded_edges.rewind();
+    }
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <EdgeSwaps/EdgeSwapTFP.h>
+
+namespace EdgeSwapTFP {
+    /**
+     * Maps arcs of a digraph with num_nodes nodes to edges of the bipartite graph of
+     * out- and in-copies of the nodes: the arc (u, v) becomes the edge {u, v + num_nodes}.
+     *
+     * The encoded edges are normalized and sorted in the same order as the arcs, so
+     * both directions are a single scan. A degree-preserving swap of the arcs (a, b) and
+     * (c, d) into (c, b) and (a, d) is the swap of the encoded edges with direction true.
+     */
+    class DirectedEdgeEncoding {
+    protected:
+        const node_t _num_arc_nodes;
+        EdgeStream _encoded_edges;
+
+        //! Encodes arcs into _encoded_edges and clears arcs
+        DirectedEdgeEncoding(EdgeStream &arcs, node_t num_nodes);
+
+    public:
+        static edge_t encode(const edge_t & arc, node_t num_nodes) {
+            return {arc.first, arc.second + num_nodes};
+        }
+
+        static edge_t decode(const edge_t & edge, node_t num_nodes) {
+            return {edge.first, edge.second - num_nodes};
+        }
+    };
+
+    /**
+     * Degree-preserving swaps of the arcs of a digraph, i.e. in- and out-degrees of all
+     * nodes are maintained. The arcs (a, b) and (c, d) become (c, b) and (a, d); a swap
+     * is rejected if it would produce a loop or an existing arc (as usual, the direction
+     * of a SwapDescriptor is ignored).
+     *
+     * The swaps are executed by EdgeSwapTFP on the DirectedEdgeEncoding of the arcs and
+     * have the same I/O complexity. The arcs are read from an EdgeStream sorted by
+     * (source, target) without loops and multi-arcs; both (u, v) and (v, u) may exist.
+     * The stream is cleared while the swaps are pending and holds the result after run().
+     */
+    class DirectedEdgeSwapTFP : private DirectedEdgeEncoding, public EdgeSwapTFP {
+    protected:
+        EdgeStream & _arcs;
+
+    public:
+        DirectedEdgeSwapTFP() = delete;
+        DirectedEdgeSwapTFP(const DirectedEdgeSwapTFP &) = delete;
+
+        //! @param arcs  Arcs changed in-place
+        //! @param run_length  Swaps per scan of the arcs or auto_run_length
+        //! @param num_nodes  Number of nodes, i.e. all ids are smaller
+        //! @param im_memory  Memory budget of the internal data structures
+        DirectedEdgeSwapTFP(EdgeStream &arcs, const swapid_t& run_length, const node_t& num_nodes, const size_t& im_memory) :
+            DirectedEdgeEncoding(arcs, num_nodes),
+            EdgeSwapTFP(_encoded_edges, run_length, 2 * num_nodes, im_memory),
+            _arcs(arcs)
+        {
+            _loop_offset = num_nodes;
+        }
+
+        void push(const SwapDescriptor & swap) {
+            EdgeSwapTFP::push(SwapDescriptor(swap.edges()[0], swap.edges()[1], true));
+        }
+
+        //! Executes all pushed swaps and writes the arcs back into the stream
+        void run();
+    };
+};
+
+template <>
+struct EdgeSwapTrait<EdgeSwapTFP::DirectedEdgeSwapTFP> {
+    static bool swapVector() {return false;}
+    static bool pushableSwaps() {return true;}
+    static bool pushableSwapBuffers() {return false;}
+    static bool edgeStream() {return true;}
+};
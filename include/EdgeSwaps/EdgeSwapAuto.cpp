@@ -0,0 +1,32 @@
+#include <EdgeSwaps/EdgeSwapAuto.h>
+
+EdgeSwapAuto::Engine EdgeSwapAuto::selectEngine(node_t num_nodes, edgeid_t num_edges, size_t im_memory) {
+    if (num_edges >= IMGraph::maxEdges())
+        return ExternalMemory;
+
+    // IMGraph, the degree sequence of IMGraphWrapper and the sorter writing the edges back
+    const size_t im_usage = IMGraph::memoryUsage(num_nodes, num_edges)
+                          + num_nodes * sizeof(degree_t)
+                          + SORTER_MEM;
+
+    return im_usage < im_memory ? InternalMemory : ExternalMemory;
+}
+
+EdgeSwapAuto::EdgeSwapAuto(EdgeStream & edges, node_t num_nodes, size_t im_memory, swapid_t run_length)
+    : EdgeSwapBase(),
+      _engine(selectEngine(num_nodes, edges.size(), im_memory))
+{
+    if (_engine == InternalMemory) {
+        _im_swaps.reset(new IMEdgeSwap(edges));
+    } else {
+        _em_swaps.reset(new EdgeSwapTFP::EdgeSwapTFP(edges, run_length, num_nodes, im_memory));
+    }
+}
+
+void EdgeSwapAuto::run() {
+    if (_engine == InternalMemory) {
+        _im_swaps->run();
+    } else {
+        _em_swaps->run();
+    }
+}
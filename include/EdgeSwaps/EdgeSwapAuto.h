@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+
+#include <defs.h>
+#include <EdgeStream.h>
+#include "EdgeSwapBase.h"
+#include "EdgeSwapTFP.h"
+#include "IMEdgeSwap.h"
+
+/**
+ * @brief Edge swaps on an EdgeStream using the fastest engine fitting into the memory budget
+ *
+ * If the graph fits into the internal memory budget, the edge stream is loaded
+ * into an IMGraph and swapped by IMEdgeSwap; run() writes the result back into
+ * the edge stream. Otherwise the swaps are forwarded to EdgeSwapTFP.
+ * Both engines interpret swaps identically within a run of EdgeSwapTFP.
+ */
+class EdgeSwapAuto : public EdgeSwapBase {
+public:
+    enum Engine {
+        InternalMemory, ///< IMEdgeSwap on an IMGraph
+        ExternalMemory  ///< EdgeSwapTFP
+    };
+
+    //! Engine used for a graph with the given size and memory budget
+    static Engine selectEngine(node_t num_nodes, edgeid_t num_edges, size_t im_memory);
+
+protected:
+    const Engine _engine;
+    std::unique_ptr<IMEdgeSwap> _im_swaps;
+    std::unique_ptr<EdgeSwapTFP::EdgeSwapTFP> _em_swaps;
+
+public:
+    EdgeSwapAuto() = delete;
+    EdgeSwapAuto(const EdgeSwapAuto &) = delete;
+
+    //! @param edges  Edge stream changed in-place; the change is visible after run()
+    //! @param run_length  Passed to EdgeSwapTFP if the external memory engine is used
+    EdgeSwapAuto(EdgeStream & edges, node_t num_nodes, size_t im_memory,
+                 swapid_t run_length = EdgeSwapTFP::EdgeSwapTFP::auto_run_length);
+
+    void push(const swap_descriptor & swap) {
+        if (_engine == InternalMemory) {
+            _im_swaps->push(swap);
+        } else {
+            _em_swaps->push(swap);
+        }
+    }
+
+    void run();
+
+    Engine engine() const {
+        return _engine;
+    }
+};
+
+template <>
+struct EdgeSwapTrait<EdgeSwapAuto> {
+    static bool swapVector() {return false;}
+    static bool pushableSwaps() {return true;}
+    static bool pushableSwapBuffers() {return false;}
+    static bool edgeStream() {return true;}
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <Swaps.h>
 #include <defs.h>
+#include <Utils/RunProfile.h>
 
 #include <sstream>
 #include <string>
@@ -23,6 +24,9 @@ protected:
 
     bool _display_debug;
 
+    //! Per-run records of the external memory engines, see setRunProfile()
+    RunProfile _run_profile;
+
     std::pair<edge_t, edge_t> _swap_edges(const edge_t & e0, const edge_t & e1, bool direction) const {
         /* Equivalent to
         edge_t t0(e0), t1(e1);
@@ -101,6 +105,12 @@ public:
         _display_debug = v;
     }
 
+    //! Writes one JSON line per run (time, I/O and counters of each phase) to os;
+    //! nullptr disables it. Only supported by the TFP engines.
+    void setRunProfile(std::ostream* os) {
+        _run_profile.setOutput(os);
+    }
+
     void push(const swap_descriptor &) {abort();}
     void swap_buffer(std::vector<swap_descriptor> &) {abort();}
 
@@ -15,6 +15,7 @@
 #include "PQSorterMerger.h"
 #include "EdgeVectorUpdateStream.h"
 #include <EdgeExistenceInformation.h>
+#include <Utils/NumaPlacement.h>
 
 namespace EdgeSwapParallelTFP {
 
@@ -24,6 +25,10 @@ namespace EdgeSwapParallelTFP {
             std::array<edge_t*, 2> edges_begin;
             std::array<edge_t*, 2> edges_end;
 
+            // read from the streams of the owning thread before the batch is scheduled
+            std::array<swapid_t, 2> successor;
+            bool direction;
+
             template <typename F>
             void forEach(unsigned char spos, F f) {
                 assert(is_set[spos]);
@@ -47,17 +52,11 @@ namespace EdgeSwapParallelTFP {
             };
 
             void reset(unsigned char spos) {
-                is_set[spos] = false;
+                is_set[spos].store(false, std::memory_order_relaxed);
                 edge[spos] = edge_t::invalid();
                 edges_begin[spos] = nullptr;
                 edges_end[spos] = nullptr;
             };
-
-            void wait(unsigned char spos) {
-                while (!is_set[spos].load(std::memory_order_seq_cst)) {
-                    std::this_thread::yield();
-                }
-            };
         };
 
 
@@ -100,13 +99,16 @@ namespace EdgeSwapParallelTFP {
             };
         };
 
-    EdgeSwapParallelTFP::EdgeSwapParallelTFP(EdgeStream &edges, EdgeSwapBase::swap_vector &, swapid_t swaps_per_iteration) : EdgeSwapParallelTFP(edges, swaps_per_iteration) { }
+    template <bool multigraph>
+    BasicEdgeSwapParallelTFP<multigraph>::BasicEdgeSwapParallelTFP(EdgeStream &edges, EdgeSwapBase::swap_vector &, swapid_t swaps_per_iteration) : BasicEdgeSwapParallelTFP(edges, swaps_per_iteration) { }
 
-    EdgeSwapParallelTFP::EdgeSwapParallelTFP(EdgeStream &edges, swapid_t swaps_per_iteration, int num_threads) :
+    template <bool multigraph>
+    BasicEdgeSwapParallelTFP<multigraph>::BasicEdgeSwapParallelTFP(EdgeStream &edges, swapid_t swaps_per_iteration, int num_threads) :
               EdgeSwapBase(),
               _edges(edges),
               _num_swaps_per_iteration(swaps_per_iteration),
               _num_swaps_in_run(0),
+              _runs_processed(0),
 #ifdef EDGE_SWAP_DEBUG_VECTOR
               _debug_vector_writer(_result),
 #endif
@@ -117,7 +119,8 @@ namespace EdgeSwapParallelTFP {
               _needs_writeback(false),
               _existence_info(num_threads),
               _edge_update_merger(EdgeUpdateComparator{}, _sorter_mem),
-              _num_threads(num_threads) {
+              _num_threads(num_threads),
+              _scheduler(num_threads, _batch_size_per_thread * num_threads) {
 
         _start_stats();
         omp_set_nested(1);
@@ -126,7 +129,8 @@ namespace EdgeSwapParallelTFP {
         }
     } // FIXME actually _edge_update_merger isn't needed all the time. If memory is an issue, we could safe memory here
 
-    void EdgeSwapParallelTFP::run() {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::run() {
         process_swaps();
         process_swaps();
 #ifdef EDGE_SWAP_DEBUG_VECTOR
@@ -135,25 +139,34 @@ namespace EdgeSwapParallelTFP {
     }
 
 
-    void EdgeSwapParallelTFP::process_swaps() {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::process_swaps() {
         // if we have no swaps to load and no edges to write back, do nothing (might happen by calling process_swaps several times)
         if (_num_swaps_in_run == 0 && !_needs_writeback) return;
         _report_stats("_push_swaps");
 
+        _run_profile.beginRun("EdgeSwapParallelTFP", _runs_processed++);
+        _run_profile.set("swaps", _num_swaps_in_run);
+        _run_profile.set("threads", _num_threads);
+        const uint64_t parked_swaps = _scheduler.parkedTasks();
+        const uint64_t stolen_swaps = _scheduler.stolenTasks();
+        _run_profile.beginPhase("init_process_swaps");
+
         std::vector<std::unique_ptr<DependencyChainSuccessorSorter>> swap_edge_dependencies_sorter(_num_threads);
 
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistenceSuccessorSorter > > existence_successor_sorter(_num_threads);
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistencePlaceholderSorter > > existence_placeholder_sorter(_num_threads);
+        std::vector< std::unique_ptr< ExistenceSuccessorSorter > > existence_successor_sorter(_num_threads);
+        std::vector< std::unique_ptr< ExistencePlaceholderSorter > > existence_placeholder_sorter(_num_threads);
 
         // allocate sorters only if there is actually something to do!
         if (_num_swaps_in_run > 0) {
             _edge_state.clear();
             _existence_info.clear();
 
-            // allocate sorters in parallel because of NUMA
+            // allocate sorters in parallel because of NUMA (first touch by the pinned owner)
             #pragma omp parallel num_threads(_num_threads)
             {
                 auto tid = omp_get_thread_num();
+                NumaPlacement::ThreadPin pin(tid, _num_threads);
                 swap_edge_dependencies_sorter[tid].reset(new DependencyChainSuccessorSorter(DependencyChainSuccessorComparator(), _sorter_mem));
 
                 existence_successor_sorter[tid].reset(new ExistenceSuccessorSorter(ExistenceSuccessorComparator(), _sorter_mem));
@@ -161,6 +174,7 @@ namespace EdgeSwapParallelTFP {
             }
         }
         _report_stats("_init_process_swaps");
+        _run_profile.beginPhase("load_and_update_edges");
 
         _load_and_update_edges(swap_edge_dependencies_sorter);
 
@@ -174,12 +188,15 @@ namespace EdgeSwapParallelTFP {
             {
                 ExistenceRequestMerger existence_merger(ExistenceRequestComparator(), SORTER_MEM);
 
+                _run_profile.beginPhase("compute_conflicts");
                 _compute_conflicts(swap_edge_dependencies_sorter, existence_merger);
                 _report_stats("_compute_conflicts");
+                _run_profile.beginPhase("process_existence_requests");
                 _process_existence_requests(existence_merger, existence_successor_sorter, existence_placeholder_sorter);
                 _report_stats("_process_existence_requests");
             }
 
+            _run_profile.beginPhase("perform_swaps");
             _perform_swaps(swap_edge_dependencies_sorter, existence_successor_sorter, existence_placeholder_sorter);
             _report_stats("_perform_swaps");
 
@@ -192,9 +209,13 @@ namespace EdgeSwapParallelTFP {
         _num_swaps_in_run = 0;
         _edge_swap_sorter.clear();
         _report_stats("_cleanup");
+        _run_profile.set("parked_swaps", _scheduler.parkedTasks() - parked_swaps);
+        _run_profile.set("stolen_swaps", _scheduler.stolenTasks() - stolen_swaps);
+        _run_profile.endRun();
     }
 
-    void EdgeSwapParallelTFP::_load_and_update_edges(std::vector<std::unique_ptr<DependencyChainSuccessorSorter>> &dependency_output) {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::_load_and_update_edges(std::vector<std::unique_ptr<DependencyChainSuccessorSorter>> &dependency_output) {
         uint64_t numSwaps = _num_swaps_in_run;
         _edge_swap_sorter.sort();
 
@@ -256,7 +277,7 @@ namespace EdgeSwapParallelTFP {
                 }
                 _edges.rewind();
             } else {
-                EdgeVectorUpdateStream<EdgeStream, BoolStream, EdgeUpdateMerger, true> edge_update_stream(_edges, _valid_edges, _edge_update_merger);
+                EdgeVectorUpdateStream<EdgeStream, BoolStream, EdgeUpdateMerger, !multigraph> edge_update_stream(_edges, _valid_edges, _edge_update_merger);
 
                 for (; !edge_update_stream.empty(); ++id, ++edge_update_stream) {
                     use_edge(*edge_update_stream, id);
@@ -303,11 +324,12 @@ namespace EdgeSwapParallelTFP {
      * We further request information whether the edge exists by pushing requests
      * into _existence_request_sorter.
      */
-    void EdgeSwapParallelTFP::_compute_conflicts(std::vector< std::unique_ptr< EdgeSwapParallelTFP::DependencyChainSuccessorSorter > > &dependencies, ExistenceRequestMerger &requestOutputMerger) {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::_compute_conflicts(std::vector< std::unique_ptr< DependencyChainSuccessorSorter > > &dependencies, ExistenceRequestMerger &requestOutputMerger) {
 
         // FIXME make sure that this leads to useful sort buffer sizes!
         const auto existence_request_buffer_size = SORTER_MEM/sizeof(ExistenceRequestMsg)/2;
-        swapid_t batch_size_per_thread = IntScale::Mi;
+        constexpr swapid_t batch_size_per_thread = _batch_size_per_thread;
         swapid_t num_batches_till_sorter_run = std::max<swapid_t>(1, existence_request_buffer_size / (batch_size_per_thread * 6)); // assume 6 messages per swap - 4 are minimum
         STXXL_MSG("Batch size per thread in _compute_conflicts: " << batch_size_per_thread << ", perform sorter run every " << num_batches_till_sorter_run << " batches");
 
@@ -329,6 +351,7 @@ namespace EdgeSwapParallelTFP {
         {
 
             int tid = omp_get_thread_num();
+            NumaPlacement::ThreadPin pin(tid, _num_threads);
 
             edge_information[tid].reset(new std::vector<edge_information_t>(batch_size_per_thread));
             existence_request_buffer[tid].reset(new runs_creator_buffer_t(*existence_request_runs_creator_thread, existence_request_buffer_size));
@@ -392,15 +415,12 @@ namespace EdgeSwapParallelTFP {
                 _edge_state.start_push();
             }
 
+            _scheduler.startBatch(sid_in_batch_limit - sid_in_batch_base);
+
             #pragma omp parallel num_threads(_num_threads)
             {
                 int tid = omp_get_thread_num();
-
-                auto &my_edge_information = *edge_information[tid];
-
-                auto &my_swap_direction =  *_swap_direction[tid];
-
-                auto &dep = *dependencies[tid];
+                NumaPlacement::ThreadPin pin(tid, _num_threads);
 
                 auto &my_existence_request_buffer = *existence_request_buffer[tid];
 
@@ -408,40 +428,58 @@ namespace EdgeSwapParallelTFP {
 
                 std::array<std::vector<edge_t>, 2> dd_new_edges;
 
+                // read the sequential inputs of our swaps, so they can be executed in any order
+                {
+                    auto &my_edge_information = *edge_information[tid];
+                    auto &my_swap_direction =  *_swap_direction[tid];
+                    auto &dep = *dependencies[tid];
+
+                    swapid_t sid = sid_in_batch_base + tid;
+                    for (swapid_t i = 0; sid < sid_in_batch_limit; ++i, sid += _num_threads) {
+                        edge_information_t& current_edge_info = my_edge_information[i];
+
+                        assert(!my_swap_direction.empty());
+                        current_edge_info.direction = *my_swap_direction;
+                        ++my_swap_direction;
+
+                        unsigned int unresolved = 0;
+                        for (unsigned char spos = 0; spos < 2; spos++) {
+                            current_edge_info.successor[spos] = 0;
+
+                            // get successor
+                            if (!dep.empty()) {
+                                auto &msg = *dep;
+
+                                assert(get_swap_id(msg.sid) >= sid);
+                                assert(get_swap_id(msg.sid) > sid || get_swap_spos(msg.sid) >= spos);
+
+                                if (msg.sid == pack_swap_id_spos(sid, spos)) {
+                                    DEBUG_MSG(_display_debug, "Got successor for S" << sid << ", E" << spos << ": " << msg);
+                                    current_edge_info.successor[spos] = msg.successor;
+                                    assert(get_swap_id(msg.successor) > sid);
+                                    ++dep;
+                                }
+                            }
 
-                swapid_t sid = sid_in_batch_base + tid;
-                for (swapid_t i = 0; i < batch_size_per_thread && sid < loop_limit; ++i, sid += _num_threads) {
-                    if (UNLIKELY(sid >= _num_swaps_in_run)) continue;
+                            // the state of the edge is sent by an earlier swap of this batch
+                            unresolved += !current_edge_info.is_set[spos].load(std::memory_order_relaxed);
+                        }
 
-                    std::array<swapid_t, 2> successor_sid = {0, 0};
+                        _scheduler.setDependencies(sid - sid_in_batch_base, unresolved);
+                    }
+                }
 
-                    assert(!my_swap_direction.empty());
+                #pragma omp barrier
 
-                    bool direction = *my_swap_direction;
-                    ++my_swap_direction;
+                _scheduler.run(tid, [&] (int, SwapDependencyScheduler::task_t task) {
+                    const swapid_t sid = sid_in_batch_base + task;
+                    edge_information_t& current_edge_info = (*edge_information[task % _num_threads])[task / _num_threads];
 
-                    edge_information_t& current_edge_info = my_edge_information[i];
+                    const bool direction = current_edge_info.direction;
+                    const std::array<swapid_t, 2> & successor_sid = current_edge_info.successor;
 
-                    // fetch messages sent to this edge
                     for (unsigned int spos = 0; spos < 2; spos++) {
-                        // get successor
-                        if (!dep.empty()) {
-                            auto &msg = *dep;
-
-                            assert(get_swap_id(msg.sid) >= sid);
-                            assert(get_swap_id(msg.sid) > sid || get_swap_spos(msg.sid) >= spos);
-
-                            if (msg.sid == pack_swap_id_spos(sid, spos)) {
-                                DEBUG_MSG(_display_debug, "Got successor for S" << sid << ", E" << spos << ": " << msg);
-                                successor_sid[spos] = msg.successor;
-                                assert(get_swap_id(msg.successor) > sid);
-                                ++dep;
-                            }
-                        }
-
-
-                        // ensure that we received at least one state of the edge before the swap
-                        current_edge_info.wait(spos);
+                        assert(current_edge_info.is_set[spos]);
 
                         DEBUG_MSG(_display_debug, "SWAP " << sid << " Edge " << spos << " Successor: " << successor_sid[spos] << " States: " << current_edge_info.num_edges(spos));
 
@@ -576,11 +614,11 @@ namespace EdgeSwapParallelTFP {
                             } else {
                                 t_information->edges_begin[successor_spos] = nullptr;
                             }
-                            t_information->is_set[successor_spos].store(true, std::memory_order_seq_cst);
+                            t_information->is_set[successor_spos].store(true, std::memory_order_relaxed);
+                            _scheduler.resolve(tid, get_swap_id(successor_sid[spos]) - sid_in_batch_base);
                         }
                     }
-
-                }
+                });
 
                 my_edge_forward_buffer.reset(); // reset doesn't delete any data, so we do not invalidate data of other threads
 
@@ -626,21 +664,23 @@ namespace EdgeSwapParallelTFP {
      * existence_info_output. We additionally compute a dependency chain
      * by informing every swap about the next one requesting the info and inform each swap how many edges it will get using placeholders.
      */
-    void EdgeSwapParallelTFP::_process_existence_requests(ExistenceRequestMerger &requestMerger,
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistenceSuccessorSorter > > &successor_output,
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistencePlaceholderSorter > > &existence_placeholder_output) {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::_process_existence_requests(ExistenceRequestMerger &requestMerger,
+        std::vector< std::unique_ptr< ExistenceSuccessorSorter > > &successor_output,
+        std::vector< std::unique_ptr< ExistencePlaceholderSorter > > &existence_placeholder_output) {
 
         while (!requestMerger.empty()) {
             auto &request = *requestMerger;
             edge_t current_edge = request.edge;
 
-            // find edge in graph
-            bool exists = false;
+            // find edge in graph and count its copies (more than one only in multigraphs)
+            degree_t multiplicity = 0;
             for (; !_edges.empty(); ++_edges) {
                 const auto &edge = *_edges;
                 if (edge > current_edge) break;
-                exists = (edge == current_edge);
+                multiplicity += (edge == current_edge);
             }
+            const bool exists = (multiplicity > 0);
 
             // build depencency chain (i.e. inform earlier swaps about later ones) and find the earliest swap
             swapid_t last_swap = request.get_swap_id();
@@ -667,7 +707,7 @@ namespace EdgeSwapParallelTFP {
             // inform earliest swap whether edge exists
             if (foundTargetEdge && exists) {
                 auto tid = _thread(last_swap);
-                _existence_info.push_sorter(ExistenceInfoMsg{last_swap, current_edge});
+                _existence_info.push_sorter(ExistenceInfoMsgType{last_swap, current_edge, multiplicity});
                 existence_placeholder_output[tid]->push(last_swap);
                 DEBUG_MSG(_display_debug, "Inform swap " << last_swap << " edge " << current_edge << " exists " << exists);
             }
@@ -688,23 +728,25 @@ namespace EdgeSwapParallelTFP {
      *  _swaps contains definition of swaps
      *  _depchain_successor_sorter stores swaps we need to inform about our actions
      */
-    void EdgeSwapParallelTFP::_perform_swaps(
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::DependencyChainSuccessorSorter > > &edge_dependencies,
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistenceSuccessorSorter > > &existence_successor,
-        std::vector< std::unique_ptr< EdgeSwapParallelTFP::ExistencePlaceholderSorter > > &existence_placeholder) {
+    template <bool multigraph>
+    void BasicEdgeSwapParallelTFP<multigraph>::_perform_swaps(
+        std::vector< std::unique_ptr< DependencyChainSuccessorSorter > > &edge_dependencies,
+        std::vector< std::unique_ptr< ExistenceSuccessorSorter > > &existence_successor,
+        std::vector< std::unique_ptr< ExistencePlaceholderSorter > > &existence_placeholder) {
 
         // FIXME make sure that this leads to useful sort buffer sizes!
         const auto merger_buffer_size = SORTER_MEM/sizeof(edge_t)/2; // buffer size should be SORTER_MEM/2 and each swap produces up to two edge updates
-        constexpr swapid_t batch_size_per_thread = IntScale::Mi;
+        constexpr swapid_t batch_size_per_thread = _batch_size_per_thread;
         swapid_t num_batches_till_sorter_run = std::max<swapid_t>(1, merger_buffer_size / (batch_size_per_thread * 2));
         STXXL_MSG("Batch size per thread in _perform_swaps: " << batch_size_per_thread << ", perform sorter run every " << num_batches_till_sorter_run << " batches");
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         // debug only
         // this is not good for NUMA, but hey, this is debug mode (+ this is write once + read once in a single thread, so either writing or reading is bad anyway)
+        // indexed by the position of the swap as swaps may be executed out of order
         std::vector<std::vector<debug_vector::value_type>> debug_output_buffer(_num_threads);
         for (auto & v : debug_output_buffer) {
-            v.reserve(batch_size_per_thread);
+            v.resize(batch_size_per_thread);
         }
 #endif
 
@@ -717,7 +759,16 @@ namespace EdgeSwapParallelTFP {
 
         std::vector<std::unique_ptr<std::vector<std::array<edge_t, 2>>>> source_edges(_num_threads);
 
-        std::vector<std::unique_ptr<EdgeExistenceInformation>> existence_information(_num_threads);
+        std::vector<std::unique_ptr<EdgeExistenceInformation<multigraph>>> existence_information(_num_threads);
+
+        // inputs of the swaps of a batch read from the streams of the owning thread
+        struct swap_input_t {
+            std::array<swapid_t, 2> successor; ///< 0 if there is none
+            std::size_t existence_successors_begin; ///< ends at the begin of the next swap
+            bool direction;
+        };
+        std::vector<std::unique_ptr<std::vector<swap_input_t>>> swap_inputs(_num_threads);
+        std::vector<std::unique_ptr<std::vector<ExistenceSuccessorMsg>>> existence_successors(_num_threads);
 
         using runs_creator_buffer_t = RunsCreatorBuffer<decltype(edge_update_runs_creator)>;
         std::vector<std::unique_ptr<runs_creator_buffer_t>> edge_update_buffer(_num_threads);
@@ -726,9 +777,12 @@ namespace EdgeSwapParallelTFP {
         #pragma omp parallel num_threads(_num_threads)
         {
             const auto tid = omp_get_thread_num();
+            NumaPlacement::ThreadPin pin(tid, _num_threads);
 
             source_edges[tid].reset(new std::vector<std::array<edge_t, 2>>(batch_size_per_thread, std::array<edge_t, 2>{edge_t::invalid(), edge_t::invalid()}));
-            existence_information[tid].reset(new EdgeExistenceInformation(batch_size_per_thread));
+            existence_information[tid].reset(new EdgeExistenceInformation<multigraph>(batch_size_per_thread));
+            swap_inputs[tid].reset(new std::vector<swap_input_t>(batch_size_per_thread + 1));
+            existence_successors[tid].reset(new std::vector<ExistenceSuccessorMsg>());
             edge_update_buffer[tid].reset(new runs_creator_buffer_t(*edge_update_runs_creator_thread, merger_buffer_size));
         }
 
@@ -738,14 +792,19 @@ namespace EdgeSwapParallelTFP {
             if (remainder != 0) loop_limit += (_num_threads - remainder);
         }
 
+        swapid_t counter_performed = 0;
+        swapid_t counter_loop = 0;
+        swapid_t counter_multi_edge = 0;
+
         for (swapid_t sid_in_batch_base = 0, batch_num = 0; sid_in_batch_base < loop_limit; sid_in_batch_base += batch_size_per_thread * _num_threads, ++batch_num) { // execution of batch starts
             swapid_t sid_in_batch_limit = std::min<swapid_t>(_num_swaps_in_run, sid_in_batch_base + batch_size_per_thread * _num_threads);
 
             #pragma omp parallel num_threads(_num_threads)
             {
                 const auto tid = omp_get_thread_num();
+                NumaPlacement::ThreadPin pin(tid, _num_threads);
 
-                EdgeExistenceInformation &my_existence_information = *existence_information[tid];
+                EdgeExistenceInformation<multigraph> &my_existence_information = *existence_information[tid];
                 my_existence_information.start_initialization();
 
                 auto &my_existence_placeholder = *existence_placeholder[tid];
@@ -765,7 +824,7 @@ namespace EdgeSwapParallelTFP {
 
             {
                 _edge_state.start_batch(DependencyChainEdgeMsg {pack_swap_id_spos(sid_in_batch_limit, 0), edge_t{-1, -1}});
-                _existence_info.start_batch(ExistenceInfoMsg {sid_in_batch_limit, edge_t{-1, -1}});
+                _existence_info.start_batch(ExistenceInfoMsgType {sid_in_batch_limit, edge_t{-1, -1}});
 
                 for (swapid_t swap_id = sid_in_batch_base, pos = 0; swap_id < sid_in_batch_limit; ++pos) {
                     for (int tid = 0; tid < _num_threads; ++tid, ++swap_id) {
@@ -774,7 +833,7 @@ namespace EdgeSwapParallelTFP {
                             if (_existence_info->edge == edge_t::invalid()) {
                                 existence_information[tid]->push_missing(pos);
                             } else {
-                                existence_information[tid]->push_exists(pos, _existence_info->edge);
+                                existence_information[tid]->push_exists(pos, _existence_info->edge, _existence_info->multiplicity());
                             }
                             ++_existence_info;
                         }
@@ -796,49 +855,80 @@ namespace EdgeSwapParallelTFP {
                 _existence_info.start_push();
             }
 
+            _scheduler.startBatch(sid_in_batch_limit - sid_in_batch_base);
+
             #pragma omp parallel num_threads(_num_threads)
             {
                 const auto tid = omp_get_thread_num();
-
-                auto &my_source_edges = *source_edges[tid];
+                NumaPlacement::ThreadPin pin(tid, _num_threads);
 
                 auto &my_edge_update_buffer = *edge_update_buffer[tid];
 
-                EdgeExistenceInformation &my_existence_information = *existence_information[tid];
-
-                auto &my_edge_dependencies = *edge_dependencies[tid];
-
-                auto &my_existence_sucessors = *existence_successor[tid];
+                swapid_t my_performed = 0;
+                swapid_t my_loop = 0;
+                swapid_t my_multi_edge = 0;
 
+                // read the sequential inputs of our swaps, so they can be executed in any order
+                {
+                    auto &my_source_edges = *source_edges[tid];
+                    auto &my_swap_inputs = *swap_inputs[tid];
+                    auto &my_existence_successors = *existence_successors[tid];
+                    auto &my_edge_dependencies = *edge_dependencies[tid];
+                    auto &my_existence_sucessors = *existence_successor[tid];
+                    auto &my_swap_direction = *_swap_direction[tid];
+                    EdgeExistenceInformation<multigraph> &my_existence_information = *existence_information[tid];
+
+                    my_existence_successors.clear();
+
+                    swapid_t sid = sid_in_batch_base + tid;
+                    swapid_t i = 0;
+                    for (; sid < sid_in_batch_limit; ++i, sid += _num_threads) {
+                        swap_input_t &input = my_swap_inputs[i];
+
+                        assert(!my_swap_direction.empty());
+                        input.direction = *my_swap_direction;
+                        ++my_swap_direction;
+
+                        input.successor = {0, 0};
+                        for (; !my_edge_dependencies.empty() && get_swap_id(my_edge_dependencies->sid) == sid; ++my_edge_dependencies) {
+                            DEBUG_MSG(_display_debug, "Got successor for S" << sid << ", E" << get_swap_spos(my_edge_dependencies->sid) << ": " << *my_edge_dependencies);
+                            input.successor[get_swap_spos(my_edge_dependencies->sid)] = my_edge_dependencies->successor;
+                        }
 
-                auto & my_swap_direction = *_swap_direction[tid];
+                        input.existence_successors_begin = my_existence_successors.size();
+                        for (; !my_existence_sucessors.empty(); ++my_existence_sucessors) {
+                            assert(my_existence_sucessors->swap_id >= sid);
+                            if (my_existence_sucessors->swap_id > sid) break;
+                            my_existence_successors.push_back(*my_existence_sucessors);
+                        }
 
-                swapid_t sid = sid_in_batch_base + tid;
+                        // edge states and existence information sent by earlier swaps of this batch
+                        const auto & cur_edges = my_source_edges[i];
+                        const uint32_t unresolved = cur_edges[0].is_invalid() + cur_edges[1].is_invalid()
+                                                    + my_existence_information.num_missing(i);
+                        _scheduler.setDependencies(sid - sid_in_batch_base, unresolved);
+                    }
 
-                for (swapid_t i = 0; i < batch_size_per_thread && sid < loop_limit; ++i, sid += _num_threads) {
-                    if (UNLIKELY(sid >= _num_swaps_in_run)) continue;
-                    auto & cur_edges = my_source_edges[i];
+                    my_swap_inputs[i].existence_successors_begin = my_existence_successors.size();
+                }
 
-                    std::array<edge_t, 2> new_edges;
+                #pragma omp barrier
 
-                    assert(!my_swap_direction.empty());
+                _scheduler.run(tid, [&] (int, SwapDependencyScheduler::task_t task) {
+                    const swapid_t sid = sid_in_batch_base + task;
+                    const int owner = task % _num_threads;
+                    const swapid_t i = task / _num_threads;
 
-                    bool direction = *my_swap_direction;
-                    ++my_swap_direction;
+                    auto & cur_edges = (*source_edges[owner])[i];
+                    const swap_input_t & input = (*swap_inputs[owner])[i];
+                    EdgeExistenceInformation<multigraph> &my_existence_information = *existence_information[owner];
 
+                    assert(!cur_edges[0].is_invalid() && !cur_edges[1].is_invalid());
 
-                    for (unsigned int spos = 0; spos < 2; spos++) {
-                        // get edge successors
-                        // possibly wait for another thread to set the information
-                        while (cur_edges[spos].first == INVALID_NODE || cur_edges[spos].second == INVALID_NODE) { // busy waiting for other thread to supply information
-                            std::this_thread::yield();
-                            // this adds an empty assembler instruction that acts as memory fence and tells the compiler that all memory contents may be changed, i.e. forces it to re-load cur_edges
-                            __asm__ __volatile__ ("":::"memory");
-                        }
-                    }
+                    std::array<edge_t, 2> new_edges;
 
                     // compute swapped edges
-                    std::tie(new_edges[0], new_edges[1]) = _swap_edges(cur_edges[0], cur_edges[1], direction);
+                    std::tie(new_edges[0], new_edges[1]) = _swap_edges(cur_edges[0], cur_edges[1], input.direction);
 
                     #ifndef NDEBUG
                         if (_display_debug) {
@@ -849,9 +939,6 @@ namespace EdgeSwapParallelTFP {
                         }
                     #endif
 
-                    // gather all edge states that have been sent to this swap
-                    my_existence_information.wait_for_missing(i);
-
                     // check if there's a conflicting edge
                     bool conflict_exists[2];
                     for (unsigned int spos = 0; spos < 2; spos++) {
@@ -862,6 +949,9 @@ namespace EdgeSwapParallelTFP {
                     const bool loop = new_edges[0].is_loop() || new_edges[1].is_loop();
                     const bool perform_swap = !(conflict_exists[0] || conflict_exists[1] || loop);
 
+                    my_performed += perform_swap;
+                    my_loop += loop;
+                    my_multi_edge += !loop && !perform_swap;
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
                     // write out debug message
@@ -875,7 +965,7 @@ namespace EdgeSwapParallelTFP {
                         }
                         res.normalize();
 
-                        debug_output_buffer[tid].push_back(res);
+                        debug_output_buffer[owner][i] = res;
                         DEBUG_MSG(_display_debug, "Swap " << sid << " " << res);
                     }
 #endif
@@ -886,34 +976,29 @@ namespace EdgeSwapParallelTFP {
                     }
 
                     // forward edge state to successor swap
-                    std::array<bool, 2> successor_found = {false, false};
-                    while (!my_edge_dependencies.empty() && get_swap_id(my_edge_dependencies->sid) == sid) {
-                        auto &msg = *my_edge_dependencies;
-                        DEBUG_MSG(_display_debug, "Got successor for S" << sid << ", E" << get_swap_spos(msg.sid) << ": " << msg);
-
-                        successor_found[get_swap_spos(msg.sid)] = true;
+                    for (unsigned char spos = 0; spos < 2; spos++) {
+                        const swapid_t successor = input.successor[spos];
+                        if (!successor) {
+                            // send current state of edge iff there are no successors to this edge
+                            my_edge_update_buffer.push(new_edges[spos]);
+                            continue;
+                        }
 
-                        swapid_t successor_swap_id = get_swap_id(msg.successor);
+                        swapid_t successor_swap_id = get_swap_id(successor);
 
                         if (successor_swap_id < sid_in_batch_limit) {
                             auto successor_tid = _thread(successor_swap_id);
                             auto pos = (successor_swap_id - sid_in_batch_base)/_num_threads;
-                            (*source_edges[successor_tid])[pos][get_swap_spos(msg.successor)] = new_edges[get_swap_spos(msg.sid)];
+                            (*source_edges[successor_tid])[pos][get_swap_spos(successor)] = new_edges[spos];
+                            _scheduler.resolve(tid, successor_swap_id - sid_in_batch_base);
                         } else {
-                            _edge_state.push_pq(tid, DependencyChainEdgeMsg {msg.successor, new_edges[get_swap_spos(msg.sid)]});
+                            _edge_state.push_pq(tid, DependencyChainEdgeMsg {successor, new_edges[spos]});
                         }
-
-                        ++my_edge_dependencies;
                     }
 
-                    // send current state of edge iff there are no successors to this edge
-                    for(unsigned int spos=0; spos <2; spos++) {
-                        if (!successor_found[spos]) {
-                            my_edge_update_buffer.push(new_edges[spos]);
-                        }
-                    }
+                    auto push_existence_info = [&](swapid_t target_sid, edge_t e, degree_t multiplicity) {
+                        const bool exists = (multiplicity > 0);
 
-                    auto push_existence_info = [&](swapid_t target_sid, edge_t e, bool exists) {
                         // if the edge does not exist send invalid edge so it won't find it (but still gets enough messages)
                         if (!exists) e = edge_t::invalid();
 
@@ -921,23 +1006,33 @@ namespace EdgeSwapParallelTFP {
                             auto successor_tid = _thread(target_sid);
                             auto pos = (target_sid - sid_in_batch_base)/_num_threads;
                             if (exists) {
-                                existence_information[successor_tid]->push_exists(pos, e);
+                                existence_information[successor_tid]->push_exists(pos, e, multiplicity);
                             } else {
                                 existence_information[successor_tid]->push_missing(pos);
                             }
+                            _scheduler.resolve(tid, target_sid - sid_in_batch_base);
                         } else {
-                            _existence_info.push_pq(tid, ExistenceInfoMsg{target_sid, e});
+                            _existence_info.push_pq(tid, ExistenceInfoMsgType{target_sid, e, multiplicity});
                         }
                     };
 
                     // forward existence information
-                    for (; !my_existence_sucessors.empty(); ++my_existence_sucessors) {
-                        auto &succ = *my_existence_sucessors;
-
-                        assert(succ.swap_id >= sid);
-                        if (succ.swap_id > sid) break;
-
-                        if (succ.edge == new_edges[0] || succ.edge == new_edges[1]) {
+                    const auto & my_existence_successors = *existence_successors[owner];
+                    for (size_t k = input.existence_successors_begin; k < (*swap_inputs[owner])[i + 1].existence_successors_begin; ++k) {
+                        auto &succ = my_existence_successors[k];
+                        assert(succ.swap_id == sid);
+
+                        if (multigraph) {
+                            // a performed swap adds one copy of each target edge and removes one of each source edge
+                            degree_t multiplicity = my_existence_information.multiplicity(i, succ.edge);
+                            if (perform_swap) {
+                                multiplicity += (succ.edge == new_edges[0]) + (succ.edge == new_edges[1])
+                                              - (succ.edge == cur_edges[0]) - (succ.edge == cur_edges[1]);
+                            }
+                            assert(multiplicity >= 0);
+                            push_existence_info(succ.successor, succ.edge, multiplicity);
+                            DEBUG_MSG(_display_debug, "Send " << succ.edge << " multiplicity: " << multiplicity << " to " << succ.successor);
+                        } else if (succ.edge == new_edges[0] || succ.edge == new_edges[1]) {
                             // target edges always exist (or source if no swap has been performed)
                             push_existence_info(succ.successor, succ.edge, true);
                             DEBUG_MSG(_display_debug, "Send " << succ.edge << " exists: " << true << " to " << succ.successor);
@@ -954,9 +1049,16 @@ namespace EdgeSwapParallelTFP {
 
                     cur_edges[0] = edge_t::invalid();
                     cur_edges[1] = edge_t::invalid();
-                }
+                });
                 // finished batch
 
+                #pragma omp atomic
+                counter_performed += my_performed;
+                #pragma omp atomic
+                counter_loop += my_loop;
+                #pragma omp atomic
+                counter_multi_edge += my_multi_edge;
+
                 if (batch_num % num_batches_till_sorter_run == 0 ||  sid_in_batch_limit == _num_swaps_in_run) {
                         my_edge_update_buffer.finish();
                 }
@@ -972,8 +1074,6 @@ namespace EdgeSwapParallelTFP {
                         }
                     }
                 }
-
-                debug_output_buffer[tid].clear();
 #endif
             } // end of parallel region
 
@@ -998,5 +1098,12 @@ namespace EdgeSwapParallelTFP {
         #pragma omp flush
 
         _edge_update_merger.initialize(edge_update_runs_creator.result());
+
+        _run_profile.set("performed", counter_performed);
+        _run_profile.set("rejected_loop", counter_loop);
+        _run_profile.set("rejected_multi_edge", counter_multi_edge);
     }
+
+    template class BasicEdgeSwapParallelTFP<false>;
+    template class BasicEdgeSwapParallelTFP<true>;
 };
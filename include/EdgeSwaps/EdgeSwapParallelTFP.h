@@ -4,12 +4,10 @@
 #include <stxxl/sorter>
 #include <stxxl/bits/unused.h>
 
-#include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <future>
+#include <memory>
+#include <type_traits>
 #include <utility>
-#include <stack>
 
 #include <defs.h>
 #include "Swaps.h"
@@ -21,6 +19,8 @@
 #include "EdgeStream.h"
 #include <omp.h>
 #include <ParallelBufferedPQSorterMerger.h>
+#include <Utils/ThreadPool.h>
+#include "SwapDependencyScheduler.h"
 
 namespace EdgeSwapParallelTFP {
     inline swapid_t get_swap_id(swapid_t sid) {
@@ -82,13 +82,36 @@ namespace EdgeSwapParallelTFP {
 
         ExistenceInfoMsg() { }
 
-        ExistenceInfoMsg(const swapid_t &swap_id_, const edge_t &edge_) :
+        //! @param multiplicity_  Ignored; only for the interface of MultigraphExistenceInfoMsg
+        ExistenceInfoMsg(const swapid_t &swap_id_, const edge_t &edge_, const degree_t &multiplicity_ = 1) :
             swap_id(swap_id_), edge(edge_)
-        { }
+        {
+            stxxl::STXXL_UNUSED(multiplicity_);
+        }
+
+        //! Edges of simple graphs exist at most once
+        degree_t multiplicity() const { return 1; }
 
         DECL_LEX_COMPARE_OS(ExistenceInfoMsg, swap_id, edge);
     };
 
+    //! ExistenceInfoMsg of the multigraph mode, which also carries the number of copies of the edge
+    struct MultigraphExistenceInfoMsg {
+        swapid_t swap_id;
+        edge_t edge;
+        degree_t num_copies;
+
+        MultigraphExistenceInfoMsg() { }
+
+        MultigraphExistenceInfoMsg(const swapid_t &swap_id_, const edge_t &edge_, const degree_t &multiplicity_ = 1) :
+            swap_id(swap_id_), edge(edge_), num_copies(multiplicity_)
+        { }
+
+        degree_t multiplicity() const { return num_copies; }
+
+        DECL_LEX_COMPARE_OS(MultigraphExistenceInfoMsg, swap_id, edge); // NOTE num_copies is not necessary for uniqueness and sorting.
+    };
+
     struct ExistenceSuccessorMsg {
         swapid_t swap_id;
         edge_t edge;
@@ -103,88 +126,40 @@ namespace EdgeSwapParallelTFP {
     };
 
 
+    //! Writes sorted buffers as runs of runs_creator; the buffers are processed one
+    //! after another by a SerialTaskQueue on the ThreadPool as the runs creator is
+    //! not thread-safe.
     template <class runs_creator_t>
     class RunsCreatorThread {
     private:
         using buffer_type = std::vector<typename runs_creator_t::value_type>;
 
-        struct Task {
-            buffer_type requests;
-            std::promise<buffer_type> promise;
-            runs_creator_t &runs_creator;
-
-            Task(buffer_type && requests, runs_creator_t &runs_creator) : requests(requests), runs_creator(runs_creator) {};
-
-            Task(Task&&) = default;
-
-            void operator()() {
-                assert(std::is_sorted(requests.begin(), requests.end()));
-                for (auto & req : requests) {
-                    runs_creator.push(req);
-                }
-                runs_creator.finish();
-
-                #pragma omp flush
-
-                promise.set_value(std::move(requests));
-            };
-
-            std::future<buffer_type> get_future() {
-                return promise.get_future();
-            };
-        };
-
         runs_creator_t& runs_creator;
-        bool is_running;
-        std::stack<Task> tasks;
-        std::mutex mutex;
-        std::condition_variable items_available;
-        std::thread worker_thread;
+        SerialTaskQueue tasks;
 
     public:
         RunsCreatorThread(runs_creator_t& runs_creator) :
             runs_creator(runs_creator),
-            is_running(true),
-            worker_thread([this]() {
-                std::unique_lock<std::mutex> lk(this->mutex);
-                while (this->is_running) {
-                    while (!this->tasks.empty()) {
-                        auto t = std::move(this->tasks.top());
-                        this->tasks.pop();
-
-                        lk.unlock();
-
-                        t();
-
-                        lk.lock();
-                    }
-
-                    this->items_available.wait(lk, [&](){return !this->is_running || !this->tasks.empty();});
-                }
-            })
+            tasks("RunsCreatorThread")
         {};
 
         ~RunsCreatorThread() {
-            {
-                std::lock_guard<std::mutex> lk(mutex);
-                is_running = false;
-            }
-
-            items_available.notify_all();
-
-            worker_thread.join();
+            tasks.waitAll();
         };
 
         std::future<buffer_type> enqueue_task(buffer_type &&existence_requests) {
-            std::future<buffer_type> result;
-            {
-                std::lock_guard<std::mutex> lk(mutex);
-                tasks.emplace(std::forward<buffer_type>(existence_requests), runs_creator);
-                result = tasks.top().get_future();
-            }
-            items_available.notify_one();
+            auto requests = std::make_shared<buffer_type>(std::move(existence_requests));
+            return tasks.submit([this, requests]() {
+                assert(std::is_sorted(requests->begin(), requests->end()));
+                for (auto & req : *requests) {
+                    runs_creator.push(req);
+                }
+                runs_creator.finish();
 
-            return result;
+                #pragma omp flush
+
+                return std::move(*requests);
+            });
         };
     };
 
@@ -242,11 +217,19 @@ namespace EdgeSwapParallelTFP {
     };
 
 
-    class EdgeSwapParallelTFP : public EdgeSwapBase {
+    /**
+     * @tparam multigraph  If set, multi-edges and loops are legal in the input and the
+     *   multiplicities of edges are tracked (see ModifiedEdgeSwapTFP); a swap is rejected
+     *   if it creates a loop or an edge that exists. Only then the existence information
+     *   carries the multiplicity, so simple graphs do not pay for it.
+     */
+    template <bool multigraph>
+    class BasicEdgeSwapParallelTFP : public EdgeSwapBase {
     protected:
         constexpr static size_t _pq_mem = PQ_INT_MEM;
         constexpr static size_t _pq_pool_mem = PQ_POOL_MEM;
         constexpr static size_t _sorter_mem = SORTER_MEM;
+        constexpr static swapid_t _batch_size_per_thread = IntScale::Mi;
 
         constexpr static bool compute_stats = false;
         constexpr static bool produce_debug_vector=true;
@@ -254,6 +237,7 @@ namespace EdgeSwapParallelTFP {
         EdgeStream &_edges;
         swapid_t _num_swaps_per_iteration;
         swapid_t _num_swaps_in_run;
+        uint_t _runs_processed;
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         debug_vector::bufwriter_type _debug_vector_writer;
@@ -285,9 +269,10 @@ namespace EdgeSwapParallelTFP {
         using ExistenceRequestMerger = ExistenceRequestSorter::runs_merger_type;
 
 // existence information and dependencies
-        using ExistenceInfoComparator = typename GenericComparatorStruct<ExistenceInfoMsg>::Ascending;
-        using ExistenceInfoComparatorPQ = typename GenericComparatorStruct<ExistenceInfoMsg>::Descending;
-        using ExistenceInfoSorter = stxxl::sorter<ExistenceInfoMsg, ExistenceInfoComparator>;
+        using ExistenceInfoMsgType = typename std::conditional<multigraph, MultigraphExistenceInfoMsg, ExistenceInfoMsg>::type;
+        using ExistenceInfoComparator = typename GenericComparatorStruct<ExistenceInfoMsgType>::Ascending;
+        using ExistenceInfoComparatorPQ = typename GenericComparatorStruct<ExistenceInfoMsgType>::Descending;
+        using ExistenceInfoSorter = stxxl::sorter<ExistenceInfoMsgType, ExistenceInfoComparator>;
         ParallelBufferedPQSorterMerger<ExistenceInfoSorter, ExistenceInfoComparatorPQ> _existence_info;
 
         using ExistenceSuccessorComparator = typename GenericComparatorStruct<ExistenceSuccessorMsg>::Ascending;
@@ -309,6 +294,9 @@ namespace EdgeSwapParallelTFP {
             return swap_id % _num_threads;
         };
 
+        //! Executes the swaps of a batch once the messages of earlier swaps of the batch arrived
+        SwapDependencyScheduler _scheduler;
+
 // algos
         void _load_and_update_edges(std::vector<std::unique_ptr<DependencyChainSuccessorSorter>>& dependency_output);
         void _compute_conflicts(std::vector<std::unique_ptr<DependencyChainSuccessorSorter>>& dependencies, ExistenceRequestMerger& requestOutputMerger);
@@ -320,15 +308,15 @@ namespace EdgeSwapParallelTFP {
             std::vector<std::unique_ptr<ExistencePlaceholderSorter>>& existence_placeholder);
 
     public:
-        EdgeSwapParallelTFP() = delete;
-        EdgeSwapParallelTFP(const EdgeSwapParallelTFP &) = delete;
+        BasicEdgeSwapParallelTFP() = delete;
+        BasicEdgeSwapParallelTFP(const BasicEdgeSwapParallelTFP &) = delete;
 
         //! Swaps are performed during constructor.
         //! @param edges  Edge stream changed in-place
         //! @param swaps  Read-only swap vector - ignored!
-        EdgeSwapParallelTFP(EdgeStream &edges, swap_vector &, swapid_t swaps_per_iteration = 10000000);
+        BasicEdgeSwapParallelTFP(EdgeStream &edges, swap_vector &, swapid_t swaps_per_iteration = 10000000);
 
-        EdgeSwapParallelTFP(EdgeStream &edges, swapid_t swaps_per_iteration, int num_threads = omp_get_max_threads());
+        BasicEdgeSwapParallelTFP(EdgeStream &edges, swapid_t swaps_per_iteration, int num_threads = omp_get_max_threads());
 
         void process_swaps();
         void run();
@@ -343,6 +331,11 @@ namespace EdgeSwapParallelTFP {
             }
         }
     };
+
+    extern template class BasicEdgeSwapParallelTFP<false>;
+    extern template class BasicEdgeSwapParallelTFP<true>;
+
+    using EdgeSwapParallelTFP = BasicEdgeSwapParallelTFP<false>;
 }
 
 template <>
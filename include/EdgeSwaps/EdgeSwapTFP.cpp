@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <numeric>
 #include <vector>
 
 #include <stx/btree_map>
@@ -37,6 +38,8 @@ namespace EdgeSwapTFP {
 
         stx::btree_map<uint_t, uint_t> swaps_per_edges;
         uint_t swaps_per_edge = 1;
+        uint_t max_swaps_per_edge = 0;
+        edgeid_t requested_edges = 0;
 
         #ifdef ASYNC_STREAMS
             AsyncStream<EdgeReader> edge_reader(edge_reader_in, false, 1.0e6);
@@ -78,6 +81,9 @@ namespace EdgeSwapTFP {
             const auto & edge = *edge_reader;
             assert(!edge.is_loop());
 
+            if (_edge_id_request_sorter)
+                _edge_id_request_sorter->push(EdgeIdRequestMsg{requesting_swap, requested_edge});
+
             // read edge and sent it to next node, if
             if (first_swap_of_edge) {
                 assert(!edge_reader.empty());
@@ -86,10 +92,11 @@ namespace EdgeSwapTFP {
 
                 first_swap_of_edge = false;
 
-                if (compute_stats) {
+                if (compute_stats)
                     swaps_per_edges[swaps_per_edge]++;
-                    swaps_per_edge = 1;
-                }
+                max_swaps_per_edge = std::max(max_swaps_per_edge, swaps_per_edge);
+                swaps_per_edge = 1;
+                requested_edges++;
 
             } else {
                 depchain_edge_sorter.push({requesting_swap, edge});
@@ -97,8 +104,7 @@ namespace EdgeSwapTFP {
                 assert(prev_swap < requesting_swap);
                 DEBUG_MSG(_display_debug, "Report to swap " << prev_swap << " that swap " << requesting_swap << " needs edge " << requested_edge);
 
-                if (compute_stats)
-                    swaps_per_edge++;
+                swaps_per_edge++;
             }
 
             prev_swap = requesting_swap;
@@ -129,6 +135,12 @@ namespace EdgeSwapTFP {
 
         edge_remains_valid.consume();
 
+        if (_edge_id_request_sorter)
+            _edge_id_request_sorter->sort();
+
+        _run_profile.set("requested_edges", requested_edges);
+        _run_profile.set("max_dependency_chain", std::max(max_swaps_per_edge, swaps_per_edge));
+
         #ifdef ASYNC_PUSHERS
             // wait for pushers until they are done
             depchain_edge_sorter.waitForPusher();
@@ -147,6 +159,9 @@ namespace EdgeSwapTFP {
         REPORT_SORTER_STATS(_depchain_successor_sorter);
         _depchain_edge_sorter.sort();
         REPORT_SORTER_STATS(_depchain_edge_sorter);
+
+        _run_profile.set("depchain_edge_sorter", _depchain_edge_sorter.size());
+        _run_profile.set("depchain_successor_sorter", _depchain_successor_sorter.size());
     }
 
     /*
@@ -168,6 +183,10 @@ namespace EdgeSwapTFP {
     void EdgeSwapTFP::_simulate_swaps() {
         swapid_t sid = 0;
 
+        _record_volume(_depchain_edge_sorter.size() * sizeof(DependencyChainEdgeMsg), _mem_est.depchain_edge_sorter());
+        _record_volume(_depchain_successor_sorter.size() * sizeof(DependencyChainSuccessorMsg), _mem_est.depchain_successor_sorter());
+        size_t pq_peak = 0;
+
         // use pq in addition to _depchain_edge_sorter to pass messages between swaps
         assert(_dependency_chain_pq.empty());
         #ifdef ASYNC_STREAMS
@@ -313,7 +332,7 @@ namespace EdgeSwapTFP {
                             _dependency_chain_pq.push(DependencyChainEdgeMsg{successors[i], send_edge});
                         }
 
-                        _existence_request_sorter.push(ExistenceRequestMsg{send_edge, sid, false});
+                        _push_existence_request(ExistenceRequestMsg{send_edge, sid, false});
                     }
                 }
 
@@ -327,17 +346,20 @@ namespace EdgeSwapTFP {
                         _dependency_chain_pq.push(DependencyChainEdgeMsg{successors[i], edge});
                     }
 
-                    _existence_request_sorter.push(ExistenceRequestMsg{edge, sid, true});
+                    _push_existence_request(ExistenceRequestMsg{edge, sid, true});
                 }
             }
 
             // if we pushed something into the PQ we need to update the merger
             if (UNLIKELY(successors[0] || successors[1])) {
                 depchain_pqsort.update();
+                pq_peak = std::max<size_t>(pq_peak, _dependency_chain_pq.size());
             }
         }
 
         std::cout << "Elements remaining in PQ: " << _dependency_chain_pq.size() << std::endl;
+        _record_volume(pq_peak * sizeof(DependencyChainEdgeMsg), _pq_mem + _mem_est.depchain_pq_pool());
+        _run_profile.set("depchain_pq_peak", pq_peak);
 
         if (compute_stats) {
             for (const auto &it : state_sizes) {
@@ -347,15 +369,18 @@ namespace EdgeSwapTFP {
             depchain_pqsort.dump_stats("depchain_pqsort");
         }
 
+        _flush_existence_requests();
         _existence_request_sorter.sort();
         REPORT_SORTER_STATS(_existence_request_sorter)
+        _record_volume(_existence_request_sorter.size() * sizeof(ExistenceRequestMsg), _mem_est.existence_request_sorter());
+        _run_profile.set("existence_request_sorter", _existence_request_sorter.size());
         _swap_directions.rewind();
 
         if (_async_processing) {
-            _depchain_thread.reset(new std::thread([&]() {
+            _depchain_task = ThreadPool::instance().submit([this]() {
                 _depchain_successor_sorter.rewind();
                 _depchain_edge_sorter.rewind();
-            }));
+            }, "EdgeSwapTFP::depchain", this);
         } else {
             _depchain_successor_sorter.rewind();
             _depchain_edge_sorter.rewind();
@@ -363,7 +388,86 @@ namespace EdgeSwapTFP {
     }
 
     /*
-     * We parallel stream through _edges and _existence_request_sorter#
+     * Consider the requests of an edge e whose existence at the begin of the run is
+     * known, i.e. e is rejected by _graph_filter or incident to a hub of _hub_cache.
+     * If the first request (i.e. of the earliest swap) is not followed by a target
+     * request of a later swap, _load_existence walks the chain without emitting a
+     * successor message and only informs the earliest swap whether e exists. We hence
+     * withhold the first request of each such edge and, after the simulation, push it
+     * only if _needed_filter contains its edge; otherwise we send the existence info
+     * directly. All false positives of the filters only cause requests to be pushed.
+     */
+    void EdgeSwapTFP::_push_existence_request(const ExistenceRequestMsg & msg) {
+        if (!_requested_filter) {
+            _existence_request_sorter.push(msg);
+            return;
+        }
+
+        const uint64_t key = ExistenceRequestMsgKey{}(msg);
+
+        bool exists = false;
+        if (_hub_cache && _hub_cache->covers(msg.edge)) {
+            exists = _hub_cache->contains(msg.edge);
+            _hub_cache_hits++;
+
+        } else if (!_graph_filter || _graph_filter->contains(key)) {
+            // the edge may exist, the scan of the edges has to decide
+            _existence_request_sorter.push(msg);
+            return;
+        }
+
+        _screened_requests++;
+
+        if (!_requested_filter->contains(key)) {
+            _requested_filter->insert(key);
+
+            if (UNLIKELY(_withheld_requests.size() >= _withheld_capacity)) {
+                for (const auto & withheld : _withheld_requests)
+                    _existence_request_sorter.push(withheld.msg);
+                _withheld_requests.clear();
+            }
+
+            _withheld_requests.push_back(WithheldRequest{msg, exists});
+            return;
+        }
+
+        if (!msg.forward_only())
+            _needed_filter->insert(key);
+
+        _existence_request_sorter.push(msg);
+    }
+
+    void EdgeSwapTFP::_flush_existence_requests() {
+        if (!_requested_filter)
+            return;
+
+        for (const auto & withheld : _withheld_requests) {
+            const auto & msg = withheld.msg;
+            if (_needed_filter->contains(ExistenceRequestMsgKey{}(msg))) {
+                _existence_request_sorter.push(msg);
+                continue;
+            }
+
+            _dropped_requests++;
+
+            if (msg.forward_only())
+                continue;
+
+            #ifdef NDEBUG
+            if (withheld.exists)
+                _existence_info_sorter.push(ExistenceInfoMsg{msg.swap_id(), msg.edge});
+            #else
+            _existence_info_sorter.push(ExistenceInfoMsg{msg.swap_id(), msg.edge, withheld.exists});
+            #endif
+        }
+
+        _withheld_requests.clear();
+        _requested_filter->clear();
+        _needed_filter->clear();
+    }
+
+    /*
+     * We parallel stream through _edge_log and _existence_request_sorter#
      * to check whether a requested edge exists in the input graph.
      * The result is sent to the first swap requesting using
      * _existence_info_pq. We additionally compute a dependency chain
@@ -390,8 +494,8 @@ namespace EdgeSwapTFP {
 
             // find edge in graph
             bool exists = false;
-            for (; !_edges.empty(); ++_edges) {
-                const auto &edge = *_edges;
+            for (; !_edge_log.empty(); ++_edge_log) {
+                const auto &edge = *_edge_log;
                 if (edge > current_edge) break;
                 exists = (edge == current_edge);
             }
@@ -454,19 +558,23 @@ namespace EdgeSwapTFP {
 
         REPORT_SORTER_STATS(_existence_successor_sorter);
         REPORT_SORTER_STATS(_existence_info_sorter);
+        _record_volume(_existence_successor_sorter.size() * sizeof(ExistenceSuccessorMsg), _mem_est.existence_successor_sorter());
+        _record_volume(_existence_info_sorter.size() * sizeof(ExistenceInfoMsg), _mem_est.existence_info_sorter());
+        _run_profile.set("existence_successor_sorter", _existence_successor_sorter.size());
+        _run_profile.set("existence_info_sorter", _existence_info_sorter.size());
 
         if (_async_processing) {
-            std::thread t1([&](){_existence_successor_sorter.sort();});
-            std::thread t2([&](){_existence_info_sorter.sort();});
+            auto successor_sort = ThreadPool::instance().submit([this](){_existence_successor_sorter.sort();}, "EdgeSwapTFP::existence_sort", this);
+            _existence_info_sorter.sort();
             //_existence_request_sorter.finish_clear();
-            t1.join(); t2.join();
+            _wait_for_task(successor_sort);
         } else {
             //_existence_request_sorter.finish_clear();
             _existence_successor_sorter.sort();
             _existence_info_sorter.sort();
         }
 
-        _edges.rewind();
+        _edge_log.rewind();
     }
 
     /*
@@ -475,7 +583,7 @@ namespace EdgeSwapTFP {
      *  _depchain_successor_sorter stores swaps we need to inform about our actions
      */
     void EdgeSwapTFP::_perform_swaps() {
-        if (_depchain_thread) _depchain_thread->join();
+        _wait_for_task(_depchain_task);
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         // debug only
@@ -511,8 +619,12 @@ namespace EdgeSwapTFP {
         swapid_t counter_performed = 0;
         swapid_t counter_not_performed = 0;
         swapid_t counter_loop = 0;
+        swapid_t counter_multi_edge = 0;
         swapid_t counter_invalid = 0;
 
+        size_t edge_state_pq_peak = 0;
+        size_t existence_info_pq_peak = 0;
+
 
         for (; !_swap_directions.empty(); ++_swap_directions, ++sid) {
             edge_state_pqsort.update();
@@ -607,15 +719,14 @@ namespace EdgeSwapTFP {
             }
 
             // can we perform the swap?
-            const bool loop = !edge_invalid && (new_edges[0].is_loop() || new_edges[1].is_loop());
+            const bool loop = !edge_invalid && (_is_loop(new_edges[0]) || _is_loop(new_edges[1]));
             const bool perform_swap = !(conflict_exists[0] || conflict_exists[1] || loop || edge_invalid);
 
-            if (compute_stats) {
-                counter_performed += perform_swap;
-                counter_not_performed += !perform_swap;
-                counter_loop += loop;
-                counter_invalid += edge_invalid;
-            }
+            counter_performed += perform_swap;
+            counter_not_performed += !perform_swap;
+            counter_loop += loop;
+            counter_multi_edge += !loop && !edge_invalid && (conflict_exists[0] || conflict_exists[1]);
+            counter_invalid += edge_invalid;
 
             // write out debug message if the swap is not invalid
             if (produce_debug_vector && !edge_invalid) {
@@ -663,6 +774,17 @@ namespace EdgeSwapTFP {
                 }
             }
 
+            // report the final state of an edge id together with the id
+            if (_edge_id_request_sorter) {
+                for(unsigned int i=0; i<2; i++, ++*_edge_id_request_sorter) {
+                    const auto & request = **_edge_id_request_sorter;
+                    assert(request.swap_id == 2*sid+i);
+
+                    if (!successor_found[i] && LIKELY(!edges[i + 2 * perform_swap].is_invalid()))
+                        _edge_id_update_sorter->push(EdgeIdUpdateMsg{request.edge_id, edges[i + 2*perform_swap]});
+                }
+            }
+
             // forward existence information
             for (; !_existence_successor_sorter.empty(); ++_existence_successor_sorter) {
                 auto &succ = *_existence_successor_sorter;
@@ -706,8 +828,20 @@ namespace EdgeSwapTFP {
             missing_infos.clear();
             #endif
 
+            edge_state_pq_peak = std::max<size_t>(edge_state_pq_peak, _dependency_chain_pq.size());
+            existence_info_pq_peak = std::max<size_t>(existence_info_pq_peak, _existence_info_pq.size());
         }
 
+        _record_volume(edge_state_pq_peak * sizeof(DependencyChainEdgeMsg), _pq_mem + _mem_est.edge_state_pq_pool());
+        _record_volume(existence_info_pq_peak * sizeof(ExistenceInfoMsg), _pq_mem + _mem_est.existence_info_pq_pool());
+
+        _run_profile.set("performed", counter_performed);
+        _run_profile.set("rejected_loop", counter_loop);
+        _run_profile.set("rejected_multi_edge", counter_multi_edge);
+        _run_profile.set("rejected_invalid", counter_invalid);
+        _run_profile.set("edge_state_pq_peak", edge_state_pq_peak);
+        _run_profile.set("existence_info_pq_peak", existence_info_pq_peak);
+
         if (compute_stats) {
             std::cout << "Swaps performed: " << counter_performed
             << ". Not performed: " << counter_not_performed
@@ -719,12 +853,10 @@ namespace EdgeSwapTFP {
         edge_state_pqsort.dump_stats("edge_state_pqsort");
         existence_info_pqsort.dump_stats("existence_info_pqsort");
 
-        if (_result_thread) _result_thread->join();
+        _wait_for_task(_result_task);
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         if (_async_processing) {
-            _result_thread.reset(
-                new std::thread([&](){debug_vector_writer.finish();})
-            );
+            _result_task = ThreadPool::instance().submit([&](){debug_vector_writer.finish();}, "EdgeSwapTFP::result", this);
         } else {
             debug_vector_writer.finish();
         }
@@ -741,28 +873,35 @@ namespace EdgeSwapTFP {
         //_existence_info_sorter.finish_clear();
         
         REPORT_SORTER_STATS(_edge_update_sorter);
+        _record_volume(_edge_update_sorter.size() * sizeof(edge_t), _mem_est.edge_update_sorter());
+        _run_profile.set("edge_update_sorter", _edge_update_sorter.size());
 
         if (_async_processing) {
-            _edge_update_sorter_thread.reset(
-                new std::thread([&](){_edge_update_sorter.sort();})
-            );
+            _edge_update_sorter_task = ThreadPool::instance().submit([this](){_edge_update_sorter.sort();}, "EdgeSwapTFP::edge_update_sort", this);
         } else {
             _edge_update_sorter.sort();
         }
+
+        if (_edge_id_request_sorter) {
+            assert(_edge_id_request_sorter->empty());
+            _edge_id_request_sorter->clear();
+
+            _edge_id_update_sorter->sort();
+            _apply_updates();
+            _edge_id_update_sorter->clear();
+        }
     }
 
     void EdgeSwapTFP::_process_swaps() {
         constexpr bool show_stats = false;
 
-        using UpdateStream = EdgeVectorUpdateStream<EdgeStream, BoolStream, decltype(_edge_update_sorter), true>;
-
         if (!_edge_swap_sorter->size()) {
             // there are no swaps - let's see whether there are pending updates
-            if (_edge_update_sorter.size()) {
-                UpdateStream update_stream(_edges, _last_edge_update_mask, _edge_update_sorter);
-                update_stream.finish();
-                _edges.rewind();
-            }
+            // (compacting the log of updates so that _edges is complete)
+            _wait_for_edge_update_sorter();
+            assert(!_edge_log.levels() || _edge_update_sorter.size());
+            if (_edge_update_sorter.size())
+                _update_and_scan_edges([] (auto &) {}, true);
             _edge_update_sorter.clear();
 
             _reset();
@@ -770,6 +909,11 @@ namespace EdgeSwapTFP {
             return;
         }
 
+        const uint64_t pq_spilled = _pq_spilled_elements();
+        _run_profile.beginRun("EdgeSwapTFP", _runs_started - 1);
+        _run_profile.set("swaps", _processing_run_length);
+        _run_profile.beginPhase("dependency_chain");
+
         if (_first_run) {
             // first iteration
             _compute_dependency_chain(_edges, _edge_update_mask);
@@ -777,15 +921,9 @@ namespace EdgeSwapTFP {
             _first_run = false;
 
         } else {
-            if (_edge_update_sorter_thread)
-                _edge_update_sorter_thread->join();
-
-            UpdateStream update_stream(_edges, _last_edge_update_mask, _edge_update_sorter);
-            _compute_dependency_chain(update_stream, _edge_update_mask);
-            update_stream.finish();
-
-            _edge_update_sorter.clear();
-            _edges.rewind();
+            _update_and_scan_edges([&] (auto & update_stream) {
+                _compute_dependency_chain(update_stream, _edge_update_mask);
+            });
         }
 
 
@@ -797,16 +935,16 @@ namespace EdgeSwapTFP {
 #ifndef NDEBUG
         // test that input is lexicographically ordered and loop free
         {
-            edge_t last_edge = *_edges;
-            ++_edges;
+            edge_t last_edge = *_edge_log;
+            ++_edge_log;
             assert(!last_edge.is_loop());
-            for(;!_edges.empty();++_edges) {
-                auto & edge = *_edges;
+            for(;!_edge_log.empty();++_edge_log) {
+                auto & edge = *_edge_log;
                 assert(!edge.is_loop());
                 assert(last_edge < edge);
                 last_edge = edge;
             }
-            _edges.rewind();
+            _edge_log.rewind();
         }
 #endif
         //for (; !_edges.empty(); ++_edges)
@@ -818,13 +956,20 @@ namespace EdgeSwapTFP {
         std::swap(_edge_update_mask, _last_edge_update_mask);
 
         _report_stats("_compute_dependency_chain: ", show_stats);
+        _run_profile.beginPhase("simulate_swaps");
         _simulate_swaps();
         _report_stats("_simulate_swaps: ", show_stats);
+        _run_profile.beginPhase("load_existence");
         _load_existence();
         _report_stats("_load_existence: ", show_stats);
+        _run_profile.beginPhase("perform_swaps");
         _perform_swaps();
         _report_stats("_perform_swaps: ", show_stats);
 
+        _run_profile.set("pq_spilled", _pq_spilled_elements() - pq_spilled);
+        _tune_run_length();
+        _run_profile.endRun();
+
         _reset();
         _report_stats("_process_swaps: ", show_stats);
     }
@@ -836,13 +981,20 @@ namespace EdgeSwapTFP {
         _swap_directions_pushing.consume();
 
         // wait for compution to finish (if there is some)
-        if (_process_thread.joinable())
-            _process_thread.join();
+        _wait_for_task(_process_task);
 
         // reset old data structures
         _swap_directions.clear();
+        _processing_run_length = _next_swap_id_pushing / 2;
         _next_swap_id_pushing = 0;
 
+        // the proposal of the last processed run is applied by the pushing thread
+        // at this point only, so the run boundaries do not depend on timing
+        _run_length = _tuned_run_length;
+        _runs_started++;
+        _run_io_begin = stxxl::stats_data(*stxxl::stats::get_instance());
+        _run_time_begin = std::chrono::high_resolution_clock::now();
+
         // swap staging and processing area
         std::swap(_edge_swap_sorter_pushing, _edge_swap_sorter);
         std::swap(_swap_directions_pushing, _swap_directions);
@@ -850,8 +1002,8 @@ namespace EdgeSwapTFP {
         REPORT_SORTER_STATS(*_edge_swap_sorter);
 
         if (async) {
-            // start worker thread
-            _process_thread = std::thread(&EdgeSwapTFP::_process_swaps, this);
+            // process the run on the thread pool
+            _process_task = ThreadPool::instance().submit([this]() {_process_swaps();}, "EdgeSwapTFP::process", this);
         } else {
             // do it ourselves
             _process_swaps();
@@ -869,19 +1021,169 @@ namespace EdgeSwapTFP {
         //_edges.rewind();
     }
 
-    EdgeSwapTFP::MemoryEstimation::size_array_t
-    EdgeSwapTFP::MemoryEstimation::_compute(const size_t& mem, const swapid_t& no_swaps, const degree_t& avg_deg) const {
-        auto format = [] (const size_t& x) {
-            std::string xs = std::to_string(x);
-            return xs;
-            std::string ret;
+    /*
+     * The volume of every message sorter and PQ of the run was compared with its
+     * memory budget; the largest ratio is the load of the run. Runs with a load
+     * above one spill into external memory beyond the unavoidable scan of the edges,
+     * hence we shrink the run length proportionally. Runs using less than half of
+     * the memory are extended up to the run length the structures are sized for.
+     * Runs cut short by run() or a forced process_swaps() tell nothing about the
+     * load of a full run, so they only shrink the run length if they overflowed.
+     * As the load only depends on the swaps and the graph, so do the run lengths.
+     */
+    void EdgeSwapTFP::_tune_run_length() {
+        const swapid_t current = _processing_run_length;
+        const double load = _run_load;
+        _run_load = 0.0;
+
+        if (_auto_run_length) {
+            // _run_length is only changed by the pushing thread after this run finished
+            const swapid_t configured = _run_length;
+            const swapid_t min_run_length = std::max<swapid_t>(1, _max_run_length / 64);
+            double target = configured;
+            if (load > 1.0) {
+                target = current * 0.9 / load;
+            } else if (load < 0.5 && current >= configured) {
+                target = current * std::min(2.0, 0.9 / std::max(load, 1e-9));
+            }
 
-            for(int i = xs.size() - 3; i > -3; i -= 3)
-                ret = xs.substr(std::max(0, i), 3) + (ret.empty() ? "" : ",") + ret;
+            _tuned_run_length = std::min<swapid_t>(_max_run_length, std::max<swapid_t>(min_run_length, static_cast<swapid_t>(target)));
+        }
 
-            return ret;
+        if (_display_run_summary) {
+            const stxxl::stats_data io = stxxl::stats_data(*stxxl::stats::get_instance()) - _run_io_begin;
+            const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - _run_time_begin).count();
+
+            std::cout << "EdgeSwapTFP run " << _iteration << ": " << current << " swaps"
+                      << " at " << (seconds > 0 ? current / seconds : 0.0) << " swaps/s,"
+                      << " I/O read " << io.get_read_volume() << " written " << io.get_written_volume() << " bytes"
+                      << " (edge update pass read " << _run_edge_io.get_read_volume() << " written " << _run_edge_io.get_written_volume()
+                      << (_async_processing ? ", pipelined)," : "),")
+                      << " load " << load << ", next run length " << _tuned_run_length;
+            if (_edge_log.enabled())
+                std::cout << ", update log of " << _edge_log.levels() << " deltas with " << _edge_log.deltaEdges() << " edges";
+            if (_requested_filter) {
+                std::cout << ", existence requests screened " << _screened_requests
+                          << " (hub cache hits " << _hub_cache_hits << ")"
+                          << " dropped " << _dropped_requests
+                          << " saving " << _dropped_requests * sizeof(ExistenceRequestMsg) << " bytes of sorter volume";
+            }
+            if (_convergence_monitor) {
+                std::cout << ", assortativity " << _convergence_monitor->assortativity()
+                          << " untouched initial edges " << _convergence_monitor->untouched_fraction()
+                          << " flat runs " << _convergence_monitor->flat_runs();
+            }
+            std::cout << std::endl;
+        }
+
+        _run_profile.set("edge_pass_read_bytes", _run_edge_io.get_read_volume());
+        _run_profile.set("edge_pass_written_bytes", _run_edge_io.get_written_volume());
+        _run_profile.setReal("load", load);
+        _run_profile.set("next_run_length", _tuned_run_length);
+        if (_edge_log.enabled()) {
+            _run_profile.set("update_log_levels", _edge_log.levels());
+            _run_profile.set("update_log_edges", _edge_log.deltaEdges());
+        }
+        if (_convergence_monitor) {
+            // the update pass of this run observed the result of the previous run
+            _run_profile.set("monitor_runs", _convergence_monitor->runs());
+            _run_profile.setReal("assortativity", _convergence_monitor->assortativity());
+            _run_profile.setReal("untouched_fraction", _convergence_monitor->untouched_fraction());
+            _run_profile.set("flat_runs", _convergence_monitor->flat_runs());
+        }
+        if (_requested_filter) {
+            _run_profile.set("screened_requests", _screened_requests);
+            _run_profile.set("hub_cache_hits", _hub_cache_hits);
+            _run_profile.set("dropped_requests", _dropped_requests);
+        }
+
+        _dropped_requests = 0;
+        _hub_cache_hits = 0;
+        _screened_requests = 0;
+    }
+
+    void EdgeSwapTFP::_init_request_screening() {
+        if (!_graph_filter && !_hub_cache) {
+            _requested_filter.reset();
+            _needed_filter.reset();
+            std::vector<WithheldRequest>().swap(_withheld_requests);
+            return;
+        }
+
+        if (_requested_filter)
+            return;
+
+        // a run issues about five existence requests per swap, see MemoryEstimation;
+        // we use one byte per request and filter and withhold at most one request per swap
+        const size_t run_requests = 5 * _max_run_length;
+        _requested_filter.reset(new BloomFilter(run_requests, run_requests));
+        _needed_filter.reset(new BloomFilter(run_requests, run_requests));
+        _withheld_capacity = std::max<size_t>(1, _max_run_length);
+    }
+
+    void EdgeSwapTFP::setExistenceFilter(size_t bytes) {
+        assert(!_next_swap_id_pushing && !_runs_started);
+
+        _graph_filter.reset();
+        if (bytes) {
+            // later runs rebuild the filter while writing the updated edges
+            _graph_filter.reset(new BloomFilter(bytes, _edges.size()));
+            for (_edges.rewind(); !_edges.empty(); ++_edges)
+                _graph_filter->insert(ExistenceRequestMsgKey{}(*_edges));
+            _edges.rewind();
+        }
+
+        _init_request_screening();
+    }
+
+    void EdgeSwapTFP::setHubCache(size_t bytes) {
+        assert(!_next_swap_id_pushing && !_runs_started);
+
+        _hub_cache.reset();
+        if (bytes) {
+            // later runs rebuild the adjacency lists while writing the updated edges
+            _hub_cache.reset(new HubAdjacencyCache(_edges, _num_nodes, bytes));
+            std::cout << "Hub cache of " << _hub_cache->numHubs() << " nodes with "
+                      << _hub_cache->numEdges() << " adjacencies" << std::endl;
+        }
+
+        _init_request_screening();
+    }
+
+    swapid_t EdgeSwapTFP::_initial_run_length(const swapid_t& run_length, const size_t& im_memory, const edgeid_t& num_edges, const node_t& num_nodes) {
+        if (run_length != auto_run_length)
+            return run_length;
+
+        // more swaps than edges per run do not save further scans of the edges
+        const degree_t avg_deg = num_nodes ? num_edges / num_nodes : 0;
+        return std::max<swapid_t>(1, std::min<swapid_t>(num_edges, MemoryEstimation::max_run_length(im_memory, avg_deg)));
+    }
+
+    swapid_t EdgeSwapTFP::MemoryEstimation::max_run_length(const size_t& mem, const degree_t& avg_deg) {
+        auto total = [&] (const swapid_t& no_swaps) {
+            const size_array_t est = _estimate(no_swaps, avg_deg);
+            return std::accumulate(est.cbegin(), est.cend(), size_t(0), [] (const size_t& b, const size_block_t& a) -> size_t {return std::get<0>(a) + b;});
         };
 
+        // the estimation is monotonic in the number of swaps
+        swapid_t lo = 1;
+        swapid_t hi = swapid_t(1) << 40;
+        if (total(lo) > mem)
+            return lo;
+
+        while (lo < hi) {
+            const swapid_t mid = lo + (hi - lo + 1) / 2;
+            if (total(mid) <= mem)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        return lo;
+    }
+
+    EdgeSwapTFP::MemoryEstimation::size_array_t
+    EdgeSwapTFP::MemoryEstimation::_estimate(const swapid_t& no_swaps, const degree_t& avg_deg) {
         auto bceil = [] (const size_t& x, const size_t& bs) -> size_t {
             return ((x + bs - 1) / bs) * bs;
         };
@@ -899,7 +1201,7 @@ namespace EdgeSwapTFP {
             );
         };
 
-        size_array_t est = {
+        return size_array_t {
             estimate(0.000000, 2.000000, sizeof(DependencyChainEdgeMsg), STXXL_DEFAULT_BLOCK_SIZE(DependencyChainEdgeMsg)),
             estimate(-0.00214, 3.053523, sizeof(DependencyChainEdgeMsg), DependencyChainEdgePQBlock::raw_size, 2),
             estimate(-0.00143, 0.230478, sizeof(DependencyChainSuccessorMsg), STXXL_DEFAULT_BLOCK_SIZE(DependencyChainSuccessorMsg)),
@@ -913,6 +1215,24 @@ namespace EdgeSwapTFP {
             estimate(0.030467, 4.605875, sizeof(ExistenceRequestMsg), STXXL_DEFAULT_BLOCK_SIZE(ExistenceRequestMsg)),
             estimate(0.004931, 0.000230, sizeof(ExistenceSuccessorMsg), STXXL_DEFAULT_BLOCK_SIZE(ExistenceSuccessorMsg))
         };
+    }
+
+    EdgeSwapTFP::MemoryEstimation::size_array_t
+    EdgeSwapTFP::MemoryEstimation::_compute(const size_t& mem, const swapid_t& no_swaps, const degree_t& avg_deg) const {
+        auto format = [] (const size_t& x) {
+            std::string xs = std::to_string(x);
+            return xs;
+            std::string ret;
+
+            for(int i = xs.size() - 3; i > -3; i -= 3)
+                ret = xs.substr(std::max(0, i), 3) + (ret.empty() ? "" : ",") + ret;
+
+            return ret;
+        };
+
+        const size_t min_blocks = 16 * (stxxl::sort_memory_usage_factor() * 2 + 1);
+
+        size_array_t est = _estimate(no_swaps, avg_deg);
 
         // if the estimation is too large, reduce evenly but do not fall below minimum size
         {
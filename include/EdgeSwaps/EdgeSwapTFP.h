@@ -3,8 +3,9 @@
 #include <stxxl/vector>
 #include <stxxl/sorter>
 #include <stxxl/bits/unused.h>
+#include <chrono>
+#include <future>
 #include <memory>
-#include <thread>
 
 #include <defs.h>
 #include "Swaps.h"
@@ -13,9 +14,18 @@
 
 #include "EdgeSwapBase.h"
 #include "BoolStream.h"
+#include "SwapConvergenceMonitor.h"
+#include "EdgeVectorUpdateStream.h"
+#include "HubAdjacencyCache.h"
+#include "EdgeUpdateLog.h"
 #include <stxxl/priority_queue>
 
 #include <EdgeStream.h>
+#include <Utils/AsyncStream.h>
+#include <Utils/BloomFilter.h>
+#include <Utils/IntSorter.h>
+#include <Utils/MonotoneBucketPQ.h>
+#include <Utils/ThreadPool.h>
 
 namespace EdgeSwapTFP {
     struct EdgeSwapMsg {
@@ -28,6 +38,13 @@ namespace EdgeSwapTFP {
         DECL_LEX_COMPARE_OS(EdgeSwapMsg, edge_id, swap_id);
     };
 
+    //! Radix key of EdgeSwapMsg; swaps are pushed in order, so ties need no comparisons
+    struct EdgeSwapMsgKey {
+        uint64_t operator()(const EdgeSwapMsg & msg) const {
+            return static_cast<uint64_t>(msg.edge_id);
+        }
+    };
+
     struct DependencyChainEdgeMsg {
         swapid_t swap_id;
         // edgeid_t edge_id; is not used any more; we rather encode in the LSB of swap_id whether to target the first or second edge
@@ -41,6 +58,15 @@ namespace EdgeSwapTFP {
         DECL_LEX_COMPARE_OS(DependencyChainEdgeMsg, swap_id, edge);
     };
 
+    //! Key of the messages kept in the priority queues for MonotoneBucketPQ; the
+    //! queues only receive messages for swaps after the one processed
+    template <typename Msg>
+    struct SwapIdKey {
+        uint64_t operator()(const Msg & msg) const {
+            return static_cast<uint64_t>(msg.swap_id);
+        }
+    };
+
     struct DependencyChainSuccessorMsg {
         swapid_t swap_id;
         swapid_t successor;
@@ -72,6 +98,18 @@ namespace EdgeSwapTFP {
         DECL_TUPLE_OS(ExistenceRequestMsg);
     };
 
+    //! Radix key of ExistenceRequestMsg, i.e. the edge; ties are ordered by the comparator
+    struct ExistenceRequestMsgKey {
+        uint64_t operator()(const edge_t & edge) const {
+            static_assert(sizeof(node_t) == 4, "Node type is not 32 bit anymore, adjust key");
+            return (static_cast<uint64_t>(edge.first) << 32) | static_cast<uint32_t>(edge.second);
+        }
+
+        uint64_t operator()(const ExistenceRequestMsg & msg) const {
+            return operator()(msg.edge);
+        }
+    };
+
     struct ExistenceInfoMsg {
         swapid_t swap_id;
         edge_t edge;
@@ -108,6 +146,28 @@ namespace EdgeSwapTFP {
         DECL_LEX_COMPARE_OS(ExistenceSuccessorMsg, swap_id, edge, successor);
     };
 
+    //! Edge id requested by swap swap_id/2; only sent if edge ids are tracked
+    struct EdgeIdRequestMsg {
+        swapid_t swap_id;
+        edgeid_t edge_id;
+
+        EdgeIdRequestMsg() { }
+        EdgeIdRequestMsg(const swapid_t &swap_id_, const edgeid_t &edge_id_) : swap_id(swap_id_), edge_id(edge_id_) {}
+
+        DECL_LEX_COMPARE_OS(EdgeIdRequestMsg, swap_id, edge_id);
+    };
+
+    //! State of edge id edge_id after the last swap of a run requesting it
+    struct EdgeIdUpdateMsg {
+        edgeid_t edge_id;
+        edge_t edge;
+
+        EdgeIdUpdateMsg() { }
+        EdgeIdUpdateMsg(const edgeid_t &edge_id_, const edge_t &edge_) : edge_id(edge_id_), edge(edge_) {}
+
+        DECL_LEX_COMPARE_OS(EdgeIdUpdateMsg, edge_id, edge);
+    };
+
     class EdgeSwapTFP : public EdgeSwapBase {
     protected:
         constexpr static size_t _pq_mem = PQ_INT_MEM;
@@ -116,7 +176,8 @@ namespace EdgeSwapTFP {
 
         constexpr static bool compute_stats = false;
         constexpr static bool produce_debug_vector=false;
-        constexpr static bool _async_processing = false;
+        bool _async_processing; ///< pipelined mode, see setPipelining()
+        bool _display_run_summary; ///< see setDisplayRunSummary()
 
 // memory estimation
         class MemoryEstimation {
@@ -139,25 +200,52 @@ namespace EdgeSwapTFP {
                     : _sizes( _compute(mem, no_swaps, avg_deg) )
             {}
 
+            //! Largest number of swaps per run whose estimated memory fits into mem without scaling
+            static swapid_t max_run_length(const size_t& mem, const degree_t& avg_deg);
+
         protected:
             using size_block_t = std::tuple<size_t, size_t, size_t>;
             using size_array_t = std::array<size_block_t, 10>;
             const size_array_t _sizes;
+            static size_array_t _estimate(const swapid_t& no_swaps, const degree_t& avg_deg);
             size_array_t _compute(const size_t& mem, const swapid_t& no_swaps, const degree_t& avg_deg) const;
         };
+
+        //! Resolves auto_run_length to the largest run length fitting into the memory budget
+        static swapid_t _initial_run_length(const swapid_t& run_length, const size_t& im_memory, const edgeid_t& num_edges, const node_t& num_nodes);
+
         const MemoryEstimation _mem_est;
 
 // graph
         using edge_buffer_t = EdgeStream;
 
-        const swapid_t _run_length;
+        const bool _auto_run_length;
+        const swapid_t _max_run_length; ///< run length the data structures are sized for
+        swapid_t _run_length; ///< only changed in _start_processing, i.e. by the thread pushing swaps
         edge_buffer_t &_edges;
+        EdgeUpdateLog _edge_log; ///< view of _edges including the deltas of log-structured updates
+
+// run length tuning
+        swapid_t _tuned_run_length; ///< proposal of the processing thread for the next run
+        swapid_t _processing_run_length; ///< number of swaps in the run being processed
+        double _run_load; ///< max. ratio of the volume of a data structure in the current run and its memory budget
+        uint_t _runs_started;
+        stxxl::stats_data _run_io_begin;
+        stxxl::stats_data _run_edge_io; ///< I/O of the pass merging the updates into the edges
+        std::chrono::high_resolution_clock::time_point _run_time_begin;
+
+        //! Records the volume of a data structure of the current run
+        void _record_volume(size_t bytes, size_t budget) {
+            _run_load = std::max(_run_load, static_cast<double>(bytes) / std::max<size_t>(budget, 1));
+        }
 
-        std::unique_ptr<std::thread> _result_thread;
+        void _tune_run_length();
+
+        std::future<void> _result_task;
 
 // swap -> edge
         using EdgeSwapComparator = typename GenericComparatorStruct<EdgeSwapMsg>::Ascending;
-        using EdgeSwapSorter = stxxl::sorter<EdgeSwapMsg, EdgeSwapComparator>;
+        using EdgeSwapSorter = IntSorter<EdgeSwapMsg, EdgeSwapComparator, EdgeSwapMsgKey>;
         std::unique_ptr<EdgeSwapSorter> _edge_swap_sorter;
         BoolStream _swap_directions;
 
@@ -175,15 +263,37 @@ namespace EdgeSwapTFP {
         using DependencyChainSuccessorSorter = stxxl::sorter<DependencyChainSuccessorMsg, DependencyChainSuccessorComparator>;
         DependencyChainSuccessorSorter _depchain_successor_sorter;
 
-        std::unique_ptr<std::thread> _depchain_thread;
+        std::future<void> _depchain_task;
 
         using EdgeIdVector = stxxl::VECTOR_GENERATOR<edgeid_t>::result;
 
 // existence requests
         using ExistenceRequestComparator = typename GenericComparatorStruct<ExistenceRequestMsg>::Ascending;
-        using ExistenceRequestSorter = stxxl::sorter<ExistenceRequestMsg, ExistenceRequestComparator>;
+        using ExistenceRequestSorter = IntSorter<ExistenceRequestMsg, ExistenceRequestComparator, ExistenceRequestMsgKey>;
         ExistenceRequestSorter _existence_request_sorter;
 
+// existence request screening, see setExistenceFilter() and setHubCache()
+        std::unique_ptr<BloomFilter> _graph_filter; ///< edges of the graph at the begin of the run
+        std::unique_ptr<HubAdjacencyCache> _hub_cache; ///< exact adjacency of the hubs at the begin of the run
+        std::unique_ptr<BloomFilter> _requested_filter; ///< edges requested so far in the run
+        std::unique_ptr<BloomFilter> _needed_filter; ///< edges requested as target edge after an earlier request
+
+        struct WithheldRequest {
+            ExistenceRequestMsg msg;
+            bool exists; ///< whether the edge exists in the graph at the begin of the run
+        };
+        std::vector<WithheldRequest> _withheld_requests; ///< first requests of edges with known existence
+        size_t _withheld_capacity;
+
+        // statistics of the run being processed
+        uint64_t _dropped_requests;
+        uint64_t _hub_cache_hits;
+        uint64_t _screened_requests;
+
+        void _init_request_screening();
+        void _push_existence_request(const ExistenceRequestMsg & msg);
+        void _flush_existence_requests();
+
 // existence information and dependencies
         using ExistenceInfoComparator = typename GenericComparatorStruct<ExistenceInfoMsg>::Ascending;
         using ExistenceInfoSorter = stxxl::sorter<ExistenceInfoMsg, ExistenceInfoComparator>;
@@ -197,25 +307,48 @@ namespace EdgeSwapTFP {
         using EdgeUpdateComparator = typename GenericComparator<edge_t>::Ascending;
         using EdgeUpdateSorter = stxxl::sorter<edge_t, EdgeUpdateComparator>;
         EdgeUpdateSorter _edge_update_sorter;
-        std::unique_ptr<std::thread> _edge_update_sorter_thread;
+        std::future<void> _edge_update_sorter_task;
+
+// edge id tracking (only allocated if enabled), see _apply_updates()
+        using EdgeIdRequestSorter = stxxl::sorter<EdgeIdRequestMsg, GenericComparatorStruct<EdgeIdRequestMsg>::Ascending>;
+        using EdgeIdUpdateSorter = stxxl::sorter<EdgeIdUpdateMsg, GenericComparatorStruct<EdgeIdUpdateMsg>::Ascending>;
+        std::unique_ptr<EdgeIdRequestSorter> _edge_id_request_sorter;
+        std::unique_ptr<EdgeIdUpdateSorter> _edge_id_update_sorter;
 
 // PQ used internally in _simulate_swaps and _perform_swaps
         using DependencyChainEdgeComparatorPQ = typename GenericComparatorStruct<DependencyChainEdgeMsg>::Descending;
+#ifdef EDGE_SWAP_BUCKET_PQ
+        using DependencyChainEdgePQ = MonotoneBucketPQ<DependencyChainEdgeMsg, DependencyChainEdgeComparatorPQ, SwapIdKey<DependencyChainEdgeMsg>>;
+#else
         using DependencyChainEdgePQ = typename stxxl::PRIORITY_QUEUE_GENERATOR<DependencyChainEdgeMsg, DependencyChainEdgeComparatorPQ, _pq_mem, 1 << 20>::result;
         using DependencyChainEdgePQBlock = typename DependencyChainEdgePQ::block_type;
 
         stxxl::read_write_pool<DependencyChainEdgePQBlock> _dependency_chain_pq_pool;
+#endif
         DependencyChainEdgePQ _dependency_chain_pq;
 
 // PQ used internally in _perform_swaps
         // we need to use a desc-comparator since the pq puts the largest element on top
         using ExistenceInfoPQComparator = typename GenericComparatorStruct<ExistenceInfoMsg>::Descending;
+#ifdef EDGE_SWAP_BUCKET_PQ
+        using ExistenceInfoPQ = MonotoneBucketPQ<ExistenceInfoMsg, ExistenceInfoPQComparator, SwapIdKey<ExistenceInfoMsg>>;
+#else
         using ExistenceInfoPQ = typename stxxl::PRIORITY_QUEUE_GENERATOR<ExistenceInfoMsg, ExistenceInfoPQComparator, _pq_mem, 1 << 20>::result;
         using ExistenceInfoPQBlock = typename ExistenceInfoPQ::block_type;
 
         stxxl::read_write_pool<ExistenceInfoPQBlock> _existence_info_pq_pool;
+#endif
         ExistenceInfoPQ _existence_info_pq;
 
+        //! Elements the PQs wrote to external memory so far (only known for MonotoneBucketPQ)
+        uint64_t _pq_spilled_elements() const {
+#ifdef EDGE_SWAP_BUCKET_PQ
+            return _dependency_chain_pq.spilledElements() + _existence_info_pq.spilledElements();
+#else
+            return 0;
+#endif
+        }
+
         BoolStream _edge_update_mask;
         BoolStream _last_edge_update_mask;
 
@@ -228,7 +361,109 @@ namespace EdgeSwapTFP {
         void _simulate_swaps();
         void _load_existence();
         void _perform_swaps();
-        void _apply_updates();
+
+        /**
+         * Called at the end of every run if edge ids are tracked (see _enable_edge_id_tracking()).
+         * _edge_id_update_sorter then holds the new state of every edge id touched by the run,
+         * sorted by edge id; the ids refer to the edges before the run. Derived classes use it
+         * to keep data attached to the edges, e.g. payloads, in sync with the edges.
+         */
+        virtual void _apply_updates() {}
+
+        //! Reports the state of all touched edge ids to _apply_updates() from now on;
+        //! without it, the engine sends no additional messages
+        void _enable_edge_id_tracking() {
+            _edge_id_request_sorter.reset(new EdgeIdRequestSorter(GenericComparatorStruct<EdgeIdRequestMsg>::Ascending(), _sorter_mem));
+            _edge_id_update_sorter.reset(new EdgeIdUpdateSorter(GenericComparatorStruct<EdgeIdUpdateMsg>::Ascending(), _sorter_mem));
+        }
+
+        //! Feeds the edges written by the update pass into the convergence monitor and the request screening
+        struct EdgeUpdateObserver {
+            SwapConvergenceMonitor* monitor;
+            BloomFilter* graph_filter;
+            HubAdjacencyCache* hub_cache;
+
+            bool active() const {
+                return monitor || graph_filter || hub_cache;
+            }
+
+            void begin_run() {
+                if (monitor) monitor->begin_run();
+                if (graph_filter) graph_filter->clear();
+                if (hub_cache) hub_cache->begin_run();
+            }
+
+            void observe(const edge_t & edge) {
+                if (monitor) monitor->observe(edge);
+                if (graph_filter) graph_filter->insert(ExistenceRequestMsgKey{}(edge));
+                if (hub_cache) hub_cache->observe(edge);
+            }
+
+            void end_run() {
+                if (monitor) monitor->end_run();
+                if (hub_cache) hub_cache->end_run();
+            }
+        };
+
+        //! Helper tasks run on the ThreadPool; the waiting thread executes queued tasks of this engine meanwhile
+        void _wait_for_task(std::future<void> & task) {
+            if (task.valid())
+                ThreadPool::instance().wait(task, this);
+        }
+
+        void _wait_for_edge_update_sorter() {
+            _wait_for_task(_edge_update_sorter_task);
+        }
+
+        /**
+         * Writes the updates of the previous run back into _edges while scan(stream)
+         * consumes the updated edges, i.e. the edges are read and written once.
+         * In pipelined mode, the merge and write-back run in a separate task.
+         * Edges not consumed by scan are written afterwards.
+         * With log-structured updates, the updates are appended to _edge_log instead
+         * and the edges are only rewritten if the log needs a compaction or compact is set.
+         */
+        template <class Scan>
+        void _update_and_scan_edges(Scan && scan, bool compact = false) {
+            using UpdateStream = EdgeVectorUpdateStream<EdgeStream, BoolStream, EdgeUpdateSorter, true, EdgeUpdateObserver>;
+            using LogStream = EdgeUpdateLog::ScanStream<EdgeUpdateObserver>;
+
+            _wait_for_edge_update_sorter();
+            const stxxl::stats_data io_begin(*stxxl::stats::get_instance());
+
+            EdgeUpdateObserver observer{_convergence_monitor, _graph_filter.get(), _hub_cache.get()};
+            if (_edge_log.enabled()) {
+                _edge_log.pushDelta(_last_edge_update_mask, _edge_update_sorter);
+                _edge_log.rewind();
+
+                LogStream log_stream(_edge_log, observer.active() ? &observer : nullptr,
+                                     compact || _edge_log.needsCompaction());
+                _scan_edges(log_stream, scan);
+                log_stream.finish();
+
+            } else {
+                UpdateStream update_stream(_edges, _last_edge_update_mask, _edge_update_sorter,
+                                           observer.active() ? &observer : nullptr);
+                _scan_edges(update_stream, scan);
+                update_stream.finish();
+                _edges.rewind();
+            }
+
+            _edge_update_sorter.clear();
+
+            _run_edge_io = stxxl::stats_data(*stxxl::stats::get_instance()) - io_begin;
+        }
+
+        template <class Stream, class Scan>
+        void _scan_edges(Stream & stream, Scan && scan) {
+            if (_async_processing) {
+                AsyncStream<Stream> async_stream(stream, true, 1.0e6);
+                scan(async_stream);
+                for (; !async_stream.empty(); ++async_stream) {}
+            } else {
+                scan(stream);
+            }
+        }
 
         void _reset() {
             _edge_swap_sorter->clear();
@@ -243,7 +478,7 @@ namespace EdgeSwapTFP {
         virtual void _process_swaps();
 
         virtual void _start_processing(bool async = true);
-        std::thread _process_thread;
+        std::future<void> _process_task;
 
         using ProcessSwapCallback = std::function<void(uint_t)>;
         ProcessSwapCallback _process_swap_callback;
@@ -252,13 +487,27 @@ namespace EdgeSwapTFP {
 
         node_t _num_nodes;
 
+        SwapConvergenceMonitor* _convergence_monitor;
+
+        //! Edges {u, u + _loop_offset} are rejected as loops as well (0 disables);
+        //! used by DirectedEdgeSwapTFP where they encode the arc (u, u)
+        node_t _loop_offset = 0;
+
+        bool _is_loop(const edge_t & edge) const {
+            return edge.is_loop() || (_loop_offset && edge.second - edge.first == _loop_offset);
+        }
+
     public:
+        //! Pass as run_length to derive it from the memory budget and adapt it per run
+        constexpr static swapid_t auto_run_length = 0;
+
         EdgeSwapTFP() = delete;
         EdgeSwapTFP(const EdgeSwapTFP &) = delete;
 
         //! Swaps are performed during constructor.
         //! @param edges  Edge vector changed in-place
-        //! @param swaps  Read-only swap vector
+        //! @param run_length  Swaps per scan of the edges or auto_run_length
+        //! @param im_memory  Memory budget of the internal data structures
         EdgeSwapTFP(edge_buffer_t &edges,
                     const swapid_t& run_length,
                     const node_t& num_nodes,
@@ -266,10 +515,20 @@ namespace EdgeSwapTFP {
                     ProcessSwapCallback cb = [](uint_t) {}
         ) :
               EdgeSwapBase(),
-              _mem_est(im_memory, run_length, edges.size() / num_nodes),
+              _async_processing(false),
+              _display_run_summary(false),
+              _mem_est(im_memory, _initial_run_length(run_length, im_memory, edges.size(), num_nodes), edges.size() / num_nodes),
 
-              _run_length(run_length),
+              _auto_run_length(run_length == auto_run_length),
+              _max_run_length(_initial_run_length(run_length, im_memory, edges.size(), num_nodes)),
+              _run_length(_max_run_length),
               _edges(edges),
+              _edge_log(edges),
+
+              _tuned_run_length(_max_run_length),
+              _processing_run_length(0),
+              _run_load(0.0),
+              _runs_started(0),
 
               _edge_swap_sorter(new EdgeSwapSorter(EdgeSwapComparator(), _mem_est.edge_swap_sorter())),
               _next_swap_id_pushing(0),
@@ -278,10 +537,18 @@ namespace EdgeSwapTFP {
               _depchain_edge_sorter(DependencyChainEdgeComparatorSorter{}, _mem_est.depchain_edge_sorter()),
               _depchain_successor_sorter(DependencyChainSuccessorComparator{}, _mem_est.depchain_successor_sorter()),
               _existence_request_sorter(ExistenceRequestComparator{}, _mem_est.existence_request_sorter()),
+              _withheld_capacity(0),
+              _dropped_requests(0),
+              _hub_cache_hits(0),
+              _screened_requests(0),
               _existence_info_sorter(ExistenceInfoComparator{}, _mem_est.existence_info_sorter()),
               _existence_successor_sorter(ExistenceSuccessorComparator{}, _mem_est.existence_successor_sorter()),
               _edge_update_sorter(EdgeUpdateComparator{}, _mem_est.edge_update_sorter()),
 
+#ifdef EDGE_SWAP_BUCKET_PQ
+              _dependency_chain_pq(_pq_mem + _mem_est.depchain_pq_pool()),
+              _existence_info_pq(_pq_mem + _mem_est.existence_info_pq_pool()),
+#else
               _dependency_chain_pq_pool(_mem_est.depchain_pq_pool() / DependencyChainEdgePQBlock::raw_size,
                                         _mem_est.depchain_pq_pool() / DependencyChainEdgePQBlock::raw_size),
               _dependency_chain_pq(_dependency_chain_pq_pool),
@@ -289,12 +556,14 @@ namespace EdgeSwapTFP {
               _existence_info_pq_pool(_mem_est.existence_info_pq_pool() / ExistenceInfoPQBlock::raw_size,
                                       _mem_est.existence_info_pq_pool() / ExistenceInfoPQBlock::raw_size),
               _existence_info_pq(_existence_info_pq_pool),
+#endif
 
               _first_run(true),
 
               _process_swap_callback(cb),
               _iteration(0),
-              _num_nodes(num_nodes)
+              _num_nodes(num_nodes),
+              _convergence_monitor(nullptr)
         { }
 
         EdgeSwapTFP(edge_buffer_t &edges, swap_vector &swaps, swapid_t run_length = 1000000) :
@@ -319,6 +588,58 @@ namespace EdgeSwapTFP {
         }
 
         void run();
+
+        //! Number of runs whose processing was started; the swaps pushed next belong to run runsStarted()
+        uint_t runsStarted() const {
+            return _runs_started;
+        }
+
+        //! Current number of swaps per run; changes between runs in auto mode
+        swapid_t runLength() const {
+            return _run_length;
+        }
+
+        //! Feed every rewritten edge stream into the monitor (nullptr disables).
+        //! The caller decides whether to stop pushing swaps, see pushSwapsUntilConverged().
+        void setConvergenceMonitor(SwapConvergenceMonitor* monitor) {
+            _convergence_monitor = monitor;
+        }
+
+        //! Prints a line per run (swaps, throughput, I/O, load, next run length and the
+        //! counters of the enabled optimizations) to stdout; off by default, as concurrent
+        //! engines interleave their lines. setRunProfile() records the same fields.
+        void setDisplayRunSummary(bool enable) {
+            _display_run_summary = enable;
+        }
+
+        //! Pipelined mode: the write-back of a run's updates is overlapped with the
+        //! dependency chain scan of the next run, and message sorters are sorted in
+        //! background threads. Has to be set before the first swap is pushed.
+        void setPipelining(bool enable) {
+            _async_processing = enable;
+        }
+
+        //! Pre-screens existence requests with a Bloom filter over the edges using bytes of
+        //! memory in addition to im_memory (0 disables). Requests of edges missing in the graph
+        //! that no later swap of the run requests as target edge yield no messages and
+        //! are not sorted. Reads the edges once; has to be set before the first swap is pushed.
+        void setExistenceFilter(size_t bytes);
+
+        //! Answers existence requests of edges incident to the highest degree nodes from
+        //! their adjacency lists using bytes of memory in addition to im_memory (0 disables).
+        //! As setExistenceFilter(), requests not followed by a target request of a later
+        //! swap are not sorted. Reads the edges once; has to be set before the first swap is pushed.
+        void setHubCache(size_t bytes);
+
+        //! Keeps the updates of each run as a delta of the edges instead of rewriting them.
+        //! The edges are compacted once the deltas hold more than max_delta_fraction of the
+        //! edges or max_levels deltas exist (0 disables), and at the end of run(). Until then,
+        //! process callbacks observe the edges of the last compaction.
+        //! Has to be set before the first swap is pushed.
+        void setLogStructuredUpdates(double max_delta_fraction, unsigned int max_levels = 8) {
+            assert(!_next_swap_id_pushing && !_runs_started);
+            _edge_log.setCompaction(max_delta_fraction, max_levels);
+        }
     };
 };
 
@@ -0,0 +1,249 @@
+#pragma once
+/**
+ * @file
+ * @brief  Log-structured view of an edge stream and the updates of later runs
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <defs.h>
+#include <EdgeStream.h>
+#include <BoolStream.h>
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Edge stream kept as a base stream plus sorted delta runs
+ *
+ * Each delta corresponds to the updates of one swap run: a BoolStream marking
+ * which edges of the previous view remain valid (tombstones are false) and the
+ * sorted edges inserted. Instead of rewriting the base stream after every run,
+ * readers merge all deltas on the fly as EdgeVectorUpdateStream does for a single
+ * one. Once the deltas contain more than max_delta_fraction of the edges or there
+ * are max_levels of them, the next ScanStream rewrites the base stream (compaction).
+ *
+ * Without deltas, the view is the base stream itself. If the log is disabled,
+ * deltas are never pushed.
+ */
+class EdgeUpdateLog {
+public:
+    using value_type = edge_t;
+
+protected:
+    struct Level {
+        BoolStream valid; ///< one bit per edge of the view below
+        EdgeStream inserts;
+        edge_t current;
+        bool empty;
+
+        Level() : current(edge_t::invalid()), empty(true) {}
+    };
+
+    EdgeStream & _base;
+    std::vector<Level> _levels;
+    edgeid_t _delta_edges;
+
+    double _max_delta_fraction;
+    unsigned int _max_levels;
+
+    bool _below_empty(size_t level) const {
+        return level ? _levels[level - 1].empty : _base.empty();
+    }
+
+    const edge_t & _below(size_t level) const {
+        return level ? _levels[level - 1].current : *_base;
+    }
+
+    void _advance_below(size_t level) {
+        if (level) {
+            _advance(level - 1);
+        } else {
+            ++_base;
+        }
+    }
+
+    void _skip_tombstones(size_t level) {
+        Level & l = _levels[level];
+        while (!_below_empty(level) && !*l.valid) {
+            ++l.valid;
+            _advance_below(level);
+        }
+    }
+
+    //! Moves level to the next edge of its view
+    void _advance(size_t level) {
+        Level & l = _levels[level];
+
+        const bool below_empty = _below_empty(level);
+        l.empty = below_empty && l.inserts.empty();
+        if (UNLIKELY(l.empty))
+            return;
+
+        if (below_empty || (!l.inserts.empty() && *l.inserts < _below(level))) {
+            l.current = *l.inserts;
+            ++l.inserts;
+        } else {
+            assert(!l.valid.empty() && *l.valid);
+            l.current = _below(level);
+            ++l.valid;
+            _advance_below(level);
+            _skip_tombstones(level);
+        }
+    }
+
+public:
+    explicit EdgeUpdateLog(EdgeStream & base)
+        : _base(base)
+        , _delta_edges(0)
+        , _max_delta_fraction(0.0)
+        , _max_levels(0)
+    {}
+
+    EdgeUpdateLog(const EdgeUpdateLog &) = delete;
+
+    //! Enables the log; max_levels = 0 disables it
+    void setCompaction(double max_delta_fraction, unsigned int max_levels) {
+        assert(_levels.empty());
+        _max_delta_fraction = max_delta_fraction;
+        _max_levels = max_levels;
+    }
+
+    bool enabled() const {
+        return _max_levels > 0;
+    }
+
+    size_t levels() const {
+        return _levels.size();
+    }
+
+    //! Number of edges inserted by all deltas
+    edgeid_t deltaEdges() const {
+        return _delta_edges;
+    }
+
+    bool needsCompaction() const {
+        return _levels.size() >= _max_levels
+            || _delta_edges > _max_delta_fraction * _base.size();
+    }
+
+    /**
+     * Appends the delta of a run. valid has one bit per edge of the current view
+     * and is taken over (valid is left empty); updates is a sorted stream of the
+     * edges inserted, which is consumed.
+     */
+    template <typename UpdateStream>
+    void pushDelta(BoolStream & valid, UpdateStream & updates) {
+        assert(enabled());
+
+        _levels.emplace_back();
+        Level & level = _levels.back();
+        std::swap(level.valid, valid);
+
+        for (; !updates.empty(); ++updates)
+            level.inserts.push(*updates);
+        level.inserts.consume();
+
+        _delta_edges += level.inserts.size();
+    }
+
+//! @name STXXL Streaming Interface of the view
+//! @{
+    void rewind() {
+        _base.rewind();
+        for (size_t i = 0; i < _levels.size(); ++i) {
+            _levels[i].valid.rewind();
+            _levels[i].inserts.rewind();
+            _skip_tombstones(i);
+            _advance(i);
+        }
+    }
+
+    bool empty() const {
+        return _levels.empty() ? _base.empty() : _levels.back().empty;
+    }
+
+    const value_type & operator*() const {
+        return _levels.empty() ? *_base : _levels.back().current;
+    }
+
+    const value_type * operator->() const {
+        return &operator*();
+    }
+
+    EdgeUpdateLog & operator++() {
+        if (_levels.empty()) {
+            ++_base;
+        } else {
+            _advance(_levels.size() - 1);
+        }
+        return *this;
+    }
+//! @}
+
+    /**
+     * @brief Single pass over the view; informs an observer and optionally compacts
+     *
+     * Provides the observer interface of EdgeVectorUpdateStream (begin_run(),
+     * observe(edge), end_run()). If compact is set, the view is written into a new
+     * base stream which replaces the old one together with all deltas in finish().
+     * Expects a rewound log.
+     */
+    template <typename EdgeObserver>
+    class ScanStream {
+        EdgeUpdateLog & _log;
+        EdgeObserver * _observer;
+        const bool _compact;
+        EdgeStream _edges_new;
+
+        void _emit() {
+            if (_log.empty())
+                return;
+            if (_observer) _observer->observe(*_log);
+            if (_compact) _edges_new.push(*_log);
+        }
+
+    public:
+        using value_type = edge_t;
+
+        ScanStream(EdgeUpdateLog & log, EdgeObserver * observer, bool compact)
+            : _log(log), _observer(observer), _compact(compact)
+        {
+            if (_observer) _observer->begin_run();
+            _emit();
+        }
+
+        bool empty() const {
+            return _log.empty();
+        }
+
+        const value_type & operator*() const {
+            return *_log;
+        }
+
+        ScanStream & operator++() {
+            ++_log;
+            _emit();
+            return *this;
+        }
+
+        //! Consumes the remaining edges; the log is rewound afterwards
+        void finish() {
+            while (!empty())
+                operator++();
+
+            if (_observer) _observer->end_run();
+
+            if (_compact) {
+                assert(_edges_new.size() == _log._base.size());
+                _log._base.clear();
+                std::swap(_log._base, _edges_new);
+                _log._levels.clear();
+                _log._delta_edges = 0;
+            }
+
+            _log.rewind();
+        }
+    };
+};
@@ -4,6 +4,8 @@
 
 #include "EdgeVectorCache.h"
 
+#include <algorithm>
+
 EdgeVectorCache::EdgeVectorCache(EdgeVectorCache::vector_type &external_edges) : _external_edges(external_edges) {
 }
 
@@ -16,23 +18,23 @@ void EdgeVectorCache::flushEdges() {
     std::vector<edge_t> new_edges;
     new_edges.reserve(_internal_edges.size());
     for (auto e : _internal_edges) {
-        if (e.second.first < e.second.second) {
-            new_edges.push_back(e.second);
+        if (e.first < e.second) {
+            new_edges.push_back(e);
         } else {
-            new_edges.emplace_back(e.second.second, e.second.first);
+            new_edges.emplace_back(e.second, e.first);
         }
     }
 
     std::sort(new_edges.begin(), new_edges.end());
 
-    auto old_e = _internal_edges.begin();
+    auto old_e = _ids.begin();
     auto new_e = new_edges.begin();
 
     int_t read_id = 0;
 
     while (!reader.empty() || new_e != new_edges.end()) {
         // Skip elements that were already read
-        while (old_e != _internal_edges.end() && old_e->first == read_id) {
+        while (old_e != _ids.end() && *old_e == read_id) {
             ++reader;
             ++read_id;
             ++old_e;
@@ -50,5 +52,6 @@ void EdgeVectorCache::flushEdges() {
 
     writer.finish();
     _external_edges.swap(output_vector);
+    _ids.clear();
     _internal_edges.clear();
 }
@@ -5,10 +5,19 @@
 #pragma once
 
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
 #include <stxxl/vector>
-#include <stx/btree_map>
 #include "defs.h"
 
+/**
+ * Caches the edges of an external edge vector with the given (sorted) ids in
+ * internal memory. The ids are stored in a flat sorted array next to the edges;
+ * a lookup is a branch-free binary search, i.e. a fixed sequence of conditional
+ * moves that does not suffer from mispredictions as the search in a tree does.
+ */
 class EdgeVectorCache {
 public:
     using vector_type = stxxl::VECTOR_GENERATOR<edge_t>::result;
@@ -23,21 +32,48 @@ public:
     void loadAndFlushEdges(Iterator& edges);
 
     edge_t& getEdge(int_t id) {
-        assert(_internal_edges.find(id) != _internal_edges.end());
-        return _internal_edges[id];
+        return _internal_edges[_position(id)];
     }
 
-    void setEdge(int_t id, edge_t e) { _internal_edges[id] = e; };
+    //! Replaces a loaded edge; an id that was not loaded would corrupt the flush
+    void setEdge(int_t id, edge_t e) {
+        const auto it = std::lower_bound(_ids.cbegin(), _ids.cend(), id);
+        if (it == _ids.cend() || *it != id) {
+            throw std::runtime_error("Error, cannot set an edge that was not loaded.");
+        }
+        _internal_edges[it - _ids.cbegin()] = e;
+    }
+
+    //! Number of cached edges
+    size_t size() const { return _ids.size(); }
+
 private:
     vector_type &_external_edges;
-    stx::btree_map<int_t, edge_t> _internal_edges;
+    std::vector<int_t> _ids;
+    std::vector<edge_t> _internal_edges;
+
+    //! Position of id in _ids; id has to be loaded
+    size_t _position(int_t id) const {
+        assert(!_ids.empty());
+
+        const int_t* base = _ids.data();
+        size_t n = _ids.size();
+        while (n > 1) {
+            const size_t half = n / 2;
+            base = (base[half] <= id) ? base + half : base;
+            n -= half;
+        }
+
+        assert(*base == id);
+        return base - _ids.data();
+    }
 };
 
 template <typename Iterator>
 void EdgeVectorCache::loadEdges(Iterator& edges) {
-    // FIXME: which iterator type should be used? Is it already sorted?
+    // edges has to provide the ids in ascending order
 
-    if (!_internal_edges.empty()) {
+    if (!_ids.empty()) {
         throw std::runtime_error("Error, flush internal edges before loading new edges.");
     }
 
@@ -48,8 +84,11 @@ void EdgeVectorCache::loadEdges(Iterator& edges) {
         if (edges.empty()) break;
 
         if (*edges == id) {
-            _internal_edges.insert(std::make_pair(id, *reader));
-            ++edges;
+            _ids.push_back(id);
+            _internal_edges.push_back(*reader);
+
+            // requesting an edge multiple times loads it once
+            for (; !edges.empty() && *edges == id; ++edges);
         }
 
         ++reader;
@@ -20,8 +20,18 @@
  *
  * The number of "false" in the EdgeValidStream is assumed to match the number
  * of elements in the UpdatedEdgeStream.
+ *
+ * Optionally, an observer can be supplied which is informed about every edge
+ * written (begin_run(), observe(edge), end_run()). This allows to compute
+ * statistics on the graph without an additional scan.
  */
-template <typename EdgeVector, typename EdgeValidStream, typename UpdatedEdgeStream, bool SimpleGraph>
+struct EdgeUpdateNoObserver {
+    void begin_run() {}
+    void observe(const edge_t &) {}
+    void end_run() {}
+};
+
+template <typename EdgeVector, typename EdgeValidStream, typename UpdatedEdgeStream, bool SimpleGraph, typename EdgeObserver = EdgeUpdateNoObserver>
 class EdgeVectorUpdateStream {
 public:
     using value_type = edge_t;
@@ -43,6 +53,8 @@ protected:
     // updates
     UpdatedEdgeStream& _updated_edges;
 
+    EdgeObserver* _observer;
+
     // STXXL's streaming interface
     edge_t _current;
     bool _empty;
@@ -59,7 +71,7 @@ protected:
 
 public:
     //! The edge vector remains unaltered until finish is called.
-    EdgeVectorUpdateStream(EdgeVector& edges, EdgeValidStream& valid_stream, UpdatedEdgeStream& updated_edges)
+    EdgeVectorUpdateStream(EdgeVector& edges, EdgeValidStream& valid_stream, UpdatedEdgeStream& updated_edges, EdgeObserver* observer = nullptr)
         : _edges(edges),
           _edge_reader(_edges),
           _edge_valid_stream(valid_stream),
@@ -68,8 +80,11 @@ public:
           _writer_eid(0),
 #endif
           _edge_writer(_edges_write_vector),
-          _updated_edges(updated_edges)
+          _updated_edges(updated_edges),
+          _observer(observer)
     {
+        if (_observer) _observer->begin_run();
+
         _edges_write_vector.reserve(_edges.size());
         _skip_invalid_edges();
 
@@ -119,6 +134,7 @@ public:
         //std::cout << " current: " << _current << std::endl;
 
         _edge_writer << _current;
+        if (_observer) _observer->observe(_current);
 #ifndef NDEBUG
         ++_writer_eid;
 #endif
@@ -145,6 +161,7 @@ public:
         assert(_edge_valid_stream.empty());
         assert(empty());
         _edge_writer.finish();
+        if (_observer) _observer->end_run();
 
         // switch roles of _edges and _edges_write_vector
         assert(_edges.size() == _edges_write_vector.size());
@@ -153,8 +170,8 @@ public:
     }
 };
 
-template <typename EdgeValidStream, typename UpdatedEdgeStream, bool SimpleGraph>
-class EdgeVectorUpdateStream<EdgeStream, EdgeValidStream, UpdatedEdgeStream, SimpleGraph> {
+template <typename EdgeValidStream, typename UpdatedEdgeStream, bool SimpleGraph, typename EdgeObserver>
+class EdgeVectorUpdateStream<EdgeStream, EdgeValidStream, UpdatedEdgeStream, SimpleGraph, EdgeObserver> {
 public:
     using value_type = edge_t;
 
@@ -172,6 +189,8 @@ protected:
     // updates
     UpdatedEdgeStream& _updated_edges;
 
+    EdgeObserver* _observer;
+
     // STXXL's streaming interface
     edge_t _current;
     bool _empty;
@@ -187,14 +206,17 @@ protected:
 
 public:
     //! Expects a rewinded ege stream
-    EdgeVectorUpdateStream(EdgeStream& edges, EdgeValidStream& valid_stream, UpdatedEdgeStream& updated_edges)
+    EdgeVectorUpdateStream(EdgeStream& edges, EdgeValidStream& valid_stream, UpdatedEdgeStream& updated_edges, EdgeObserver* observer = nullptr)
             : _edges(edges),
               _edge_valid_stream(valid_stream),
 #ifndef NDEBUG
               _writer_eid(0),
 #endif
-              _updated_edges(updated_edges)
+              _updated_edges(updated_edges),
+              _observer(observer)
     {
+        if (_observer) _observer->begin_run();
+
         _skip_invalid_edges();
 
         _empty = _edges.empty() && _updated_edges.empty();
@@ -241,6 +263,7 @@ public:
         }
 
         _edges_new.push(_current);
+        if (_observer) _observer->observe(_current);
 #ifndef NDEBUG
         ++_writer_eid;
 #endif
@@ -266,6 +289,7 @@ public:
         }
         assert(_edge_valid_stream.empty());
         assert(empty());
+        if (_observer) _observer->end_run();
 
         // switch roles of _edges and _edges_write_vector
         assert(_edges.size() == _edges_new.size());
@@ -0,0 +1,141 @@
+#pragma once
+/**
+ * @file
+ * @brief  Internal memory adjacency lists of the nodes with highest degree
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <stxxl/bits/unused.h>
+
+#include <defs.h>
+#include <EdgeStream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/**
+ * @brief Adjacency lists of the highest degree nodes (hubs) of a graph
+ *
+ * The hubs are selected in descending order of degree as long as their adjacency
+ * lists fit into the memory budget. As swaps preserve degrees, the hubs and the
+ * sizes of their lists never change; only the neighbours are rewritten whenever
+ * the engine writes its edge stream (begin_run(), observe(edge), end_run(), see
+ * EdgeVectorUpdateStream). Hence, contains() reflects the graph of the last pass.
+ */
+class HubAdjacencyCache {
+    std::vector<node_t> _hubs; ///< sorted ids of the hubs
+    std::vector<edgeid_t> _offsets; ///< neighbours of _hubs[i] are at [_offsets[i], _offsets[i+1])
+    std::vector<edgeid_t> _cursors;
+    std::vector<node_t> _neighbours;
+
+    size_t _hub_index(node_t node) const {
+        return std::lower_bound(_hubs.cbegin(), _hubs.cend(), node) - _hubs.cbegin();
+    }
+
+    bool _is_hub(node_t node, size_t & index) const {
+        index = _hub_index(node);
+        return index < _hubs.size() && _hubs[index] == node;
+    }
+
+    void _append(node_t hub, node_t neighbour) {
+        size_t index;
+        if (_is_hub(hub, index)) {
+            assert(_cursors[index] < _offsets[index + 1]);
+            _neighbours[_cursors[index]++] = neighbour;
+        }
+    }
+
+public:
+    //! Reads the degrees and adjacency lists from edges and rewinds it
+    HubAdjacencyCache(EdgeStream & edges, node_t num_nodes, size_t bytes) {
+        std::vector<degree_t> degrees(num_nodes, 0);
+        for (edges.rewind(); !edges.empty(); ++edges) {
+            ++degrees[edges->first];
+            ++degrees[edges->second];
+        }
+        edges.rewind();
+
+        std::vector<node_t> nodes(num_nodes);
+        for (node_t u = 0; u < num_nodes; ++u)
+            nodes[u] = u;
+        std::sort(nodes.begin(), nodes.end(), [&] (node_t a, node_t b) {
+            return degrees[a] > degrees[b] || (degrees[a] == degrees[b] && a < b);
+        });
+
+        size_t used = 0;
+        for (const node_t u : nodes) {
+            const size_t cost = degrees[u] * sizeof(node_t) + sizeof(node_t) + 2 * sizeof(edgeid_t);
+            if (!degrees[u] || used + cost > bytes)
+                break;
+
+            used += cost;
+            _hubs.push_back(u);
+        }
+        std::sort(_hubs.begin(), _hubs.end());
+
+        _offsets.assign(1, 0);
+        for (const node_t u : _hubs)
+            _offsets.push_back(_offsets.back() + degrees[u]);
+        _neighbours.resize(_offsets.back());
+
+        begin_run();
+        for (; !edges.empty(); ++edges)
+            observe(*edges);
+        end_run();
+        edges.rewind();
+    }
+
+    HubAdjacencyCache(const HubAdjacencyCache &) = delete;
+
+    //! Number of cached nodes
+    size_t numHubs() const {
+        return _hubs.size();
+    }
+
+    //! Number of edges incident to a hub (edges between hubs are counted twice)
+    edgeid_t numEdges() const {
+        return _neighbours.size();
+    }
+
+    //! True if the existence of the edge is known, i.e. one of its nodes is a hub
+    bool covers(const edge_t & edge) const {
+        size_t index;
+        return _is_hub(edge.first, index) || _is_hub(edge.second, index);
+    }
+
+    //! Requires covers(edge)
+    bool contains(const edge_t & edge) const {
+        size_t index;
+        node_t neighbour = edge.second;
+        if (!_is_hub(edge.first, index)) {
+            const bool hub = _is_hub(edge.second, index);
+            assert(hub);
+            stxxl::STXXL_UNUSED(hub);
+            neighbour = edge.first;
+        }
+
+        const auto begin = _neighbours.cbegin() + _offsets[index];
+        const auto end = _neighbours.cbegin() + _offsets[index + 1];
+        return std::binary_search(begin, end, neighbour);
+    }
+
+//! @name Observer interface of EdgeVectorUpdateStream
+//! @{
+    void begin_run() {
+        _cursors.assign(_offsets.cbegin(), _offsets.cend() - 1);
+    }
+
+    //! Has to be called for every edge of the graph in ascending order;
+    //! this keeps each list sorted as edges are normalized
+    void observe(const edge_t & edge) {
+        _append(edge.first, edge.second);
+        _append(edge.second, edge.first);
+    }
+
+    void end_run() {
+        assert(std::equal(_cursors.cbegin(), _cursors.cend(), _offsets.cbegin() + 1));
+    }
+//! @}
+};
@@ -0,0 +1,172 @@
+#include "JointDegreeEdgeSwapTFP.h"
+
+namespace EdgeSwapTFP {
+    JointDegreeSwapGenerator::JointDegreeSwapGenerator(EdgeStream & edges, const DegreeClasses & classes, swapid_t num_swaps, seed_t seed)
+        : _swaps(GenericComparatorStruct<GeneratedSwapMsg>::Ascending(), SORTER_MEM)
+        , _dropped_swaps(GenericComparator<swapid_t>::Ascending(), SORTER_MEM)
+        , _empty(false)
+    {
+        SlotUseSorter slot_uses(GenericComparatorStruct<SlotUseMsg>::Ascending(), SORTER_MEM);
+        {
+            EndpointSorter endpoints(GenericComparatorStruct<SwapEndpointMsg>::Ascending(), SORTER_MEM);
+            _draw_endpoints(edges, classes, num_swaps, seed, endpoints);
+
+            // both endpoints of a swap are adjacent in the sorted order
+            while (!endpoints.empty()) {
+                const SwapEndpointMsg first = *endpoints;
+                ++endpoints;
+                assert(!endpoints.empty() && endpoints->endpoint_id == first.endpoint_id + 1);
+                const SwapEndpointMsg second = *endpoints;
+                ++endpoints;
+
+                // both occurrences in the same edge, i.e. an edge between two nodes of the class
+                if (first.eid == second.eid)
+                    continue;
+
+                const swapid_t sid = first.endpoint_id / 2;
+                const SwapEndpointMsg & lower = (first.eid < second.eid) ? first : second;
+                const SwapEndpointMsg & upper = (first.eid < second.eid) ? second : first;
+
+                // EdgeSwapTFP::_swap_edges exchanges the first endpoints (direction true) or the
+                // second endpoint of the lower edge with the first of the upper one (direction false);
+                // exchanging the second endpoint of the upper edge yields the same edges, but crossed
+                const bool crossing = upper.pos;
+                _swaps.push(GeneratedSwapMsg(sid, lower.eid, upper.eid, lower.pos == upper.pos));
+                slot_uses.push(SlotUseMsg(lower.eid, sid, crossing));
+                slot_uses.push(SlotUseMsg(upper.eid, sid, crossing));
+            }
+        }
+        _swaps.sort();
+        slot_uses.sort();
+
+        // drop all later swaps of edges touched by a crossing swap
+        {
+            edgeid_t eid = -1;
+            bool crossed = false;
+            for (; !slot_uses.empty(); ++slot_uses) {
+                if (slot_uses->eid != eid) {
+                    eid = slot_uses->eid;
+                    crossed = false;
+                }
+
+                if (crossed)
+                    _dropped_swaps.push(slot_uses->swap_id);
+
+                crossed = crossed || slot_uses->crossing;
+            }
+        }
+        _dropped_swaps.sort();
+
+        operator++();
+    }
+
+    void JointDegreeSwapGenerator::_draw_endpoints(EdgeStream & edges, const DegreeClasses & classes, swapid_t num_swaps, seed_t seed, EndpointSorter & endpoints) {
+        // bucket the endpoints of all edges by their degree class
+        OccurrenceSorter occurrences(GenericComparatorStruct<ClassOccurrenceMsg>::Ascending(), SORTER_MEM);
+        std::vector<uint64_t> class_sizes(classes.numClasses(), 0);
+        {
+            edgeid_t eid = 0;
+            for (edges.rewind(); !edges.empty(); ++edges, ++eid) {
+                const DegreeClasses::class_t c0 = classes.classOf(edges->first);
+                const DegreeClasses::class_t c1 = classes.classOf(edges->second);
+                occurrences.push(ClassOccurrenceMsg(c0, eid, false));
+                occurrences.push(ClassOccurrenceMsg(c1, eid, true));
+                class_sizes[c0]++;
+                class_sizes[c1]++;
+            }
+            edges.rewind();
+        }
+        occurrences.sort();
+
+        // a class is drawn proportional to its number of pairs of occurrences; the
+        // products may exceed 64 bit for huge classes, hence doubles
+        std::vector<double> cumulative_pairs(class_sizes.size());
+        {
+            double sum = 0.0;
+            for (size_t k = 0; k < class_sizes.size(); ++k) {
+                if (class_sizes[k] > 1)
+                    sum += static_cast<double>(class_sizes[k]) * static_cast<double>(class_sizes[k] - 1);
+                cumulative_pairs[k] = sum;
+            }
+        }
+
+        if (!num_swaps || cumulative_pairs.empty() || cumulative_pairs.back() == 0.0) {
+            endpoints.sort();
+            return;
+        }
+
+        // draw the ranks of both occurrences of each swap within the class
+        RequestSorter requests(GenericComparatorStruct<OccurrenceRequestMsg>::Ascending(), SORTER_MEM);
+        {
+            stxxl::random_number64 random_integer(seed);
+            stxxl::random_uniform_slow random_uniform(seed + 1);
+            const double total = cumulative_pairs.back();
+
+            for (swapid_t sid = 0; sid < num_swaps; ++sid) {
+                // the upper bound skips classes without pairs; clamp in case of rounding at the end
+                const auto it = std::upper_bound(cumulative_pairs.cbegin(), cumulative_pairs.cend(), random_uniform() * total);
+                DegreeClasses::class_t k = std::min<size_t>(it - cumulative_pairs.cbegin(), class_sizes.size() - 1);
+                while (class_sizes[k] < 2) --k;
+
+                const uint64_t r0 = random_integer(class_sizes[k]);
+                uint64_t r1 = random_integer(class_sizes[k] - 1);
+                r1 += (r1 >= r0);
+
+                requests.push(OccurrenceRequestMsg(k, r0, 2 * sid));
+                requests.push(OccurrenceRequestMsg(k, r1, 2 * sid + 1));
+            }
+        }
+        requests.sort();
+
+        // resolve the ranks by merging the requests with the buckets
+        {
+            DegreeClasses::class_t current_class = 0;
+            uint64_t rank = 0;
+            for (; !requests.empty(); ++occurrences) {
+                assert(!occurrences.empty());
+                if (occurrences->degree_class != current_class) {
+                    current_class = occurrences->degree_class;
+                    rank = 0;
+                }
+
+                for (; !requests.empty() && requests->degree_class == current_class && requests->rank == rank; ++requests)
+                    endpoints.push(SwapEndpointMsg(requests->endpoint_id, occurrences->eid, occurrences->pos));
+
+                rank++;
+            }
+        }
+        endpoints.sort();
+    }
+
+    JointDegreeSwapGenerator& JointDegreeSwapGenerator::operator++() {
+        for (; !_swaps.empty(); ++_swaps) {
+            while (!_dropped_swaps.empty() && *_dropped_swaps < _swaps->swap_id)
+                ++_dropped_swaps;
+
+            if (!_dropped_swaps.empty() && *_dropped_swaps == _swaps->swap_id)
+                continue;
+
+            _current = SwapDescriptor(_swaps->eid0, _swaps->eid1, _swaps->direction);
+            ++_swaps;
+            return *this;
+        }
+
+        _empty = true;
+        return *this;
+    }
+
+    void JointDegreeEdgeSwapTFP::run(uint64_t num_swaps, seed_t seed) {
+        // edge ids are positions in the current edge stream, so the swaps of each run
+        // are generated only after the updates of all previous runs were written back
+        for (uint_t round = 0; num_swaps; ++round) {
+            const swapid_t swaps_in_run = std::min<uint64_t>(runLength(), num_swaps);
+
+            JointDegreeSwapGenerator swap_gen(_edges, _classes, swaps_in_run, seed + 2 * round);
+            for (; !swap_gen.empty(); ++swap_gen)
+                EdgeSwapTFP::push(*swap_gen);
+
+            EdgeSwapTFP::run();
+            num_swaps -= swaps_in_run;
+        }
+    }
+};
@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+#include <stxxl/random>
+#include <stxxl/sorter>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+
+namespace EdgeSwapTFP {
+    /**
+     * Degrees of nodes numbered monotonically by degree (ascending or descending), as
+     * produced by the Havel-Hakimi generators, stored as runs of equal degree.
+     * The class of a node is the index of its run, i.e. nodes of equal degree share a class.
+     */
+    class DegreeClasses {
+    public:
+        using class_t = uint32_t;
+
+    protected:
+        std::vector<node_t> _first_node;
+        std::vector<degree_t> _degree;
+        node_t _num_nodes;
+
+    public:
+        //! @param degrees  Stream of the degrees of the nodes 0, 1, ...; has to be monotonic
+        template <typename DegreeStream>
+        explicit DegreeClasses(DegreeStream & degrees) : _num_nodes(0) {
+            int direction = 0;
+            for (; !degrees.empty(); ++degrees, ++_num_nodes) {
+                const degree_t degree = *degrees;
+                if (!_degree.empty() && _degree.back() == degree)
+                    continue;
+
+                if (!_degree.empty()) {
+                    const int step = (_degree.back() < degree) ? 1 : -1;
+                    if (direction && step != direction)
+                        throw std::runtime_error("Error, the nodes have to be numbered monotonically by degree");
+                    direction = step;
+                }
+
+                _first_node.push_back(_num_nodes);
+                _degree.push_back(degree);
+            }
+        }
+
+        class_t numClasses() const {
+            return _degree.size();
+        }
+
+        node_t numNodes() const {
+            return _num_nodes;
+        }
+
+        class_t classOf(node_t u) const {
+            assert(u >= 0 && u < _num_nodes);
+            return std::upper_bound(_first_node.cbegin(), _first_node.cend(), u) - _first_node.cbegin() - 1;
+        }
+
+        degree_t degreeOf(node_t u) const {
+            return _degree[classOf(u)];
+        }
+    };
+
+    //! Endpoint pos of edge eid belongs to degree_class
+    struct ClassOccurrenceMsg {
+        DegreeClasses::class_t degree_class;
+        edgeid_t eid;
+        bool pos;
+
+        ClassOccurrenceMsg() { }
+        ClassOccurrenceMsg(DegreeClasses::class_t degree_class_, edgeid_t eid_, bool pos_) :
+            degree_class(degree_class_), eid(eid_), pos(pos_) { }
+
+        DECL_LEX_COMPARE_OS(ClassOccurrenceMsg, degree_class, eid, pos);
+    };
+
+    //! Endpoint (endpoint_id & 1) of swap (endpoint_id / 2) is the rank-th occurrence of degree_class
+    struct OccurrenceRequestMsg {
+        DegreeClasses::class_t degree_class;
+        uint64_t rank;
+        swapid_t endpoint_id;
+
+        OccurrenceRequestMsg() { }
+        OccurrenceRequestMsg(DegreeClasses::class_t degree_class_, uint64_t rank_, swapid_t endpoint_id_) :
+            degree_class(degree_class_), rank(rank_), endpoint_id(endpoint_id_) { }
+
+        DECL_LEX_COMPARE_OS(OccurrenceRequestMsg, degree_class, rank, endpoint_id);
+    };
+
+    //! Resolved OccurrenceRequestMsg
+    struct SwapEndpointMsg {
+        swapid_t endpoint_id;
+        edgeid_t eid;
+        bool pos;
+
+        SwapEndpointMsg() { }
+        SwapEndpointMsg(swapid_t endpoint_id_, edgeid_t eid_, bool pos_) :
+            endpoint_id(endpoint_id_), eid(eid_), pos(pos_) { }
+
+        DECL_LEX_COMPARE_OS(SwapEndpointMsg, endpoint_id, eid, pos);
+    };
+
+    //! Swap swap_id touches edge eid; crossing if it leaves the edge with the class pair of the other edge
+    struct SlotUseMsg {
+        edgeid_t eid;
+        swapid_t swap_id;
+        bool crossing;
+
+        SlotUseMsg() { }
+        SlotUseMsg(edgeid_t eid_, swapid_t swap_id_, bool crossing_) :
+            eid(eid_), swap_id(swap_id_), crossing(crossing_) { }
+
+        DECL_LEX_COMPARE_OS(SlotUseMsg, eid, swap_id, crossing);
+    };
+
+    struct GeneratedSwapMsg {
+        swapid_t swap_id;
+        edgeid_t eid0;
+        edgeid_t eid1;
+        bool direction;
+
+        GeneratedSwapMsg() { }
+        GeneratedSwapMsg(swapid_t swap_id_, edgeid_t eid0_, edgeid_t eid1_, bool direction_) :
+            swap_id(swap_id_), eid0(eid0_), eid1(eid1_), direction(direction_) { }
+
+        DECL_LEX_COMPARE_OS(GeneratedSwapMsg, swap_id, eid0, eid1, direction);
+    };
+
+    /**
+     * Generates swaps of a run that preserve the joint degree distribution (2K swaps),
+     * i.e. each swap exchanges two endpoints of equal degree of the two edges.
+     *
+     * Every edge contributes one occurrence per endpoint to the bucket of the endpoint's
+     * degree class. A swap draws a class with probability proportional to the number of
+     * pairs of its occurrences and then two distinct occurrences of the class uniformly.
+     * The ids of the occurrences are resolved by sorting the draws against the buckets,
+     * so the generator needs a scan of the edges and O(sort(num_swaps + edges)) I/Os.
+     *
+     * Since the nodes are numbered monotonically by degree, the endpoint of a class keeps
+     * its position within the normalized edge if it is exchanged by another of the same
+     * class, so a swap leaves the class pairs of both edges unchanged as long as EdgeSwapTFP
+     * writes each new edge to the id of the edge it originates from. This does not hold
+     * if the occurrence in the edge with the larger id is its second endpoint: the swap
+     * is executed with the new edges crossed, and later swaps of the run touching one of
+     * the two edges are dropped, as they might no longer be admissible.
+     * Draws of two occurrences in the same edge are dropped as well, so fewer swaps than
+     * requested may be produced.
+     */
+    class JointDegreeSwapGenerator {
+    public:
+        using value_type = SwapDescriptor;
+
+    protected:
+        using OccurrenceSorter = stxxl::sorter<ClassOccurrenceMsg, GenericComparatorStruct<ClassOccurrenceMsg>::Ascending>;
+        using RequestSorter = stxxl::sorter<OccurrenceRequestMsg, GenericComparatorStruct<OccurrenceRequestMsg>::Ascending>;
+        using EndpointSorter = stxxl::sorter<SwapEndpointMsg, GenericComparatorStruct<SwapEndpointMsg>::Ascending>;
+        using SlotUseSorter = stxxl::sorter<SlotUseMsg, GenericComparatorStruct<SlotUseMsg>::Ascending>;
+        using SwapSorter = stxxl::sorter<GeneratedSwapMsg, GenericComparatorStruct<GeneratedSwapMsg>::Ascending>;
+        using SwapIdSorter = stxxl::sorter<swapid_t, GenericComparator<swapid_t>::Ascending>;
+
+        SwapSorter _swaps;
+        SwapIdSorter _dropped_swaps;
+        SwapDescriptor _current;
+        bool _empty;
+
+        //! Draws the occurrences of all swaps and resolves them into edge ids
+        void _draw_endpoints(EdgeStream & edges, const DegreeClasses & classes, swapid_t num_swaps, seed_t seed, EndpointSorter & endpoints);
+
+    public:
+        //! @param edges  Current edges; rewound afterwards
+        //! @param classes  Degree classes of the nodes of edges
+        JointDegreeSwapGenerator(EdgeStream & edges, const DegreeClasses & classes, swapid_t num_swaps, seed_t seed);
+
+//! @name STXXL Streaming Interface
+//! @{
+        bool empty() const {return _empty;}
+        const value_type & operator*() const {return _current;}
+        JointDegreeSwapGenerator& operator++();
+//! @}
+    };
+
+    /**
+     * Randomizes a graph while preserving its joint degree distribution: run() pushes
+     * swaps of a JointDegreeSwapGenerator for the current edges run by run, so only
+     * admissible swaps reach the dependency machinery of EdgeSwapTFP.
+     *
+     * The nodes have to be numbered monotonically by degree, see DegreeClasses.
+     */
+    class JointDegreeEdgeSwapTFP : public EdgeSwapTFP {
+    protected:
+        const DegreeClasses & _classes;
+
+    public:
+        JointDegreeEdgeSwapTFP() = delete;
+        JointDegreeEdgeSwapTFP(const JointDegreeEdgeSwapTFP &) = delete;
+
+        //! @param edges  Edge vector changed in-place
+        //! @param classes  Degree classes of the nodes; has to outlive the object
+        //! @param run_length  Swaps per scan of the edges or auto_run_length
+        //! @param im_memory  Memory budget of the internal data structures
+        JointDegreeEdgeSwapTFP(edge_buffer_t &edges, const DegreeClasses & classes, const swapid_t& run_length, const size_t& im_memory) :
+            EdgeSwapTFP(edges, run_length, classes.numNodes(), im_memory),
+            _classes(classes)
+        { }
+
+        //! Generates and executes num_swaps 2K swaps
+        void run(uint64_t num_swaps, seed_t seed = stxxl::get_next_seed());
+    };
+};
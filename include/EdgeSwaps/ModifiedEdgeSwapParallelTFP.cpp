@@ -0,0 +1,61 @@
+#include "ModifiedEdgeSwapParallelTFP.h"
+
+#include <utility>
+
+#include "EdgeVectorUpdateStream.h"
+#include <Utils/EdgeToEdgeSwapPusher.h>
+
+namespace ModifiedEdgeSwapParallelTFP {
+    void ModifiedEdgeSwapParallelTFP::run() {
+        if (!_runnable)
+            return;
+
+        std::cout << "_iteration: " << _iteration++ << ", _swaps_: " << _staged_swaps.size() << std::endl;
+
+        if (!_staged_swaps.size()) {
+            _runnable = false;
+            return;
+        }
+
+        // swaps pushed while applying the updates are staged for the next iteration
+        SwapStream swaps(std::move(_staged_swaps));
+        _staged_swaps.clear();
+
+        // BasicEdgeSwapParallelTFP processes a run whenever run_length swaps are pushed
+        for (swaps.consume(); !swaps.empty(); ++swaps)
+            BasicEdgeSwapParallelTFP::push(*swaps);
+
+        if (_num_swaps_in_run)
+            process_swaps();
+
+        _apply_updates();
+    }
+
+    void ModifiedEdgeSwapParallelTFP::_apply_updates() {
+        using UpdateStream = EdgeVectorUpdateStream<EdgeStream, BoolStream, EdgeUpdateMerger, false>;
+
+        EdgeStream final_stream;
+
+        if (_needs_writeback) {
+            // write back and search for illegal edges in the same scan
+            UpdateStream update_stream(_edges, _valid_edges, _edge_update_merger);
+            EdgeToEdgeSwapPusher<UpdateStream, EdgeStream, ModifiedEdgeSwapParallelTFP>(
+                    update_stream, _edges.size(), final_stream, *this);
+
+            update_stream.finish();
+            _edge_update_merger.deallocate();
+            _needs_writeback = false;
+
+        } else {
+            EdgeToEdgeSwapPusher<EdgeStream, EdgeStream, ModifiedEdgeSwapParallelTFP>(_edges, final_stream, *this);
+        }
+
+        final_stream.consume();
+        std::swap(final_stream, _edges);
+
+        std::cout << "Apply updates, swaps: " << swaps_pushed() << std::endl;
+
+        if (!swaps_pushed())
+            _runnable = false;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stxxl/bits/unused.h>
+#include <iostream>
+
+#include <defs.h>
+#include "Swaps.h"
+#include "EdgeSwapParallelTFP.h"
+
+#include <EdgeStream.h>
+#include <SwapStream.h>
+
+namespace ModifiedEdgeSwapParallelTFP {
+    /**
+     * Parallel counterpart of ModifiedEdgeSwapTFP: removes the multi-edges and loops of
+     * a multigraph (e.g. produced by the configuration model) by targeted swaps.
+     *
+     * Swaps pushed are staged and executed by the next call to run() using the batches
+     * of BasicEdgeSwapParallelTFP in its multigraph mode. When writing back the edges of an
+     * iteration, a swap with a random partner is staged for every remaining multi-edge
+     * and loop; the algorithm is runnable as long as there are staged swaps.
+     */
+    class ModifiedEdgeSwapParallelTFP : public EdgeSwapParallelTFP::BasicEdgeSwapParallelTFP<true> {
+    protected:
+        SwapStream _staged_swaps;
+
+        bool _runnable = true;
+        int_t _iteration = 0;
+
+        //! Writes back the updates of the last run and stages swaps for illegal edges
+        void _apply_updates();
+
+    public:
+        ModifiedEdgeSwapParallelTFP() = delete;
+        ModifiedEdgeSwapParallelTFP(const ModifiedEdgeSwapParallelTFP &) = delete;
+
+        //! @param edges  Edge stream changed in-place; may contain multi-edges and loops
+        //! @param run_length  Number of swaps per graph scan
+        ModifiedEdgeSwapParallelTFP(EdgeStream &edges, swapid_t run_length, int num_threads = omp_get_max_threads()) :
+            BasicEdgeSwapParallelTFP(edges, run_length, num_threads)
+        { }
+
+        ModifiedEdgeSwapParallelTFP(EdgeStream &edges, swap_vector &swaps, swapid_t run_length = 1000000) :
+            ModifiedEdgeSwapParallelTFP(edges, run_length)
+        {
+            std::cerr << "Using deprecated EdgeSwapTFP constructor. This is likely much slower!" << std::endl;
+            stxxl::STXXL_UNUSED(swaps);
+        }
+
+        void push(const SwapDescriptor & swap) {
+            _staged_swaps.push(swap);
+        }
+
+        //! Executes all staged swaps
+        void run();
+
+        bool runnable() const {
+            return _runnable;
+        }
+
+        swapid_t swaps_pushed() const {
+            return _staged_swaps.size();
+        }
+
+//! @name STXXL Streaming Interface
+//! @{
+        bool empty() const {
+            return _edges.empty();
+        }
+
+        const edge_t& operator*() const {
+            assert(!_edges.empty());
+
+            return *_edges;
+        }
+
+        ModifiedEdgeSwapParallelTFP& operator++() {
+            assert(!_edges.empty());
+
+            ++_edges;
+
+            return *this;
+        }
+
+        void consume() {
+            _edges.consume();
+        }
+
+        size_t size() {
+            return _edges.size();
+        }
+//! @}
+    };
+}
+
+template <>
+struct EdgeSwapTrait<ModifiedEdgeSwapParallelTFP::ModifiedEdgeSwapParallelTFP> {
+    static bool swapVector() {return false;}
+    static bool pushableSwaps() {return true;}
+    static bool pushableSwapBuffers() {return false;}
+    static bool edgeStream() {return true;}
+};
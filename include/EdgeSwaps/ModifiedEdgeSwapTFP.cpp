@@ -150,6 +150,9 @@ namespace ModifiedEdgeSwapTFP {
         REPORT_SORTER_STATS(_depchain_successor_sorter);
         _depchain_edge_sorter.sort();
         REPORT_SORTER_STATS(_depchain_edge_sorter);
+
+        _run_profile.set("depchain_edge_sorter", _depchain_edge_sorter.size());
+        _run_profile.set("depchain_successor_sorter", _depchain_successor_sorter.size());
     }
 
     /*
@@ -355,13 +358,14 @@ namespace ModifiedEdgeSwapTFP {
 
         _existence_request_sorter.sort();
         REPORT_SORTER_STATS(_existence_request_sorter)
+        _run_profile.set("existence_request_sorter", _existence_request_sorter.size());
         _swap_directions.rewind();
 
         if (_async_processing) {
-            _depchain_thread.reset(new std::thread([&]() {
+            _depchain_task = ThreadPool::instance().submit([this]() {
                 _depchain_successor_sorter.rewind();
                 _depchain_edge_sorter.rewind();
-            }));
+            }, "ModifiedEdgeSwapTFP::depchain", this);
         } else {
             _depchain_successor_sorter.rewind();
             _depchain_edge_sorter.rewind();
@@ -469,12 +473,14 @@ namespace ModifiedEdgeSwapTFP {
 
         REPORT_SORTER_STATS(_existence_successor_sorter);
         REPORT_SORTER_STATS(_existence_info_sorter);
+        _run_profile.set("existence_successor_sorter", _existence_successor_sorter.size());
+        _run_profile.set("existence_info_sorter", _existence_info_sorter.size());
 
         if (_async_processing) {
-            std::thread t1([&](){_existence_successor_sorter.sort();});
-            std::thread t2([&](){_existence_info_sorter.sort();});
+            auto successor_sort = ThreadPool::instance().submit([this](){_existence_successor_sorter.sort();}, "ModifiedEdgeSwapTFP::existence_sort", this);
+            _existence_info_sorter.sort();
             //_existence_request_sorter.finish_clear();
-            t1.join(); t2.join();
+            _wait_for_task(successor_sort);
         } else {
             //_existence_request_sorter.finish_clear();
             _existence_successor_sorter.sort();
@@ -490,7 +496,7 @@ namespace ModifiedEdgeSwapTFP {
      *  _depchain_successor_sorter stores swaps we need to inform about our actions
      */
     void ModifiedEdgeSwapTFP::_perform_swaps() {
-        if (_depchain_thread) _depchain_thread->join();
+        _wait_for_task(_depchain_task);
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         // debug only
@@ -533,6 +539,7 @@ namespace ModifiedEdgeSwapTFP {
         swapid_t counter_performed = 0;
         swapid_t counter_not_performed = 0;
         swapid_t counter_loop = 0;
+        swapid_t counter_multi_edge = 0;
         swapid_t counter_invalid = 0;
 
 
@@ -608,12 +615,11 @@ namespace ModifiedEdgeSwapTFP {
             const bool loop = !edge_invalid && (new_edges[0].is_loop() || new_edges[1].is_loop());
             const bool perform_swap = !(conflict_exists[0] || conflict_exists[1] || loop || edge_invalid);
 
-            if (compute_stats) {
-                counter_performed += perform_swap;
-                counter_not_performed += !perform_swap;
-                counter_loop += loop;
-                counter_invalid += edge_invalid;
-            }
+            counter_performed += perform_swap;
+            counter_not_performed += !perform_swap;
+            counter_loop += loop;
+            counter_multi_edge += !loop && !edge_invalid && (conflict_exists[0] || conflict_exists[1]);
+            counter_invalid += edge_invalid;
 
             // update multiplicity
             if (LIKELY(perform_swap)) {
@@ -697,12 +703,15 @@ namespace ModifiedEdgeSwapTFP {
         edge_state_pqsort.dump_stats("edge_state_pqsort");
         existence_info_pqsort.dump_stats("existence_info_pqsort");
 
-        if (_result_thread) _result_thread->join();
+        _run_profile.set("performed", counter_performed);
+        _run_profile.set("rejected_loop", counter_loop);
+        _run_profile.set("rejected_multi_edge", counter_multi_edge);
+        _run_profile.set("rejected_invalid", counter_invalid);
+
+        _wait_for_task(_result_task);
 #ifdef EDGE_SWAP_DEBUG_VECTOR
         if (_async_processing) {
-            _result_thread.reset(
-                new std::thread([&](){debug_vector_writer.finish();})
-            );
+            _result_task = ThreadPool::instance().submit([&](){debug_vector_writer.finish();}, "ModifiedEdgeSwapTFP::result", this);
         } else {
             debug_vector_writer.finish();
         }
@@ -719,11 +728,10 @@ namespace ModifiedEdgeSwapTFP {
         //_existence_info_sorter.finish_clear();
         
         REPORT_SORTER_STATS(_edge_update_sorter);
+        _run_profile.set("edge_update_sorter", _edge_update_sorter.size());
 
         if (_async_processing) {
-            _edge_update_sorter_thread.reset(
-                new std::thread([&](){_edge_update_sorter.sort();})
-            );
+            _edge_update_sorter_task = ThreadPool::instance().submit([this](){_edge_update_sorter.sort();}, "ModifiedEdgeSwapTFP::edge_update_sort", this);
         } else {
             _edge_update_sorter.sort();
         }
@@ -732,6 +740,8 @@ namespace ModifiedEdgeSwapTFP {
     void ModifiedEdgeSwapTFP::_apply_updates() {
         using UpdateStream = EdgeVectorUpdateStream<EdgeStream, BoolStream, decltype(_edge_update_sorter), false>;
 
+        _wait_for_task(_edge_update_sorter_task);
+
         // At this line of code, _edge_swap_sorter will always be empty
         _next_swap_id_pushing = 0;
         _edge_swap_sorter_pushing->clear();
@@ -779,18 +789,27 @@ namespace ModifiedEdgeSwapTFP {
 
         std::cout << "_edges.size(): " << _edges.size() << std::endl;
 
+        _run_profile.beginRun("ModifiedEdgeSwapTFP", internal_count - 1);
+        _run_profile.set("swaps", _edge_swap_sorter->size() / 2);
+        _run_profile.beginPhase("dependency_chain");
+
         _compute_dependency_chain(_edges, _edge_update_mask);
         std::swap(_edge_update_mask, _last_edge_update_mask);
 
         _report_stats("_compute_dependency_chain: ", show_stats);
+        _run_profile.beginPhase("simulate_swaps");
         _simulate_swaps();
         _report_stats("_simulate_swaps: ", show_stats);
+        _run_profile.beginPhase("load_existence");
         _load_existence();
         _report_stats("_load_existence: ", show_stats);
+        _run_profile.beginPhase("perform_swaps");
         _perform_swaps();
         _report_stats("_perform_swaps: ", show_stats);
+        _run_profile.beginPhase("apply_updates");
         _apply_updates();
         _report_stats("_apply_updates: ", show_stats);
+        _run_profile.endRun();
 
         _reset();
         _report_stats("_process_swaps: ", show_stats);
@@ -806,8 +825,7 @@ namespace ModifiedEdgeSwapTFP {
         _swap_directions_pushing.consume();
 
         // wait for computation to finish (if there is some)
-        if (_process_thread.joinable())
-            _process_thread.join();
+        _wait_for_task(_process_task);
 
         // reset old data structures
         _swap_directions.clear();
@@ -827,8 +845,8 @@ namespace ModifiedEdgeSwapTFP {
         }
 
         if (async) {
-            // start worker thread
-            _process_thread = std::thread(&ModifiedEdgeSwapTFP::_process_swaps, this);
+            // process the run on the thread pool
+            _process_task = ThreadPool::instance().submit([this]() {_process_swaps();}, "ModifiedEdgeSwapTFP::process", this);
         } else {
             // do it ourselves
             _process_swaps();
@@ -3,8 +3,8 @@
 #include <stxxl/vector>
 #include <stxxl/sorter>
 #include <stxxl/bits/unused.h>
+#include <future>
 #include <memory>
-#include <thread>
 
 #include <defs.h>
 #include "Swaps.h"
@@ -16,6 +16,7 @@
 #include <stxxl/priority_queue>
 
 #include <EdgeStream.h>
+#include <Utils/ThreadPool.h>
 
 namespace ModifiedEdgeSwapTFP {
     struct EdgeSwapMsg {
@@ -151,7 +152,7 @@ namespace ModifiedEdgeSwapTFP {
         const swapid_t _run_length;
         edge_buffer_t &_edges;
 
-        std::unique_ptr<std::thread> _result_thread;
+        std::future<void> _result_task;
 
 // swap -> edge
         using EdgeSwapComparator = typename GenericComparatorStruct<EdgeSwapMsg>::Ascending;
@@ -173,7 +174,7 @@ namespace ModifiedEdgeSwapTFP {
         using DependencyChainSuccessorSorter = stxxl::sorter<DependencyChainSuccessorMsg, DependencyChainSuccessorComparator>;
         DependencyChainSuccessorSorter _depchain_successor_sorter;
 
-        std::unique_ptr<std::thread> _depchain_thread;
+        std::future<void> _depchain_task;
 
         using EdgeIdVector = stxxl::VECTOR_GENERATOR<edgeid_t>::result;
 
@@ -195,9 +196,7 @@ namespace ModifiedEdgeSwapTFP {
         using EdgeUpdateComparator = typename GenericComparator<edge_t>::Ascending;
         using EdgeUpdateSorter = stxxl::sorter<edge_t, EdgeUpdateComparator>;
         EdgeUpdateSorter _edge_update_sorter;
-        std::unique_ptr<std::thread> _edge_update_sorter_thread;
-        // Hung
-        std::unique_ptr<std::thread> _apply_update_thread;
+        std::future<void> _edge_update_sorter_task;
 
 // PQ used internally in _simulate_swaps and _perform_swaps
         using DependencyChainEdgeComparatorPQ = typename GenericComparatorStruct<DependencyChainEdgeMsg>::Descending;
@@ -230,6 +229,11 @@ namespace ModifiedEdgeSwapTFP {
         void _perform_swaps();
         void _apply_updates();
 
+        void _wait_for_task(std::future<void> & task) {
+            if (task.valid())
+                ThreadPool::instance().wait(task, this);
+        }
+
         // Hung
         bool _runnable = true;
         int_t internal_count = 0;
@@ -247,7 +251,7 @@ namespace ModifiedEdgeSwapTFP {
         virtual void _process_swaps();
 
         virtual void _start_processing(bool async = true);
-        std::thread _process_thread;
+        std::future<void> _process_task;
 
     public:
         ModifiedEdgeSwapTFP() = delete;
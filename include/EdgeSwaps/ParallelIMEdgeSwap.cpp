@@ -0,0 +1,194 @@
+#include <EdgeSwaps/ParallelIMEdgeSwap.h>
+#include <IMGraphWrapper.h>
+
+#include <algorithm>
+
+ParallelIMEdgeSwap::ParallelIMEdgeSwap(IMGraph &graph, int num_threads, size_t batch_size)
+    : _graph_wrapper(0), _graph(graph)
+    , _num_threads(std::max(1, num_threads)), _batch_size(std::max<size_t>(1, batch_size))
+    , _window(64 * _num_threads)
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    , _debug_vector_writer(_result)
+#endif
+{
+    _allocate_reservations();
+}
+
+ParallelIMEdgeSwap::ParallelIMEdgeSwap(IMGraph &graph, const stxxl::vector< SwapDescriptor > &) : ParallelIMEdgeSwap(graph)
+{}
+
+ParallelIMEdgeSwap::ParallelIMEdgeSwap(EdgeStream &edges, const stxxl::vector< SwapDescriptor > &) : ParallelIMEdgeSwap(edges)
+{}
+
+ParallelIMEdgeSwap::ParallelIMEdgeSwap(EdgeStream &edges, int num_threads, size_t batch_size)
+    : _graph_wrapper(new IMGraphWrapper(edges)), _graph(_graph_wrapper->getGraph())
+    , _num_threads(std::max(1, num_threads)), _batch_size(std::max<size_t>(1, batch_size))
+    , _window(64 * _num_threads)
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    , _debug_vector_writer(_result)
+#endif
+{
+    _allocate_reservations();
+}
+
+ParallelIMEdgeSwap::~ParallelIMEdgeSwap() {
+    if (_graph_wrapper != 0) {
+        delete _graph_wrapper;
+    }
+}
+
+void ParallelIMEdgeSwap::_allocate_reservations() {
+    // the graph only supports edges between nodes of its degree sequence, so its size is fixed
+    const uint_t num_edges = _graph.numEdges();
+    const uint_t num_nodes = _graph.numNodes();
+
+    _edge_reservations.reset(new std::atomic<uint32_t>[num_edges]);
+    _node_reservations.reset(new std::atomic<uint32_t>[num_nodes]);
+
+    #pragma omp parallel for num_threads(_num_threads)
+    for (int_t i = 0; i < static_cast<int_t>(num_edges); ++i)
+        _edge_reservations[i].store(_unreserved, std::memory_order_relaxed);
+
+    #pragma omp parallel for num_threads(_num_threads)
+    for (int_t i = 0; i < static_cast<int_t>(num_nodes); ++i)
+        _node_reservations[i].store(_unreserved, std::memory_order_relaxed);
+}
+
+void ParallelIMEdgeSwap::_process_swaps() {
+    if (_swaps.empty())
+        return;
+
+    // with a single thread, or if the parallel region would be inactive as the maximal
+    // number of nested active levels is reached, the reservations only add overhead
+    if (_num_threads < 2 || omp_get_active_level() >= omp_get_max_active_levels()) {
+        for (const auto & swap : _swaps) {
+            auto result = _graph.swapEdges(swap.edges()[0], swap.edges()[1], swap.direction());
+            stxxl::STXXL_UNUSED(result);
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+            _debug_vector_writer << result;
+#endif
+        }
+
+        _swaps.clear();
+        return;
+    }
+
+    struct PendingSwap {
+        uint32_t index;   ///< position of the swap within _swaps
+        node_t nodes[4];  ///< nodes of the swap, read during the reservation
+        bool committed;
+    };
+
+    std::vector<PendingSwap> pending(_swaps.size());
+    for (size_t i = 0; i < _swaps.size(); ++i)
+        pending[i].index = static_cast<uint32_t>(i);
+
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    std::vector<SwapResult> results(_swaps.size());
+#endif
+
+    auto reserve = [] (std::atomic<uint32_t> & reservation, uint32_t pos) {
+        uint32_t current = reservation.load(std::memory_order_relaxed);
+        while (pos < current && !reservation.compare_exchange_weak(current, pos, std::memory_order_relaxed));
+    };
+
+    auto holds = [] (const std::atomic<uint32_t> & reservation, uint32_t pos) {
+        return reservation.load(std::memory_order_relaxed) == pos;
+    };
+
+    while (!pending.empty()) {
+        const size_t window = std::min(_window, pending.size());
+        size_t num_committed = 0;
+
+        #pragma omp parallel num_threads(_num_threads) reduction(+:num_committed)
+        {
+            // reserve edges and nodes; the graph is not modified in this phase
+            #pragma omp for schedule(static)
+            for (int_t pos = 0; pos < static_cast<int_t>(window); ++pos) {
+                PendingSwap & ps = pending[pos];
+                const swap_descriptor & swap = _swaps[ps.index];
+
+                const edge_t e0 = _graph.getEdge(swap.edges()[0]);
+                const edge_t e1 = _graph.getEdge(swap.edges()[1]);
+                ps.nodes[0] = e0.first;
+                ps.nodes[1] = e0.second;
+                ps.nodes[2] = e1.first;
+                ps.nodes[3] = e1.second;
+
+                reserve(_edge_reservations[swap.edges()[0]], pos);
+                reserve(_edge_reservations[swap.edges()[1]], pos);
+                for (const node_t u : ps.nodes)
+                    reserve(_node_reservations[u], pos);
+            }
+
+            // execute the swaps owning all their reservations
+            #pragma omp for schedule(static)
+            for (int_t pos = 0; pos < static_cast<int_t>(window); ++pos) {
+                PendingSwap & ps = pending[pos];
+                const swap_descriptor & swap = _swaps[ps.index];
+
+                ps.committed = holds(_edge_reservations[swap.edges()[0]], pos)
+                            && holds(_edge_reservations[swap.edges()[1]], pos);
+                for (const node_t u : ps.nodes)
+                    ps.committed = ps.committed && holds(_node_reservations[u], pos);
+
+                if (!ps.committed)
+                    continue;
+
+                auto result = _graph.swapEdges(swap.edges()[0], swap.edges()[1], swap.direction());
+                stxxl::STXXL_UNUSED(result);
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+                results[ps.index] = result;
+#endif
+                ++num_committed;
+            }
+
+            // release reservations for the next round
+            #pragma omp for schedule(static)
+            for (int_t pos = 0; pos < static_cast<int_t>(window); ++pos) {
+                PendingSwap & ps = pending[pos];
+                const swap_descriptor & swap = _swaps[ps.index];
+
+                _edge_reservations[swap.edges()[0]].store(_unreserved, std::memory_order_relaxed);
+                _edge_reservations[swap.edges()[1]].store(_unreserved, std::memory_order_relaxed);
+                for (const node_t u : ps.nodes)
+                    _node_reservations[u].store(_unreserved, std::memory_order_relaxed);
+            }
+        }
+
+        // keep the order of the swaps that have to be retried
+        pending.erase(std::remove_if(pending.begin(), pending.begin() + window,
+                                     [] (const PendingSwap & ps) { return ps.committed; }),
+                      pending.begin() + window);
+
+        // grow the window while most swaps succeed, shrink it on many conflicts
+        if (2 * num_committed > window) {
+            _window = std::min(2 * _window, _batch_size);
+        } else if (10 * num_committed < window) {
+            _window = std::max<size_t>(_window / 2, _num_threads);
+        }
+    }
+
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    for (const auto & result : results)
+        _debug_vector_writer << result;
+#endif
+
+    _swaps.clear();
+}
+
+void ParallelIMEdgeSwap::flush() {
+    _process_swaps();
+
+    if (_graph_wrapper != 0) {
+        _graph_wrapper->updateEdges();
+    }
+}
+
+void ParallelIMEdgeSwap::run() {
+    flush();
+
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    _debug_vector_writer.finish();
+#endif
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <omp.h>
+
+#include <IMGraph.h>
+#include <EdgeSwaps/EdgeSwapBase.h>
+#include <EdgeStream.h>
+class IMGraphWrapper;
+
+/**
+ * Parallel counterpart of IMEdgeSwap that produces exactly the same graph.
+ *
+ * Pushed swaps are buffered and executed in batches using deterministic reservations:
+ * in each round, every pending swap of a window at the front of the batch reserves its
+ * two edge ids and its four nodes by writing its position into them (the smallest
+ * position wins). A swap owning all its reservations is executed concurrently with the
+ * other winners; the remaining swaps stay pending in their order. Since a swap only
+ * reads and writes the adjacency of its own nodes, any earlier swap that could influence
+ * it shares an edge or a node with it and hence is executed before. The result therefore
+ * neither depends on the number of threads nor on the window size, which only adapts to
+ * the observed conflict rate.
+ */
+class ParallelIMEdgeSwap : public EdgeSwapBase {
+private:
+    IMGraphWrapper *_graph_wrapper;
+    IMGraph &_graph;
+    const int _num_threads;
+    const size_t _batch_size;
+
+    std::vector<swap_descriptor> _swaps;
+
+    // reservations hold the position of a pending swap within the window or _unreserved
+    static constexpr uint32_t _unreserved = std::numeric_limits<uint32_t>::max();
+    std::unique_ptr<std::atomic<uint32_t>[]> _edge_reservations;
+    std::unique_ptr<std::atomic<uint32_t>[]> _node_reservations;
+
+    size_t _window;
+
+#ifdef EDGE_SWAP_DEBUG_VECTOR
+    typename debug_vector::bufwriter_type _debug_vector_writer;
+#endif
+
+    void _allocate_reservations();
+
+    //! Executes the buffered swaps
+    void _process_swaps();
+
+public:
+    /**
+     * @param num_threads Number of threads used for the swaps; callers within a parallel
+     *                    region have to pass their share as nested regions are not limited
+     * @param batch_size  Number of swaps buffered before they are executed in parallel
+     */
+    ParallelIMEdgeSwap(IMGraph &graph, int num_threads = omp_get_max_threads(), size_t batch_size = 1llu << 20);
+    ParallelIMEdgeSwap(IMGraph &graph, const stxxl::vector<SwapDescriptor>&);
+
+    /**
+     * Initializes the parallel IM edge swap implementation with the given edge vector that is converted into an internal memory graph.
+     *
+     * @param edges The given edge vector
+     * @param swaps IGNORED, use push() instead
+     */
+    ParallelIMEdgeSwap(EdgeStream &edges, const stxxl::vector<SwapDescriptor>&);
+
+    ParallelIMEdgeSwap(EdgeStream &edges, int num_threads = omp_get_max_threads(), size_t batch_size = 1llu << 20);
+
+    ~ParallelIMEdgeSwap();
+
+    //! Buffers a single swap; executes the batch once it is full
+    void push(const swap_descriptor& swap) {
+        _swaps.push_back(swap);
+        if (_swaps.size() >= _batch_size)
+            _process_swaps();
+    }
+
+    //! Executes all buffered swaps and writes out changes into edge vector if given in constructor. Further swaps can still be given aftwards.
+    void flush();
+
+    //! Same as flush(); finishes writing the debug vector when enabled.
+    void run();
+};
+
+template <>
+struct EdgeSwapTrait<ParallelIMEdgeSwap> {
+    static bool swapVector() {return false;}
+    static bool pushableSwaps() {return true;}
+    static bool pushableSwapBuffers() {return false;}
+    static bool edgeStream() {return true;}
+};
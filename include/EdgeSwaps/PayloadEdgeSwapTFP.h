@@ -0,0 +1,132 @@
+#pragma once
+#include <type_traits>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+
+namespace EdgeSwapTFP {
+    //! Edge with its payload, sorted by the edge only
+    template <typename Payload>
+    struct PayloadEdgeMsg {
+        edge_t edge;
+        Payload payload;
+
+        PayloadEdgeMsg() { }
+        PayloadEdgeMsg(const edge_t &edge_, const Payload &payload_) : edge(edge_), payload(payload_) {}
+
+        struct Ascending {
+            bool operator()(const PayloadEdgeMsg & a, const PayloadEdgeMsg & b) const {return a.edge < b.edge;}
+            PayloadEdgeMsg min_value() const {return {std::numeric_limits<edge_t>::min(), Payload()};}
+            PayloadEdgeMsg max_value() const {return {std::numeric_limits<edge_t>::max(), Payload()};}
+        };
+    };
+
+    /**
+     * Copies the topology of edges with payloads into an EdgeStream, which is
+     * swapped by EdgeSwapTFP; the payloads remain in the input stream.
+     */
+    template <typename Payload>
+    class PayloadEdgeTopology {
+    protected:
+        EdgeStream _topology;
+
+        explicit PayloadEdgeTopology(BasicEdgeStream<Payload> &edges)
+            : _topology(false, false)
+        {
+            for (edges.rewind(); !edges.empty(); ++edges)
+                _topology.push(*edges);
+            _topology.consume();
+            edges.rewind();
+        }
+    };
+
+    /**
+     * Edge swaps of a graph whose edges carry a payload, e.g. weights: every edge
+     * keeps its payload, i.e. a swap of {a, b} and {c, d} passes the payload of
+     * {a, b} on to the new edge replacing it, as does EdgeSwapTFP with the edge id.
+     * Hence the multiset of payloads is maintained; node strengths are maintained by
+     * swaps of edges with equal payloads only.
+     *
+     * The swaps do not depend on the payloads, so the payloads are not part of the
+     * messages of EdgeSwapTFP: the engine reports the new state of every edge id
+     * touched by a run, and _apply_updates() merges it with the payloads into the
+     * updated edges at the cost of two scans of the edges and sort(run_length) I/Os.
+     * Use EdgeSwapTFP for edges without payload, which sends no such messages.
+     */
+    template <typename Payload>
+    class PayloadEdgeSwapTFP : private PayloadEdgeTopology<Payload>, public EdgeSwapTFP {
+        static_assert(!std::is_same<Payload, EmptyPayload>::value, "Use EdgeSwapTFP for edges without payload");
+
+    public:
+        using payload_edge_buffer_t = BasicEdgeStream<Payload>;
+
+    protected:
+        using PayloadEdgeSorter = stxxl::sorter<PayloadEdgeMsg<Payload>, typename PayloadEdgeMsg<Payload>::Ascending>;
+
+        payload_edge_buffer_t & _payload_edges;
+
+        void _apply_updates() override {
+            EdgeIdUpdateSorter & updates = *_edge_id_update_sorter;
+
+            // fetch the payloads of the updated edge ids and sort them by their new edges
+            PayloadEdgeSorter payload_updates(typename PayloadEdgeMsg<Payload>::Ascending(), _sorter_mem);
+            {
+                edgeid_t eid = 0;
+                for (_payload_edges.rewind(); !updates.empty(); ++updates) {
+                    for (; eid < updates->edge_id; ++eid, ++_payload_edges)
+                        assert(!_payload_edges.empty());
+
+                    payload_updates.push(PayloadEdgeMsg<Payload>(updates->edge, _payload_edges.payload()));
+                }
+            }
+            payload_updates.sort();
+            updates.rewind();
+
+            // merge the remaining edges with the updated ones, as EdgeVectorUpdateStream does
+            payload_edge_buffer_t updated_edges(false, false);
+            {
+                edgeid_t eid = 0;
+                for (_payload_edges.rewind(); !_payload_edges.empty(); ++_payload_edges, ++eid) {
+                    if (!updates.empty() && updates->edge_id == eid) {
+                        ++updates;
+                        continue;
+                    }
+
+                    for (; !payload_updates.empty() && payload_updates->edge < *_payload_edges; ++payload_updates)
+                        updated_edges.push(payload_updates->edge, payload_updates->payload);
+
+                    updated_edges.push(*_payload_edges, _payload_edges.payload());
+                }
+
+                for (; !payload_updates.empty(); ++payload_updates)
+                    updated_edges.push(payload_updates->edge, payload_updates->payload);
+            }
+            updated_edges.consume();
+
+            // release the reader before its sequence
+            _payload_edges.clear();
+            _payload_edges = std::move(updated_edges);
+        }
+
+    public:
+        PayloadEdgeSwapTFP() = delete;
+        PayloadEdgeSwapTFP(const PayloadEdgeSwapTFP &) = delete;
+
+        //! @param edges  Edges with payloads changed in-place; has to outlive the object
+        //! @param run_length  Swaps per scan of the edges or auto_run_length
+        //! @param num_nodes  Number of nodes, i.e. all ids are smaller
+        //! @param im_memory  Memory budget of the internal data structures
+        PayloadEdgeSwapTFP(payload_edge_buffer_t &edges, const swapid_t& run_length, const node_t& num_nodes, const size_t& im_memory) :
+            PayloadEdgeTopology<Payload>(edges),
+            EdgeSwapTFP(PayloadEdgeTopology<Payload>::_topology, run_length, num_nodes, im_memory),
+            _payload_edges(edges)
+        {
+            _enable_edge_id_tracking();
+        }
+
+        //! Executes all pushed swaps; edges holds the result afterwards
+        void run() {
+            EdgeSwapTFP::run();
+            _payload_edges.rewind();
+        }
+    };
+};
@@ -161,15 +161,12 @@ namespace EdgeSwapTFP {
     void SemiLoadedEdgeSwapTFP::_process_swaps() {
         constexpr bool show_stats = true;
 
-        using UpdateStream = EdgeVectorUpdateStream<EdgeStream, BoolStream, decltype(_edge_update_sorter), true>;
-
-        if (!_edge_swap_sorter->size()) {
+        // fully loaded swaps only have messages in the loaded sorter
+        if (!_edge_swap_sorter->size() && !_loaded_edge_swap_sorter->size()) {
             // there are no swaps - let's see whether there are pending updates
-            if ( _edge_update_sorter.size()) {
-                UpdateStream update_stream(_edges, _last_edge_update_mask, _edge_update_sorter);
-                update_stream.finish();
-                _edges.rewind();
-            }
+            _wait_for_edge_update_sorter();
+            if (_edge_update_sorter.size())
+                _update_and_scan_edges([] (auto &) {}, true);
 
             _edge_update_sorter.clear();
 
@@ -179,6 +176,11 @@ namespace EdgeSwapTFP {
             return;
         }
 
+        const uint64_t pq_spilled = _pq_spilled_elements();
+        _run_profile.beginRun("SemiLoadedEdgeSwapTFP", _runs_started - 1);
+        _run_profile.set("swaps", _processing_run_length);
+        _run_profile.beginPhase("dependency_chain");
+
         if (_first_run) {
             // first iteration
             _compute_dependency_chain_semi_loaded(_edges, _edge_update_mask);
@@ -186,52 +188,51 @@ namespace EdgeSwapTFP {
             _first_run = false;
 
         } else {
-            if (_edge_update_sorter_thread)
-                _edge_update_sorter_thread->join();
-
-            UpdateStream update_stream(_edges, _last_edge_update_mask, _edge_update_sorter);
-            _compute_dependency_chain_semi_loaded(update_stream, _edge_update_mask);
-            update_stream.finish();
-
-            _edge_update_sorter.clear();
-            _edges.rewind();
-
+            _update_and_scan_edges([&] (auto & update_stream) {
+                _compute_dependency_chain_semi_loaded(update_stream, _edge_update_mask);
+            });
         }
 
 #ifndef NDEBUG
         // test that input is lexicographically ordered and loop free
         {
-            edge_t last_edge = *_edges;
-            ++_edges;
+            edge_t last_edge = *_edge_log;
+            ++_edge_log;
             assert(!last_edge.is_loop());
-            for(;!_edges.empty();++_edges) {
-                auto & edge = *_edges;
+            for(;!_edge_log.empty();++_edge_log) {
+                auto & edge = *_edge_log;
                 assert(!edge.is_loop());
                 assert(last_edge < edge);
                 last_edge = edge;
             }
-            _edges.rewind();
+            _edge_log.rewind();
         }
 #endif
 
         std::swap(_edge_update_mask, _last_edge_update_mask);
 
         _report_stats("_compute_dependency_chain: ", show_stats);
+        _run_profile.beginPhase("simulate_swaps");
         _simulate_swaps();
         _report_stats("_simulate_swaps: ", show_stats);
+        _run_profile.beginPhase("load_existence");
         _load_existence();
         _report_stats("_load_existence: ", show_stats);
+        _run_profile.beginPhase("perform_swaps");
         _perform_swaps();
         _report_stats("_perform_swaps: ", show_stats);
 
+        _run_profile.set("pq_spilled", _pq_spilled_elements() - pq_spilled);
+        _tune_run_length();
+        _run_profile.endRun();
+
         _reset();
 
         // clear loaded edge swaps. the other sorter is cleared in _reset()
         _loaded_edge_swap_sorter->clear();
 
         if (_updated_edges_callback) {
-            if (_edge_update_sorter_thread && _edge_update_sorter_thread->joinable())
-                _edge_update_sorter_thread->join();
+            _wait_for_edge_update_sorter();
 
             _updated_edges_callback(_edge_update_sorter);
             _edge_update_sorter.rewind();
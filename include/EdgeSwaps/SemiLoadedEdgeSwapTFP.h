@@ -54,6 +54,16 @@ namespace EdgeSwapTFP {
                _start_processing();
         };
 
+        //! Both edges are matched by value, i.e. the swap skips the edge id resolution
+        void push(const LoadedSwapDescriptor &swap) {
+           _loaded_edge_swap_sorter->push(LoadedEdgeSwapMsg(swap.edges()[0], _next_swap_id_pushing++));
+           _loaded_edge_swap_sorter->push(LoadedEdgeSwapMsg(swap.edges()[1], _next_swap_id_pushing++));
+           _swap_directions_pushing.push(swap.direction());
+
+           if (UNLIKELY(_next_swap_id_pushing > 2*_run_length))
+               _start_processing();
+        };
+
         void setUpdatedEdgesCallback(updated_edges_callback_t callback) {
             _updated_edges_callback = callback;
         };
@@ -0,0 +1,234 @@
+#pragma once
+/**
+ * @file
+ * @brief  Online convergence monitor for edge swap randomization
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <defs.h>
+#include <EdgeStream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <stxxl/random>
+
+/**
+ * @brief Tracks cheap mixing statistics of an edge stream across swap runs
+ *
+ * The monitor is fed with all edges of the graph each time a swap engine
+ * rewrites its edge stream (see EdgeVectorUpdateStream), i.e. once per run.
+ * Two statistics are computed in a single pass with O(1) work per edge:
+ *
+ *  - The degree assortativity of the graph. As swaps preserve degrees, the
+ *    degree sequence is computed once in the constructor.
+ *  - The fraction of a random sample of the initial edges that is still
+ *    present. The sample is kept sorted, so it can be merged with the sorted
+ *    edge stream.
+ *
+ * Once both values changed by less than epsilon for window consecutive runs,
+ * converged() becomes true. The monitor does not print anything per run;
+ * EdgeSwapTFP records its statistics in the run profile (see setRunProfile()). Since the engines process runs asynchronously,
+ * converged() may be polled from the thread pushing swaps; converged_within()
+ * allows decisions that do not depend on the timing of the processing.
+ */
+class SwapConvergenceMonitor {
+public:
+    struct Parameters {
+        unsigned int window = 3; ///< Number of consecutive flat runs before stopping
+        double epsilon = 1e-3; ///< Max. absolute change of each statistic to count a run as flat
+        edgeid_t sample_size = 1 << 16; ///< Expected number of initial edges tracked
+        seed_t seed = 0; ///< Seed used for sampling initial edges; 0 selects stxxl::get_next_seed()
+
+        // user-provided, as GCC rejects the implicit one in the default argument below
+        Parameters() {}
+    };
+
+protected:
+    const Parameters _params;
+
+    std::vector<degree_t> _degrees;
+    std::vector<edge_t> _sample;
+
+    // accumulators of the current run
+    edgeid_t _run_edges;
+    edgeid_t _run_sample_hits;
+    std::vector<edge_t>::const_iterator _sample_it;
+    double _sum_product;
+    double _sum_mean;
+    double _sum_squares;
+
+    // history
+    std::atomic<uint_t> _runs;
+    unsigned int _flat_runs;
+    double _last_assortativity;
+    double _last_untouched;
+    std::atomic<uint_t> _converged_run; ///< number of runs after which convergence was reached; 0 if not converged
+
+public:
+    //! Scans the edge stream once to compute the degree sequence and to
+    //! sample the initial edges. The stream is rewound afterwards.
+    SwapConvergenceMonitor(EdgeStream & edges, const node_t num_nodes, const Parameters & params = Parameters())
+        : _params(params)
+        , _degrees(num_nodes, 0)
+        , _run_edges(0)
+        , _run_sample_hits(0)
+        , _sum_product(0), _sum_mean(0), _sum_squares(0)
+        , _runs(0)
+        , _flat_runs(0)
+        , _last_assortativity(0)
+        , _last_untouched(1.0)
+        , _converged_run(0)
+    {
+        STDRandomEngine gen(params.seed ? params.seed : stxxl::get_next_seed());
+        std::bernoulli_distribution take_sample(
+            std::min(1.0, static_cast<double>(params.sample_size) / std::max<external_size_t>(1, edges.size())));
+
+        edges.rewind();
+        for (; !edges.empty(); ++edges) {
+            const edge_t & e = *edges;
+            assert(e.first < num_nodes && e.second < num_nodes);
+
+            ++_degrees[e.first];
+            ++_degrees[e.second];
+
+            if (take_sample(gen))
+                _sample.push_back(e);
+        }
+        edges.rewind();
+
+        begin_run();
+        _last_assortativity = _compute_assortativity(_initial_statistics(edges));
+    }
+
+    SwapConvergenceMonitor(const SwapConvergenceMonitor &) = delete;
+
+    //! Resets the accumulators; call before the first edge of a run is observed
+    void begin_run() {
+        _run_edges = 0;
+        _run_sample_hits = 0;
+        _sample_it = _sample.cbegin();
+        _sum_product = 0;
+        _sum_mean = 0;
+        _sum_squares = 0;
+    }
+
+    //! Has to be called for every edge of the graph in ascending order
+    void observe(const edge_t & e) {
+        const double du = _degrees[e.first];
+        const double dv = _degrees[e.second];
+
+        _sum_product += du * dv;
+        _sum_mean += 0.5 * (du + dv);
+        _sum_squares += 0.5 * (du * du + dv * dv);
+        ++_run_edges;
+
+        while (_sample_it != _sample.cend() && *_sample_it < e)
+            ++_sample_it;
+
+        if (_sample_it != _sample.cend() && *_sample_it == e) {
+            ++_run_sample_hits;
+            ++_sample_it;
+        }
+    }
+
+    //! Evaluates the statistics of the run and updates converged()
+    void end_run() {
+        const double assortativity = _compute_assortativity(_run_edges);
+        const double untouched = _sample.empty() ? 0.0 : static_cast<double>(_run_sample_hits) / _sample.size();
+
+        const bool flat = std::abs(assortativity - _last_assortativity) < _params.epsilon
+                       && std::abs(untouched - _last_untouched) < _params.epsilon;
+
+        _flat_runs = flat ? (_flat_runs + 1) : 0;
+        const uint_t runs = _runs.load(std::memory_order_relaxed) + 1;
+
+        _last_assortativity = assortativity;
+        _last_untouched = untouched;
+
+        if (_flat_runs >= _params.window && !_converged_run.load(std::memory_order_relaxed))
+            _converged_run.store(runs, std::memory_order_release);
+
+        _runs.store(runs, std::memory_order_release);
+    }
+
+    //! True once the statistics flattened out; swap producers should stop
+    bool converged() const {
+        return _converged_run.load(std::memory_order_acquire) != 0;
+    }
+
+    //! True if the statistics flattened out within the first runs observed runs
+    bool converged_within(uint_t runs) const {
+        const uint_t converged_run = _converged_run.load(std::memory_order_acquire);
+        return converged_run && converged_run <= runs;
+    }
+
+    //! Number of runs observed so far
+    uint_t runs() const {return _runs.load(std::memory_order_acquire);}
+
+    double assortativity() const {return _last_assortativity;}
+    double untouched_fraction() const {return _last_untouched;}
+
+    //! Number of consecutive flat runs observed last; converges at Parameters::window
+    unsigned int flat_runs() const {return _flat_runs;}
+
+protected:
+    edgeid_t _initial_statistics(EdgeStream & edges) {
+        for (; !edges.empty(); ++edges)
+            observe(*edges);
+        edges.rewind();
+        return _run_edges;
+    }
+
+    double _compute_assortativity(edgeid_t m) const {
+        if (!m) return 0.0;
+
+        const double mean = _sum_mean / m;
+        const double denom = _sum_squares / m - mean * mean;
+        if (denom <= 0.0) return 0.0; // regular graph; assortativity is undefined
+
+        return (_sum_product / m - mean * mean) / denom;
+    }
+};
+
+/**
+ * Pushes swaps from a stream into a swap algorithm until either the stream is
+ * exhausted or the monitor (if not nullptr) reports convergence. Returns the
+ * number of swaps pushed.
+ *
+ * The decision is only taken at run boundaries (see SwapAlgo::runsStarted()):
+ * The result of run j is observed while run j+1 is processed, and before the
+ * first swap of run j is pushed the engine finished processing run j-2. Thus
+ * the first j-2 observations are available, and stopping only if the monitor
+ * converged within them makes the number of swaps independent of the timing of
+ * the asynchronous processing. Up to three runs more than necessary are pushed.
+ */
+template <class SwapStream, class SwapAlgo>
+uint_t pushSwapsUntilConverged(SwapStream & swaps, SwapAlgo & algo, const SwapConvergenceMonitor * monitor) {
+    uint_t pushed = 0;
+    uint_t checked_run = algo.runsStarted();
+    bool stopped = false;
+
+    for (; !swaps.empty(); ++swaps, ++pushed) {
+        const uint_t run = algo.runsStarted();
+        if (monitor && run != checked_run) {
+            checked_run = run;
+            if (run >= 2 && monitor->converged_within(run - 2)) {
+                stopped = true;
+                break;
+            }
+        }
+
+        algo.push(*swaps);
+    }
+
+    if (stopped)
+        std::cout << "SwapConvergenceMonitor stopped randomization after " << pushed << " swaps" << std::endl;
+
+    return pushed;
+}
@@ -0,0 +1,244 @@
+#pragma once
+/**
+ * @file
+ * @brief  Executes the swaps of a batch in dependency order on a fixed set of threads
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <Utils/WorkStealingDeque.h>
+
+/**
+ * @brief Continuation-passing scheduler for the swaps of a batch of EdgeSwapParallelTFP
+ *
+ * Swap i of a batch is owned by thread i % num_threads, which visits its swaps in
+ * order. A swap may only run once all its inputs (edge states and existence
+ * information sent by earlier swaps of the batch) are published. Instead of
+ * waiting for them, the owner parks the swap and continues with its next one;
+ * the thread publishing the last missing input calls resolve() which pushes the
+ * swap onto its own work-stealing deque. Idle threads steal from the deques of
+ * the others; if there is nothing to steal for a while, they sleep until a swap
+ * is made ready or the last swap of the batch is executed.
+ *
+ * Each swap has a counter of unresolved inputs plus one for the visit of its
+ * owner; whoever decrements it to zero schedules the swap, so the swap runs
+ * exactly once and after all inputs are visible (acquire-release).
+ *
+ * Usage per batch: startBatch() in a single thread, setDependencies() by the
+ * owners of the swaps, a barrier, and run() in every thread.
+ */
+class SwapDependencyScheduler {
+public:
+    using task_t = uint32_t;
+
+protected:
+    struct Worker {
+        WorkStealingDeque<task_t> deque;
+        std::vector<task_t> overflow; ///< ready swaps not fitting into the deque; not stealable
+        std::minstd_rand rng;
+
+        uint64_t parked;
+        uint64_t stolen;
+        uint64_t slept;
+
+        Worker(int64_t capacity, unsigned int seed)
+            : deque(capacity), rng(seed), parked(0), stolen(0), slept(0)
+        {}
+    };
+
+    //! Failed steal attempts of an idle thread before it sleeps
+    static constexpr unsigned int _idle_spins = 64;
+
+    const int _num_threads;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::unique_ptr<std::atomic<uint32_t>[]> _pending;
+    const task_t _max_tasks;
+    task_t _num_tasks;
+    std::atomic<task_t> _remaining; ///< swaps of the batch not executed yet
+
+    // idle threads
+    std::mutex _idle_mutex;
+    std::condition_variable _idle_cv;
+    std::atomic<int> _sleeping;
+    uint64_t _wakeups; ///< protected by _idle_mutex
+
+    void _wake_all() {
+        {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _wakeups++;
+        }
+        _idle_cv.notify_all();
+    }
+
+    bool _pop_local(Worker & w, task_t & task) {
+        if (w.deque.pop(task))
+            return true;
+
+        if (!w.overflow.empty()) {
+            task = w.overflow.back();
+            w.overflow.pop_back();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool _steal(int tid, task_t & task) {
+        if (_num_threads < 2)
+            return false;
+
+        Worker & w = *_workers[tid];
+        const int first = std::uniform_int_distribution<int>(0, _num_threads - 2)(w.rng);
+        for (int i = 0; i < _num_threads - 1; ++i) {
+            const int victim = (tid + 1 + (first + i) % (_num_threads - 1)) % _num_threads;
+            if (_workers[victim]->deque.steal(task)) {
+                w.stolen++;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename Execute>
+    void _execute(int tid, task_t task, Execute & execute) {
+        execute(tid, task);
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            _wake_all();
+    }
+
+    //! Sleeps until a swap is made ready or the batch is done
+    void _sleep(Worker & w) {
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        const uint64_t wakeups = _wakeups;
+        _sleeping++;
+        w.slept++;
+        _idle_cv.wait(lock, [&] {return _wakeups != wakeups || !_remaining.load(std::memory_order_acquire);});
+        _sleeping--;
+    }
+
+public:
+    //! @param max_tasks  Maximum number of swaps per batch
+    //! @param deque_capacity  Ready swaps a thread can offer to thieves
+    SwapDependencyScheduler(int num_threads, task_t max_tasks, int64_t deque_capacity = 1 << 16)
+        : _num_threads(num_threads)
+        , _pending(new std::atomic<uint32_t>[max_tasks])
+        , _max_tasks(max_tasks)
+        , _num_tasks(0)
+        , _remaining(0)
+        , _sleeping(0)
+        , _wakeups(0)
+    {
+        for (int i = 0; i < num_threads; ++i)
+            _workers.emplace_back(new Worker(deque_capacity, i + 1));
+    }
+
+    SwapDependencyScheduler(const SwapDependencyScheduler &) = delete;
+
+    //! Single-threaded; tasks are numbered 0 .. num_tasks-1 and task i is owned by thread i % num_threads
+    void startBatch(task_t num_tasks) {
+        assert(num_tasks <= _max_tasks);
+        _num_tasks = num_tasks;
+        _remaining.store(num_tasks, std::memory_order_relaxed);
+#ifndef NDEBUG
+        for (const auto & w : _workers)
+            assert(!w->deque.size() && w->overflow.empty());
+#endif
+    }
+
+    //! Called by the owner of task before the barrier preceding run()
+    void setDependencies(task_t task, uint32_t unresolved_inputs) {
+        assert(task < _num_tasks);
+        _pending[task].store(unresolved_inputs + 1, std::memory_order_relaxed);
+    }
+
+    //! Publishes one input of task; called by the executing thread tid after writing the input
+    void resolve(int tid, task_t task) {
+        assert(task < _num_tasks);
+        if (_pending[task].fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        Worker & w = *_workers[tid];
+        if (!w.deque.push(task)) {
+            w.overflow.push_back(task);
+            return;
+        }
+
+        // a missed sleeper only delays the swap, which we execute ourselves otherwise
+        if (_sleeping.load(std::memory_order_relaxed))
+            _wake_all();
+    }
+
+    /**
+     * Executes swaps until all swaps of the batch are done; execute(tid, task) is
+     * always called by the calling thread tid and may call resolve(tid, ...) for
+     * later tasks.
+     */
+    template <typename Execute>
+    void run(int tid, Execute && execute) {
+        Worker & w = *_workers[tid];
+        task_t task;
+
+        for (task_t own = tid; own < _num_tasks; own += _num_threads) {
+            if (_pending[own].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _execute(tid, own, execute);
+            } else {
+                w.parked++;
+            }
+
+            // continuations made ready by us are cache-warm; run them first
+            while (_pop_local(w, task))
+                _execute(tid, task, execute);
+        }
+
+        unsigned int idle = 0;
+        while (_remaining.load(std::memory_order_acquire)) {
+            if (_pop_local(w, task) || _steal(tid, task)) {
+                _execute(tid, task, execute);
+                idle = 0;
+            } else if (++idle < _idle_spins) {
+                std::this_thread::yield();
+            } else {
+                _sleep(w);
+                idle = 0;
+            }
+        }
+    }
+
+//! @name Statistics accumulated over all batches
+//! @{
+    //! Swaps whose inputs were missing when their owner visited them
+    uint64_t parkedTasks() const {
+        uint64_t result = 0;
+        for (const auto & w : _workers)
+            result += w->parked;
+        return result;
+    }
+
+    //! Swaps executed by a thread other than the one making them ready
+    uint64_t stolenTasks() const {
+        uint64_t result = 0;
+        for (const auto & w : _workers)
+            result += w->stolen;
+        return result;
+    }
+
+    //! Times an idle thread went to sleep instead of polling the others
+    uint64_t idleSleeps() const {
+        uint64_t result = 0;
+        for (const auto & w : _workers)
+            result += w->slept;
+        return result;
+    }
+//! @}
+};
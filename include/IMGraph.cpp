@@ -1,48 +1,66 @@
 #include <IMGraph.h>
 #include <tuple>
+#include <numeric>
+#include <memory>
 #include <cassert>
 
-IMGraph::IMGraph(const std::vector<degree_t> &degreeSequence) {
+constexpr IMGraph::node_ref IMGraph::_direct_ref;
+constexpr degree_t IMGraph::_hub_min_degree;
+constexpr uint64_t IMGraph::_hub_line;
+constexpr uint32_t IMGraph::_hub_empty;
+
+IMGraph::IMGraph(const std::vector<degree_t> &degreeSequence, seed_t seed) : _random_integer(seed) {
 #ifndef NDEBUG
     if (!std::is_sorted(degreeSequence.begin(), degreeSequence.end(), std::greater<degree_t>())) {
         STXXL_MSG("WARNING: degree sequence is not sorted in descending order, performance of IMGraph will be degraded!");
     }
 #endif
 
-    // we store the first H (inspired by the H-index, but a bit different) edges in an adjacency matrix
-    // we choose H such that the entries in the adjacency array would need as much memory as the adjacency matrix needs
-    // note that each entry in the adjacency array needs 64 bits while an entry in the adjacency matrix needs only 1 bit
-    int_t sum = 0;
-    _h = degreeSequence.size();
-    bool has_h = false;
-    for (size_t i = 0; i < degreeSequence.size(); ++i) {
-        // TODO adjust factor if less memory shall be consumed
-        if (!has_h && (sum + degreeSequence[i]) * 32 < static_cast<node_t>((i+1)*(i+1))) {
-            has_h = true;
-            _h = i;
-            _first_head.reserve(degreeSequence.size() + 1 - _h);
-            _last_head.reserve(degreeSequence.size() + 1 - _h);
-            sum = 0;
-        }
+    // the first H nodes of high degree (hubs) keep their neighbors in a hash set instead of an adjacency array,
+    // so checking for an edge of a hub does not scan its neighbors
+    _h = 0;
+    while (static_cast<size_t>(_h) < degreeSequence.size() && degreeSequence[_h] >= _hub_min_degree) {
+        ++_h;
+    }
 
-        if (has_h) {
-            _first_head.push_back(sum);
-            _last_head.push_back(sum);
-        }
+    uint64_t hub_entries = 0;
+    _hub_begin.reserve(_h + 1);
+    for (node_t u = 0; u < _h; ++u) {
+        _hub_begin.push_back(hub_entries);
+        hub_entries += _hub_capacity(degreeSequence[u]);
+    }
+    _hub_begin.push_back(hub_entries);
+
+    _hub_storage.assign(hub_entries + _hub_line, _hub_empty);
+    {
+        void * aligned = _hub_storage.data();
+        size_t space = _hub_storage.size() * sizeof(uint32_t);
+        std::align(_hub_line * sizeof(uint32_t), hub_entries * sizeof(uint32_t), aligned, space);
+        _hub_offset = static_cast<uint32_t*>(aligned) - _hub_storage.data();
+    }
+
+    int_t sum = 0;
+    _first_head.reserve(degreeSequence.size() + 1 - _h);
+    _last_head.reserve(degreeSequence.size() + 1 - _h);
+    for (size_t i = _h; i < degreeSequence.size(); ++i) {
+        _first_head.push_back(sum);
+        _last_head.push_back(sum);
         sum += degreeSequence[i];
     }
 
-    if (UNLIKELY(sum >= IMGraph::maxEdges())) {
+    if (UNLIKELY(sum >= IMGraph::maxEdges() || degreeSequence.size() >= _direct_ref)) {
         throw std::runtime_error("Error, too many edges for internal graph. The internal graph supports at maximum 2 billion edges");
     }
 
-    STXXL_MSG("Putting first " << _h << " of in total " << degreeSequence.size() << " nodes in adjacency matrix");
+    STXXL_MSG("Putting first " << _h << " of in total " << degreeSequence.size() << " nodes in hash sets");
     _first_head.push_back(sum);
     _last_head.push_back(sum);
     _head.resize(sum);
+
+    // addEdge must not grow the index beyond the estimate of memoryUsage
+    _edge_index.reserve(std::accumulate(degreeSequence.begin(), degreeSequence.end(), uint64_t(0)) / 2);
     assert(_first_head.size() == degreeSequence.size() + 1 - _h);
     assert(_last_head.size() == degreeSequence.size() + 1 - _h);
-    _adjacency_matrix.resize(_h * _h);
 };
 
 SwapResult IMGraph::swapEdges(const edgeid_t eid0, const edgeid_t eid1, bool direction) {
@@ -84,42 +102,21 @@ SwapResult IMGraph::swapEdges(const edgeid_t eid0, const edgeid_t eid1, bool dir
         std::swap(idx0.second, idx1.second);
         std::swap(t[0].first, t[1].first);
 
-        // update adjacency matrix
+        // update hash sets of the hubs; remove first as a new edge may reuse a slot
         for (unsigned char pos = 0; pos < 2; ++pos) {
-            if (e[pos].first < _h && e[pos].second < _h) {
-                _adjacency_matrix[e[pos].first * _h + e[pos].second] = false;
-                _adjacency_matrix[e[pos].second * _h + e[pos].first] = false;
-            }
-            if (t[pos].first < _h && t[pos].second < _h) {
-                _adjacency_matrix[t[pos].first * _h + t[pos].second] = true;
-                _adjacency_matrix[t[pos].second * _h + t[pos].first] = true;
-            }
+            if (e[pos].first < _h) _hub_erase(e[pos].first, e[pos].second);
+            if (e[pos].second < _h) _hub_erase(e[pos].second, e[pos].first);
         }
-
-        // update adjacency array or index
-        if (!idx0.first.index_is_node) {
-            _head[idx0.first.index] = t[0].first;
-        } else {
-            idx0.first.index = t[0].first;
-        }
-
-        if (!idx0.second.index_is_node) {
-            _head[idx0.second.index] = t[0].second;
-        } else {
-            idx0.second.index = t[0].second;
-        }
-
-        if (!idx1.first.index_is_node) {
-            _head[idx1.first.index] = t[1].first;
-        } else {
-            idx1.first.index = t[1].first;
+        for (unsigned char pos = 0; pos < 2; ++pos) {
+            if (t[pos].first < _h) _hub_insert(t[pos].first, t[pos].second);
+            if (t[pos].second < _h) _hub_insert(t[pos].second, t[pos].first);
         }
 
-        if (!idx1.second.index_is_node) {
-            _head[idx1.second.index] = t[1].second;
-        } else {
-            idx1.second.index = t[1].second;
-        }
+        // update adjacency array or index
+        _assign(idx0.first, t[0].first);
+        _assign(idx0.second, t[0].second);
+        _assign(idx1.first, t[1].first);
+        _assign(idx1.second, t[1].second);
 
         // normalize direction of edges in the index
         if (t[0].first > t[0].second) {
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <cassert>
+#include <limits>
 #include <defs.h>
 #include <parallel/algorithm>
 #include <stxxl/random>
@@ -38,22 +39,118 @@ private:
         };
 
     };
-    struct node_ref {
-        bool index_is_node;
-        uint32_t index;
-    }; // FIXME this needs 64 bits, i.e. a pair of these needs 128 bits!
+    /**
+     * Reference to an endpoint of an edge in 32 bits: either the position in the adjacency
+     * array of the other endpoint where the node is stored, or, if the other endpoint is a
+     * hub and thus has no adjacency array, the node itself marked by _direct_ref.
+     */
+    using node_ref = uint32_t;
+    static constexpr node_ref _direct_ref = node_ref(1) << 31;
+
+    //! Hubs with at least this degree are the first _h nodes; they keep their neighbors in a hash set
+    static constexpr degree_t _hub_min_degree = 64;
+    //! Entries of a cache line; each hash set starts at and fills whole cache lines
+    static constexpr uint64_t _hub_line = 64 / sizeof(uint32_t);
+    static constexpr uint32_t _hub_empty = std::numeric_limits<uint32_t>::max();
+
     node_t _h;
     std::vector<uint32_t> _head;
     std::vector<uint32_t> _first_head;
     std::vector<uint32_t> _last_head;
     std::vector<std::pair<node_ref, node_ref>> _edge_index;
-    std::vector<bool> _adjacency_matrix;
+
+    // open addressing hash sets (linear probing) of the neighbors of the hubs
+    std::vector<uint32_t> _hub_storage;
+    std::vector<uint64_t> _hub_begin; ///< offsets of the sets relative to _hub_offset
+    size_t _hub_offset; ///< first cache line aligned entry of _hub_storage
+
     stxxl::random_number64 _random_integer;
+
+    node_t _resolve(node_ref ref) const {
+        return (ref & _direct_ref) ? static_cast<node_t>(ref & ~_direct_ref) : static_cast<node_t>(_head[ref]);
+    }
+
+    void _assign(node_ref & ref, node_t u) {
+        if (ref & _direct_ref) {
+            ref = static_cast<node_ref>(u) | _direct_ref;
+        } else {
+            _head[ref] = u;
+        }
+    }
+
+    uint32_t * _hub_set(node_t u, uint64_t & capacity) {
+        capacity = _hub_begin[u+1] - _hub_begin[u];
+        return _hub_storage.data() + _hub_offset + _hub_begin[u];
+    }
+
+    const uint32_t * _hub_set(node_t u, uint64_t & capacity) const {
+        capacity = _hub_begin[u+1] - _hub_begin[u];
+        return _hub_storage.data() + _hub_offset + _hub_begin[u];
+    }
+
+    //! Entries of the hash set of a hub; filled to at most 80% and rounded up to whole cache lines
+    static uint64_t _hub_capacity(degree_t degree) {
+        const uint64_t entries = degree + degree / 4 + 1;
+        return (entries + _hub_line - 1) / _hub_line * _hub_line;
+    }
+
+    //! Home slot of v in a hash set with the given capacity
+    static uint64_t _hub_home(node_t v, uint64_t capacity) {
+        const uint32_t hash = static_cast<uint32_t>(v) * 0x9E3779B1u;
+        return (static_cast<uint64_t>(hash) * capacity) >> 32;
+    }
+
+    bool _hub_contains(node_t u, node_t v) const {
+        uint64_t capacity;
+        const uint32_t * set = _hub_set(u, capacity);
+        for (uint64_t i = _hub_home(v, capacity); ; i = (i + 1 == capacity) ? 0 : i + 1) {
+            if (set[i] == static_cast<uint32_t>(v)) return true;
+            if (set[i] == _hub_empty) return false;
+        }
+    }
+
+    void _hub_insert(node_t u, node_t v) {
+        uint64_t capacity;
+        uint32_t * set = _hub_set(u, capacity);
+        uint64_t i = _hub_home(v, capacity);
+        while (set[i] != _hub_empty) {
+            assert(set[i] != static_cast<uint32_t>(v));
+            i = (i + 1 == capacity) ? 0 : i + 1;
+        }
+        set[i] = v;
+    }
+
+    //! Removes v by shifting back the entries of its probe sequence (no tombstones)
+    void _hub_erase(node_t u, node_t v) {
+        uint64_t capacity;
+        uint32_t * set = _hub_set(u, capacity);
+        uint64_t i = _hub_home(v, capacity);
+        while (set[i] != static_cast<uint32_t>(v)) {
+            assert(set[i] != _hub_empty);
+            i = (i + 1 == capacity) ? 0 : i + 1;
+        }
+
+        for (uint64_t j = i; ; ) {
+            j = (j + 1 == capacity) ? 0 : j + 1;
+            if (set[j] == _hub_empty)
+                break;
+
+            // entry j may stay if its home lies cyclically in (i, j]
+            const uint64_t home = _hub_home(set[j], capacity);
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+                continue;
+
+            set[i] = set[j];
+            i = j;
+        }
+        set[i] = _hub_empty;
+    }
+
 public:
     /**
      * Constructs a new internal memory graph.
      */
-    IMGraph(const std::vector<degree_t> &degreeSequence);
+    IMGraph(const std::vector<degree_t> &degreeSequence, seed_t seed = stxxl::get_next_seed());
 
     /**
      * Adds a new edge to the graph.
@@ -63,24 +160,24 @@ public:
      * @param e The edge to add
      */
     void addEdge(const edge_t &e) {
-        std::pair<node_ref, node_ref> idx = {{true, static_cast<uint32_t>(e.first)}, {true, static_cast<uint32_t>(e.second)}};
+        std::pair<node_ref, node_ref> idx = {static_cast<node_ref>(e.first) | _direct_ref, static_cast<node_ref>(e.second) | _direct_ref};
         if (e.first >= _h) {
             node_t i = e.first - _h;
             assert(_last_head[i] < _first_head[i+1]);
             _head[_last_head[i]] = e.second;
-            idx.second = {false, _last_head[i]}; // warning: roles swapped
+            idx.second = _last_head[i]; // warning: roles swapped
             ++_last_head[i];
+        } else {
+            _hub_insert(e.first, e.second);
         }
         if (e.second >= _h) {
             node_t j = e.second - _h;
             assert(_last_head[j] < _first_head[j+1]);
             _head[_last_head[j]] = e.first;
-            idx.first = {false, _last_head[j]}; // warning: roles swapped
+            idx.first = _last_head[j]; // warning: roles swapped
             ++_last_head[j];
-        }
-        if (e.first < _h && e.second < _h) {
-            _adjacency_matrix[e.first*_h + e.second] = true;
-            _adjacency_matrix[e.second*_h + e.first] = true;
+        } else {
+            _hub_insert(e.second, e.first);
         }
         _edge_index.push_back(idx);
 
@@ -104,17 +201,7 @@ public:
      */
     edge_t getEdge(edgeid_t eid) const {
         auto &idx = _edge_index[eid];
-        edge_t result= {static_cast<node_t>(idx.first.index), static_cast<node_t>(idx.second.index)};
-
-        if (!idx.first.index_is_node) {
-            result.first = _head[result.first];
-        }
-
-        if (!idx.second.index_is_node) {
-            result.second = _head[result.second];
-        }
-
-        return result;
+        return {_resolve(idx.first), _resolve(idx.second)};
     }
 
 protected:
@@ -134,26 +221,58 @@ public:
         return std::numeric_limits< uint32_t >::max()/2;
     }
 
+    /**
+     * Upper bound of the memory of a graph with any degree sequence of the given size.
+     *
+     * Every edge needs two node refs and, per endpoint, a node id in the adjacency array
+     * or an entry of a hub's hash set. A hash set of degree d has at most 1.25d + 16 entries,
+     * i.e. with _hub_min_degree at most 1.5 entries per neighbor. Nodes need two indices
+     * (+ 1 for end marker), hubs an offset, plus a cache line for the alignment of the sets.
+     */
     static uint_t memoryUsage(uint_t numNodes, uint_t numEdges) {
-        // we need two node refs per edge + 2 node ids per edge + 2 indices per node (+ 1 for end marker) and the size of the object itself
-        return (sizeof(node_ref) * 2  + sizeof(uint32_t) * 2) * numEdges + 2 * sizeof(uint32_t) * (numNodes + 1) + sizeof(IMGraph);
+        const uint_t max_hubs = 2 * numEdges / _hub_min_degree;
+        return (sizeof(node_ref) * 2 + sizeof(uint32_t) * 3) * numEdges
+             + 2 * sizeof(uint32_t) * (numNodes + 1) + sizeof(uint64_t) * (max_hubs + 1)
+             + 64 + sizeof(IMGraph);
+    }
+
+    //! Memory of the graph of the degree sequence as allocated by the constructor and addEdge
+    static uint_t memoryUsage(const std::vector<degree_t> &degreeSequence) {
+        // the hubs are the leading nodes of high degree, see the constructor
+        size_t h = 0;
+        uint_t hub_entries = 0;
+        while (h < degreeSequence.size() && degreeSequence[h] >= _hub_min_degree)
+            hub_entries += _hub_capacity(degreeSequence[h++]);
+
+        uint_t degree_sum = 0;
+        uint_t head_entries = 0;
+        for (size_t i = 0; i < degreeSequence.size(); ++i) {
+            degree_sum += degreeSequence[i];
+            if (i >= h) head_entries += degreeSequence[i];
+        }
+
+        return sizeof(node_ref) * degree_sum
+             + sizeof(uint32_t) * (head_entries + hub_entries + _hub_line)
+             + 2 * sizeof(uint32_t) * (degreeSequence.size() - h + 1)
+             + sizeof(uint64_t) * (h + 1) + sizeof(IMGraph);
     }
 
     /**
      * Checks if the given edge exists.
      *
-     * Running time is linear in the size of the smaller degree of the two nodes.
+     * Running time is constant in expectation if one of the nodes is a hub, otherwise
+     * linear in the size of the smaller degree of the two nodes.
      *
      * @param u The source node
      * @param v The target node
      * @return If the edge exists
      */
      bool hasEdge(node_t u, node_t v) const {
-        if (u < _h && v < _h) return _adjacency_matrix[u*_h + v];
+        if (u < _h) return _hub_contains(u, v);
+        if (v < _h) return _hub_contains(v, u);
 
-        if (u < _h) std::swap(u, v);
-        // now u is definitely >= _h, but v could be < _h
-        if (v >= _h && degree(u) > degree(v)) std::swap(u, v);
+        // now both nodes are >= _h
+        if (degree(u) > degree(v)) std::swap(u, v);
 
         for (edgeid_t i = _first_head[u-_h]; i < _last_head[u-_h]; ++i) {
             if (UNLIKELY(static_cast<node_t>(_head[i]) == v)) {
@@ -172,9 +291,21 @@ public:
         return _edge_index.size();
     }
 
+    /**
+     * Get the number of nodes the graph has, i.e. the length of the degree sequence.
+     *
+     * @return The number of nodes.
+     */
+    node_t numNodes() const {
+        return _h + static_cast<node_t>(_first_head.size()) - 1;
+    }
+
     /**
      * Swap the two edges that are identified by the given edge ids.
      *
+     * Swaps may be executed by several threads at the same time as long as they
+     * neither share an edge id nor one of the four nodes involved.
+     *
      * @param eid0 The id of the first swap candidate
      * @param eid1 The id of the second swap candidate
      * @return If the swap was successfull, i.e. did not create any conflict.
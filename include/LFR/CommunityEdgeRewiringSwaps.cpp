@@ -3,7 +3,7 @@
 #include <Utils/RandomBoolStream.h>
 
 void CommunityEdgeRewiringSwaps::run() {
-    while (true) {
+    for (uint_t round = 0; true; ++round) {
         // generate vector of struct { community, duplicate edge, partner edge }.
         std::vector<community_swap_edges_t> com_swap_edges;
 
@@ -15,7 +15,8 @@ void CommunityEdgeRewiringSwaps::run() {
             ++_community_sizes[c];
         };
 
-        std::mt19937 gen(stxxl::get_next_seed());
+        // streams 0 to 2 of each round are used sequentially, stream 3 + com for community com
+        std::mt19937 gen(_seeds(round, 0));
 
         { // first pass: load at most max_swaps duplicate edges duplicate edge in com_swap_edges
             edge_community_t last_edge = {0, {-1, -1}};
@@ -109,17 +110,11 @@ void CommunityEdgeRewiringSwaps::run() {
 
         // sort swap partners per community in decreasing order
         // and shuffle swaps of same community.
-        #pragma omp parallel
-        {
-
-            std::random_device lrd;
-            std::minstd_rand fast_gen(lrd());
-
-            #pragma omp for schedule(guided)
-            for (community_t com = 0; com < numCommunities; ++com) {
-                std::sort(swap_partner_id_per_community.begin() + duplicates_per_community[com], swap_partner_id_per_community.begin() + duplicates_per_community[com+1], std::greater<edgeid_t>());
-                std::shuffle(com_swap_edges.begin() + duplicates_per_community[com], com_swap_edges.begin() + duplicates_per_community[com+1], fast_gen);
-            }
+        #pragma omp parallel for schedule(guided)
+        for (community_t com = 0; com < numCommunities; ++com) {
+            std::minstd_rand fast_gen(_seeds(round, 3 + com));
+            std::sort(swap_partner_id_per_community.begin() + duplicates_per_community[com], swap_partner_id_per_community.begin() + duplicates_per_community[com+1], std::greater<edgeid_t>());
+            std::shuffle(com_swap_edges.begin() + duplicates_per_community[com], com_swap_edges.begin() + duplicates_per_community[com+1], fast_gen);
         }
 
         {
@@ -144,13 +139,14 @@ void CommunityEdgeRewiringSwaps::run() {
 
 
         // Shuffle all swaps.
-        std::minstd_rand fast_gen(stxxl::get_next_seed());
+        std::minstd_rand fast_gen(_seeds(round, 1));
         std::shuffle(com_swap_edges.begin(), com_swap_edges.end(), fast_gen);
 
         // generate vector of real swaps with internal ids and internal edge vector.
         _current_swaps.clear();
         _current_swaps.reserve(com_swap_edges.size());
-        RandomBoolStream _bool_stream;
+        stxxl::random_number64 bool_gen(_seeds(round, 2));
+        RandomBoolStream _bool_stream(bool_gen);
         _edges_in_current_swaps.clear();
         _edges_in_current_swaps.reserve(com_swap_edges.size() * 2);
         _swap_has_successor[0].clear();
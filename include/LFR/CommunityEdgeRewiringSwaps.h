@@ -7,6 +7,8 @@
 #include <cassert>
 #include <Swaps.h>
 #include <EdgeSwaps/EdgeSwapInternalSwapsBase.h>
+#include <Utils/RandomSeeds.h>
+#include <stxxl/random>
 #include <array>
 
 #ifndef SEQPAR
@@ -24,6 +26,7 @@ private:
     using edge_community_vector_t = stxxl::vector<edge_community_t>;
     edge_community_vector_t &_community_edges;
     size_t _max_swaps;
+    RandomSeeds _seeds; ///< stream i is used in rewiring round i
 
     struct community_swap_edges_t {
         community_t community_id;
@@ -88,7 +91,7 @@ private:
         };
     };
 public:
-    CommunityEdgeRewiringSwaps(stxxl::vector<edge_community_t> &intra_edges, size_t max_swaps) : _community_edges(intra_edges), _max_swaps(max_swaps) {};
+    CommunityEdgeRewiringSwaps(stxxl::vector<edge_community_t> &intra_edges, size_t max_swaps, seed_t seed = stxxl::get_next_seed()) : _community_edges(intra_edges), _max_swaps(max_swaps), _seeds(seed) {};
 
     void run();
 
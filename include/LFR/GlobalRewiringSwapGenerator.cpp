@@ -1,8 +1,8 @@
 #include <LFR/GlobalRewiringSwapGenerator.h>
 #include <stxxl/priority_queue>
 
-GlobalRewiringSwapGenerator::GlobalRewiringSwapGenerator(const stxxl::vector< LFR::CommunityAssignment > &communityAssignment, edgeid_t numEdges)
-    : _edge_community_input_sorter(new edge_community_sorter_t(GenericComparatorStruct<EdgeCommunity>::Ascending(), SORTER_MEM)), _num_edges(numEdges), _empty(true) {
+GlobalRewiringSwapGenerator::GlobalRewiringSwapGenerator(const stxxl::vector< LFR::CommunityAssignment > &communityAssignment, edgeid_t numEdges, seed_t seed)
+    : _edge_community_input_sorter(new edge_community_sorter_t(GenericComparatorStruct<EdgeCommunity>::Ascending(), SORTER_MEM)), _num_edges(numEdges), _random_integer(seed), _bool_stream(_random_integer), _empty(true) {
 
     stxxl::sorter<NodeCommunity, GenericComparatorStruct<NodeCommunity>::Ascending> node_community_sorter(GenericComparatorStruct<NodeCommunity>::Ascending(), SORTER_MEM);
     #pragma omp critical (_community_assignment)
@@ -32,14 +32,14 @@ private:
     std::unique_ptr<edge_community_sorter_t> _edge_community_output_sorter;
     edgeid_t _num_edges;
 
-    RandomBoolStream _bool_stream;
     stxxl::random_number64 _random_integer;
+    RandomBoolStream _bool_stream;
     std::vector<community_t> _current_communities;
     node_t _current_node;
     SemiLoadedSwapDescriptor _swap;
     bool _empty;
 public:
-    GlobalRewiringSwapGenerator(const stxxl::vector<LFR::CommunityAssignment> &communityAssignment, edgeid_t numEdges);
+    GlobalRewiringSwapGenerator(const stxxl::vector<LFR::CommunityAssignment> &communityAssignment, edgeid_t numEdges, seed_t seed = stxxl::get_next_seed());
 
     /**
      * Add edges that shall be checked for conflicts by providing an STXXL stream interface to the edges.
@@ -7,8 +7,9 @@ namespace LFR {
 
     void LFR::_compute_node_distributions() {
         // setup distributions
-        NodeDegreeDistribution ndd(_degree_distribution_params);
-        std::default_random_engine generator( stxxl::get_next_seed() );
+        const RandomSeeds seeds(_seed);
+        NodeDegreeDistribution ndd(_degree_distribution_params, seeds(NodeDistributionStream, 0));
+        std::default_random_engine generator( seeds(NodeDistributionStream, 1) );
         std::geometric_distribution<int> geo_dist(0.1);
 
         _degree_sum = 0;
@@ -93,13 +94,13 @@ namespace LFR {
         _community_cumulative_sizes.clear();
         _community_cumulative_sizes.reserve(_number_of_communities+1);
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        const RandomSeeds seeds(_seed);
+        std::mt19937 gen(seeds(CommunitySizeStream, 1));
 
         uint_t needed_memberships = (_number_of_nodes + (_overlap_config.constDegree.overlappingNodes * (_overlap_config.constDegree.multiCommunityDegree - 1)));
 
         // generate prefix sum of random powerlaw degree distribution
-        CommunityDistribution cdd(_community_distribution_params);
+        CommunityDistribution cdd(_community_distribution_params, seeds(CommunitySizeStream, 0));
         uint_t members_sum = 0;
         for(community_t c = 0; !cdd.empty(); ++cdd, ++c) {
             assert(static_cast<community_t>(_community_cumulative_sizes.size()) == c);
@@ -156,17 +157,13 @@ namespace LFR {
             STXXL_MSG("Remaining memory for actual swaps is " << _max_memory_usage << " bytes");
             STXXL_MSG("Degree sum is " << _degree_sum);
 
-            int_t globalSwapsPerIteration = std::max<int_t>(std::min<int_t>(1<<0, _degree_sum/ 2 * _mixing), (_degree_sum / 2 * _mixing) / 4);
-            STXXL_MSG("Doing " << globalSwapsPerIteration << " swaps per iteration for global swaps");
-            // subtract actually used amount of memory (so more memory is possibly available for communities)
-
             {
                 IOStatistics ios("GenCommGraphs");
                 _generate_community_graphs();
             }
             {
                 IOStatistics ios("GenGlobGraph");
-                _generate_global_graph(globalSwapsPerIteration);
+                _generate_global_graph();
             }
             {
                 IOStatistics ios("MergeGraphs");
@@ -9,6 +9,9 @@
 #include <stxxl/sorter>
 #include <stxxl/vector>
 #include <EdgeStream.h>
+#include <Utils/RandomSeeds.h>
+#include <stxxl/random>
+#include <functional>
 
 //#define LFR_TESTING
 
@@ -128,6 +131,20 @@ public:
 protected:
     using WorkerType = SyncWorker;
 
+    /**
+     * Random streams of the phases. All randomness of run() is derived from
+     * _seed, the phase and an index (e.g. a community) and, thus, independent of
+     * the number of threads and the order in which they process their work.
+     */
+    enum RandomStream : uint64_t {
+        NodeDistributionStream,
+        CommunitySizeStream,
+        CommunityAssignmentStream,
+        CommunityGraphStream,
+        CommunityRewiringStream,
+        GlobalGraphStream
+    };
+
     // model parameters
     const node_t _number_of_nodes;
     NodeDegreeDistribution::Parameters _degree_distribution_params;
@@ -143,6 +160,19 @@ protected:
     uint_t _max_memory_usage;
     uint_t _degree_sum;
 
+    bool _stop_swaps_on_convergence; ///< stop EM swap phases once SwapConvergenceMonitor reports convergence
+    edgeid_t _curveball_min_edges; ///< internal communities with at least this many edges are randomized by IMCurveball instead of IMEdgeSwap
+
+    seed_t _seed; ///< master seed of all random streams
+    uint_t _max_community_threads; ///< max. number of communities generated concurrently; each one may use a share of the memory
+
+public:
+    //! Receives a node u and its neighbours v > u in increasing order
+    using adjacency_callback_t = std::function<void(node_t, const std::vector<node_t> &)>;
+
+protected:
+    adjacency_callback_t _adjacency_callback; ///< invoked for every adjacency block while merging the final graph
+
     // model materialization
     stxxl::sorter<NodeDegreeMembership, NodeDegreeMembershipInternalDegComparator> _node_sorter;
 
@@ -171,10 +201,10 @@ protected:
 
     void _compute_node_distributions();
     void _compute_community_size();
-    void _compute_community_assignments();
+    void _compute_community_assignments(uint_t attempt = 0);
     void _correct_community_sizes();
     void _generate_community_graphs();
-    void _generate_global_graph(int_t swaps_per_iteration);
+    void _generate_global_graph();
     void _merge_community_and_global_graph();
 
     void _verify_assignment();
@@ -191,6 +221,10 @@ public:
         _community_distribution_params(community_degree_dist),
         _mixing(mixing_parameter),
         _max_memory_usage(max_memory_usage),
+        _stop_swaps_on_convergence(false),
+        _curveball_min_edges(std::numeric_limits<edgeid_t>::max()),
+        _seed(stxxl::get_next_seed()),
+        _max_community_threads(16),
         _node_sorter(NodeDegreeMembershipInternalDegComparator(_mixing), SORTER_MEM)
     {
         _overlap_method = geometric;
@@ -208,6 +242,11 @@ public:
           : LFR(other._degree_distribution_params, other._community_distribution_params, other._mixing, other._max_memory_usage)
     {
         setOverlap(other._overlap_method, other._overlap_config);
+        setSwapConvergence(other._stop_swaps_on_convergence);
+        setCommunityCurveball(other._curveball_min_edges);
+        setSeed(other._seed);
+        setMaxCommunityThreads(other._max_community_threads);
+        setAdjacencyCallback(other._adjacency_callback);
     }
 
     void setOverlap(OverlapMethod method, const OverlapConfig & config) {
@@ -215,6 +254,44 @@ public:
         _overlap_config = config;
     }
 
+    /**
+     * If enabled, the external memory swap phases (communities that do not fit
+     * into memory and the global graph) perform at most 10*m swaps but stop
+     * earlier once the SwapConvergenceMonitor reports that the graph is mixed.
+     */
+    void setSwapConvergence(bool enabled) {
+        _stop_swaps_on_convergence = enabled;
+    }
+
+    //! Communities that fit into internal memory and have at least min_edges edges are
+    //! randomized by IMCurveball; smaller ones still use IMEdgeSwap.
+    void setCommunityCurveball(edgeid_t min_edges) {
+        _curveball_min_edges = min_edges;
+    }
+
+    //! Master seed; the same seed and parameters yield the same graph for any number of threads.
+    void setSeed(seed_t seed) {
+        _seed = seed;
+    }
+
+    /**
+     * Maximum number of communities generated concurrently. Each of them gets the
+     * same share of the memory, which decides between internal and external memory
+     * algorithms. It hence changes the output, but the number of available threads does not.
+     */
+    void setMaxCommunityThreads(uint_t threads) {
+        _max_community_threads = std::max<uint_t>(1, threads);
+    }
+
+    /**
+     * The callback receives the adjacency blocks of the resulting graph while it is
+     * merged, i.e. before run() returns and without another pass over the edges.
+     * Nodes arrive in increasing order; nodes without a neighbour v > u are skipped.
+     */
+    void setAdjacencyCallback(adjacency_callback_t callback) {
+        _adjacency_callback = std::move(callback);
+    }
+
     EdgeStream & get_edges() {
         return _edges;
     }
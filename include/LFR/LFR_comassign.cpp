@@ -117,7 +117,7 @@ void LFR::_correct_community_sizes() {
 #endif
 }
 
-void LFR::_compute_community_assignments() {
+void LFR::_compute_community_assignments(uint_t attempt) {
     auto & com_sizes = _community_cumulative_sizes;
 
     // keep results (and sort them lexicographically, so edge switches are possible)
@@ -139,7 +139,7 @@ void LFR::_compute_community_assignments() {
 
     RandomIntervalTree<node_t> tree(com_sizes);
     const community_t number_of_communities = com_sizes.size();
-    stxxl::random_number64 randGen;
+    stxxl::random_number64 randGen(RandomSeeds(_seed)(CommunityAssignmentStream, attempt));
 
     // find the smallest legal community and then uniformly
     // select it or larger one
@@ -216,7 +216,7 @@ void LFR::_compute_community_assignments() {
                     std::cerr << std::endl;
 
                     _node_sorter.rewind();
-                    _compute_community_assignments();
+                    _compute_community_assignments(attempt + 1);
                     return;
                 }
             }
@@ -325,7 +325,7 @@ void LFR::_compute_community_assignments() {
                             std::cerr << std::endl;
 
                             _node_sorter.rewind();
-                            _compute_community_assignments();
+                            _compute_community_assignments(attempt + 1);
                             return;
                         }
                     }
@@ -5,17 +5,24 @@
 #include <stxxl/vector>
 #include <stxxl/sorter>
 #include <IMGraph.h>
-#include <EdgeSwaps/IMEdgeSwap.h>
+#include <EdgeSwaps/ParallelIMEdgeSwap.h>
+#include <Curveball/IMCurveball.h>
 #include <Utils/AsyncStream.h>
 #include <omp.h>
 #include <EdgeSwaps/EdgeSwapTFP.h>
+#include <EdgeSwaps/SwapConvergenceMonitor.h>
 #include <Utils/StreamPusher.h>
 
 namespace LFR {
     void LFR::_generate_community_graphs() {
         stxxl::sorter<CommunityEdge, GenericComparatorStruct<CommunityEdge>::Ascending> edgeSorter(GenericComparatorStruct<CommunityEdge>::Ascending(), SORTER_MEM);
-        const uint_t n_threads = omp_get_max_threads();
-        const uint_t memory_per_thread = _max_memory_usage / n_threads;
+        // the memory share of a community must not depend on the number of threads,
+        // as it decides between internal and external memory algorithms
+        const uint_t n_threads = std::min<uint_t>(omp_get_max_threads(), _max_community_threads);
+        const uint_t memory_per_thread = _max_memory_usage / _max_community_threads;
+        // the remaining threads are shared among the concurrently generated communities
+        const int threads_per_community = std::max<int>(1, omp_get_max_threads() / n_threads);
+        const RandomSeeds seeds(_seed);
 
         #pragma omp parallel shared(edgeSorter), num_threads(n_threads)
         {
@@ -35,6 +42,9 @@ namespace LFR {
                 int_t degree_sum = 0;
                 uint_t available_memory = memory_per_thread;
 
+                // seeds of the community's random streams
+                const RandomSeeds com_seeds = seeds.substreams(CommunityGraphStream, com);
+
                 HavelHakimiIMGenerator gen(HavelHakimiIMGenerator::DecreasingDegree);
                 bool internalNodes = (com_size * 2 * sizeof(node_t) < available_memory / 10 ); // use up to ten percent of the memory for internal node ids
 
@@ -72,8 +82,32 @@ namespace LFR {
 
                 gen.generate();
 
-                if (internalNodes && IMGraph::memoryUsage(com_size, degree_sum/2) < available_memory && degree_sum/2 < IMGraph::maxEdges()) {
-                    IMGraph graph(node_degrees);
+                if (internalNodes && degree_sum/2 >= _curveball_min_edges && Curveball::IMCurveball::memoryUsage(com_size, degree_sum/2) + degree_sum/2 * sizeof(edge_t) < available_memory) {
+                    // the generator may not realize the degree sequence exactly
+                    std::vector<edge_t> edges;
+                    edges.reserve(degree_sum/2);
+                    std::fill(node_degrees.begin(), node_degrees.end(), 0);
+                    for (; !gen.empty(); ++gen) {
+                        edges.push_back(*gen);
+                        ++node_degrees[gen->first];
+                        ++node_degrees[gen->second];
+                    }
+
+                    Curveball::IMCurveball curveball(node_degrees, edges, threads_per_community, com_seeds(0));
+                    edges = std::vector<edge_t>();
+
+                    STXXL_MSG("Running internal Curveball with " << curveball.numEdges() << " edges");
+
+                    curveball.run(20);
+
+                    #pragma omp critical (_edgeSorter)
+                    for (const edge_t & ce : curveball.getEdges()) {
+                        edge_t e = {node_ids[ce.first], node_ids[ce.second]};
+                        e.normalize();
+                        edgeSorter.push(CommunityEdge(com, e));
+                    }
+                } else if (internalNodes && IMGraph::memoryUsage(node_degrees) < available_memory && degree_sum/2 < IMGraph::maxEdges()) {
+                    IMGraph graph(node_degrees, com_seeds(1));
                     while (!gen.empty()) {
                         graph.addEdge(*gen);
                         ++gen;
@@ -85,8 +119,8 @@ namespace LFR {
                         // Generate swaps
                         uint_t numSwaps = 10*graph.numEdges();
 
-                        IMEdgeSwap swapAlgo(graph);
-                        for (SwapGenerator swapGen(numSwaps, graph.numEdges()); !swapGen.empty(); ++swapGen) {
+                        ParallelIMEdgeSwap swapAlgo(graph, threads_per_community);
+                        for (SwapGenerator swapGen(numSwaps, graph.numEdges(), com_seeds(2)); !swapGen.empty(); ++swapGen) {
                             swapAlgo.push(*swapGen);
                         }
 
@@ -118,14 +152,20 @@ namespace LFR {
 
                     // Generate swaps
                     uint_t numSwaps = 10*intra_edges.size();
-                    SwapGenerator swap_gen(numSwaps, intra_edges.size());
+                    SwapGenerator swap_gen(numSwaps, intra_edges.size(), com_seeds(2));
 
-                    uint_t run_length = intra_edges.size() / 8;
+                    std::unique_ptr<SwapConvergenceMonitor> monitor;
+                    if (_stop_swaps_on_convergence) {
+                        SwapConvergenceMonitor::Parameters monitor_params;
+                        monitor_params.seed = com_seeds(3);
+                        monitor.reset(new SwapConvergenceMonitor(intra_edges, com_size, monitor_params));
+                    }
 
                     // perform swaps
-                    EdgeSwapTFP::EdgeSwapTFP swap_algo(intra_edges, run_length, _number_of_nodes, _max_memory_usage);
+                    EdgeSwapTFP::EdgeSwapTFP swap_algo(intra_edges, EdgeSwapTFP::EdgeSwapTFP::auto_run_length, _number_of_nodes, available_memory);
+                    swap_algo.setConvergenceMonitor(monitor.get());
 
-                    StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
+                    pushSwapsUntilConverged(swap_gen, swap_algo, monitor.get());
 
                     swap_algo.run();
 
@@ -187,7 +227,7 @@ namespace LFR {
         _intra_community_edges.resize(edgeSorter.size());
         stxxl::stream::materialize(edgeSorter, _intra_community_edges.begin());
 
-        CommunityEdgeRewiringSwaps rewiringSwaps(_intra_community_edges, _intra_community_edges.size() / 3);
+        CommunityEdgeRewiringSwaps rewiringSwaps(_intra_community_edges, _intra_community_edges.size() / 3, seeds(CommunityRewiringStream));
         rewiringSwaps.run();
     }
 }
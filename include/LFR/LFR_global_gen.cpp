@@ -10,9 +10,12 @@
 #include <DegreeStream.h>
 #include <Utils/NodeHash.h>
 #include <Curveball/EMCurveball.h>
+#include <EdgeSwaps/SwapConvergenceMonitor.h>
 
 namespace LFR {
-    void LFR::_generate_global_graph(int_t globalSwapsPerIteration) {
+    void LFR::_generate_global_graph() {
+		const RandomSeeds seeds(_seed);
+
 		#ifdef CURVEBALL_RAND
 		HavelHakimiIMGeneratorWithDegrees gen(HavelHakimiIMGeneratorWithDegrees::DecreasingDegree);
 		#else
@@ -97,27 +100,45 @@ namespace LFR {
                 _inter_community_edges.rewind();
 
 				// regular edge swaps
-				EdgeSwapTFP::SemiLoadedEdgeSwapTFP swapAlgo(_inter_community_edges, globalSwapsPerIteration, _number_of_nodes, _max_memory_usage);
+				EdgeSwapTFP::SemiLoadedEdgeSwapTFP swapAlgo(_inter_community_edges, EdgeSwapTFP::EdgeSwapTFP::auto_run_length, _number_of_nodes, _max_memory_usage);
 				// Generate swaps
 				uint_t numSwaps = 1*_inter_community_edges.size();
-				SwapGenerator swapGen(numSwaps, _inter_community_edges.size());
+				SwapGenerator swapGen(numSwaps, _inter_community_edges.size(), seeds(GlobalGraphStream, 0));
 
 				if (1) {
 					IOStatistics ios("GlobalGenInitialRand");
-					StreamPusher<decltype(swapGen), decltype(swapAlgo)>(swapGen, swapAlgo);
+					std::unique_ptr<SwapConvergenceMonitor> monitor;
+					if (_stop_swaps_on_convergence) {
+						SwapConvergenceMonitor::Parameters monitor_params;
+						monitor_params.seed = seeds(GlobalGraphStream, 1);
+						monitor.reset(new SwapConvergenceMonitor(_inter_community_edges, _number_of_nodes, monitor_params));
+					}
+
+					swapAlgo.setConvergenceMonitor(monitor.get());
+					pushSwapsUntilConverged(swapGen, swapAlgo, monitor.get());
 					swapAlgo.run();
+					swapAlgo.setConvergenceMonitor(nullptr);
 				}
 			#else
 				// regular edge swaps
-				EdgeSwapTFP::SemiLoadedEdgeSwapTFP swapAlgo(_inter_community_edges, globalSwapsPerIteration, _number_of_nodes, _max_memory_usage);
+				EdgeSwapTFP::SemiLoadedEdgeSwapTFP swapAlgo(_inter_community_edges, EdgeSwapTFP::EdgeSwapTFP::auto_run_length, _number_of_nodes, _max_memory_usage);
 				// Generate swaps
 				uint_t numSwaps = 10*_inter_community_edges.size();
-				SwapGenerator swapGen(numSwaps, _inter_community_edges.size());
+				SwapGenerator swapGen(numSwaps, _inter_community_edges.size(), seeds(GlobalGraphStream, 0));
 
 				if (1) {
 					IOStatistics ios("GlobalGenInitialRand");
-					StreamPusher<decltype(swapGen), decltype(swapAlgo)>(swapGen, swapAlgo);
+					std::unique_ptr<SwapConvergenceMonitor> monitor;
+					if (_stop_swaps_on_convergence) {
+						SwapConvergenceMonitor::Parameters monitor_params;
+						monitor_params.seed = seeds(GlobalGraphStream, 1);
+						monitor.reset(new SwapConvergenceMonitor(_inter_community_edges, _number_of_nodes, monitor_params));
+					}
+
+					swapAlgo.setConvergenceMonitor(monitor.get());
+					pushSwapsUntilConverged(swapGen, swapAlgo, monitor.get());
 					swapAlgo.run();
+					swapAlgo.setConvergenceMonitor(nullptr);
 				}
 			#endif
 
@@ -125,7 +146,7 @@ namespace LFR {
                 IOStatistics ios("GlobalGenRewire");
 
                 // rewiring in order to not to generate new intra-community edges
-                GlobalRewiringSwapGenerator rewiringSwapGenerator(_community_assignments, _inter_community_edges.size());
+                GlobalRewiringSwapGenerator rewiringSwapGenerator(_community_assignments, _inter_community_edges.size(), seeds(GlobalGraphStream, 2));
                 _inter_community_edges.rewind();
                 rewiringSwapGenerator.pushEdges(_inter_community_edges);
                 _inter_community_edges.rewind();
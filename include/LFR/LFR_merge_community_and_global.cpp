@@ -1,38 +1,75 @@
 #include "LFR.h"
+#include <Utils/AsyncStream.h>
+#include <Utils/AsyncPusher.h>
 
 namespace LFR {
+    /**
+     * Both inputs and the output are single sequential EM streams, hence the merge
+     * is pipelined: the two inputs are read ahead and the output is written back by
+     * separate threads, such that the three streams are transferred concurrently.
+     */
     void LFR::_merge_community_and_global_graph() {
+        using intra_reader_t = decltype(_intra_community_edges)::bufreader_type;
+
         _inter_community_edges.rewind();
-        decltype(_intra_community_edges)::bufreader_type intra_edge_reader(_intra_community_edges);
+        intra_reader_t intra_edge_reader_in(_intra_community_edges);
 
         _edges.clear();
 
+        AsyncStream<EdgeStream> inter_community_edges(_inter_community_edges, true, 1.0e6);
+        AsyncStream<intra_reader_t> intra_edge_reader(intra_edge_reader_in, true, 1.0e6);
+        AsyncPusher<EdgeStream, edge_t> edges(_edges, 1 << 20, 3);
+
         edge_t curEdge = {-1, -1};
 
         int_t discardedEdges = 0;
 
-        while (!_inter_community_edges.empty() || !intra_edge_reader.empty()) {
-            if (_inter_community_edges.empty() || (!intra_edge_reader.empty() && intra_edge_reader->edge <= *_inter_community_edges)) {
+        // adjacency block of the current source node for the callback
+        std::vector<node_t> neighbours;
+        node_t block_node = -1;
+        auto push_edge = [&] (const edge_t & e) {
+            edges.push(e);
+
+            if (_adjacency_callback) {
+                if (e.first != block_node) {
+                    if (!neighbours.empty())
+                        _adjacency_callback(block_node, neighbours);
+
+                    neighbours.clear();
+                    block_node = e.first;
+                }
+
+                neighbours.push_back(e.second);
+            }
+        };
+
+        while (!inter_community_edges.empty() || !intra_edge_reader.empty()) {
+            if (inter_community_edges.empty() || (!intra_edge_reader.empty() && intra_edge_reader->edge <= *inter_community_edges)) {
                 if (curEdge != intra_edge_reader->edge) {
                     curEdge = intra_edge_reader->edge;
-                    _edges.push(curEdge);
+                    push_edge(curEdge);
                 } else {
                     ++discardedEdges;
                 }
 
                 ++intra_edge_reader;
-            } else if (intra_edge_reader.empty() || *_inter_community_edges < intra_edge_reader->edge) {
-                if (curEdge != *_inter_community_edges) {
-                    curEdge = *_inter_community_edges;
-                    _edges.push(curEdge);
+            } else if (intra_edge_reader.empty() || *inter_community_edges < intra_edge_reader->edge) {
+                if (curEdge != *inter_community_edges) {
+                    curEdge = *inter_community_edges;
+                    push_edge(curEdge);
                 } else {
                     assert(false && "Global edges should have been rewired to not to conflict with any internal edge!");
                 }
 
-                ++_inter_community_edges;
+                ++inter_community_edges;
             }
         }
 
+        if (!neighbours.empty())
+            _adjacency_callback(block_node, neighbours);
+
+        edges.finish();
+
         if (discardedEdges > 0) {
             STXXL_MSG("Discarded " << discardedEdges << " internal edges that were in multiple communities of in total " << _edges.size() << " edges.");
             assert(false && "Duplicate intra-community edges should have been rewired!");
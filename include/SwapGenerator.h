@@ -27,10 +27,11 @@ protected:
     RandomBoolStream _bool_stream;
 
 public:
-    SwapGenerator(int64_t number_of_swaps, int64_t edges_in_graph)
+    SwapGenerator(int64_t number_of_swaps, int64_t edges_in_graph, seed_t seed = stxxl::get_next_seed())
         : _number_of_edges_in_graph(edges_in_graph)
         , _requested_number_of_swaps(number_of_swaps)
         , _current_number_of_swaps(0)
+        , _random_integer(seed)
         , _bool_stream(_random_integer)
     {
         assert(_number_of_edges_in_graph > 1);
@@ -93,6 +93,48 @@ inline std::ostream &operator<<(std::ostream &os, SemiLoadedSwapDescriptor const
     return os << "{swap edges " << m.edge() << " and " << m.eid() << " dir " << m.direction() << "}";
 }
 
+/**
+ * @brief Store both edges by value and the direction describing a swap
+ *
+ * Engines supporting it match the edges while scanning the graph, so the swap
+ * does not need to resolve edge ids. If an edge is not in the graph, the swap
+ * is ignored.
+ */
+class LoadedSwapDescriptor {
+    edge_t _edges[2];
+    bool _direction;
+
+public:
+    LoadedSwapDescriptor() : _edges{edge_t(0, 0), edge_t(0, 0)}, _direction(false) {}
+
+    //! Edges are ordered as the ids of a SwapDescriptor would be
+    LoadedSwapDescriptor(edge_t e1, edge_t e2, bool dir)
+          : _edges{e1, e2}, _direction(dir)
+    {
+        if (e2 < e1) std::swap(_edges[0], _edges[1]);
+    }
+
+    //! Constant array of the two edges
+    const edge_t* edges() const {return _edges;}
+
+    /**
+     * Indicate swap direction:  <br />
+     * direction == false: (v1, v3) and (v2, v4)<br />
+     * direction == true : (v2, v3) and (v1, v4)
+     */
+    bool direction() const {return _direction;}
+
+    //! Equal if all member values match
+    bool operator==(const LoadedSwapDescriptor & o) const {
+        return std::tie(_edges[0], _edges[1], _direction) ==
+               std::tie(o._edges[0], o._edges[1], o._direction);
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, LoadedSwapDescriptor const &m) {
+    return os << "{swap edges " << m.edges()[0] << " and " << m.edges()[1] << " dir " << m.direction() << "}";
+}
+
 /**
  * @brief Results of an attempted swap
  *
@@ -0,0 +1,164 @@
+#pragma once
+/**
+ * @file
+ * @brief  Binary framing of sorted adjacency blocks for streaming graphs through a pipe
+ * @author Michael Hamann
+ * @copyright to be decided
+ *
+ * A stream consists of
+ *  - a header: the magic "LFRA", a uint32 version (1) and the uint64 number of nodes,
+ *  - one block per node u with at least one neighbour v > u: the int32 u, the
+ *    uint32 number of neighbours and the int32 neighbours in increasing order,
+ *  - a terminating block with u = -1 and no neighbours.
+ * Blocks are ordered by u; every undirected edge is contained exactly once, in the
+ * block of its smaller node. All values are stored in host byte order.
+ */
+
+#include <defs.h>
+#include <algorithm>
+#include <cassert>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace AdjacencyBlockStream {
+    constexpr char magic[4] = {'L', 'F', 'R', 'A'};
+    constexpr uint32_t version = 1;
+    constexpr node_t end_of_stream = -1;
+}
+
+class AdjacencyBlockWriter {
+    std::ostream & _os;
+    node_t _last_node;
+    edgeid_t _edges_written;
+
+    template <typename T>
+    void _write(const T & value) {
+        _os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+public:
+    AdjacencyBlockWriter(std::ostream & os, node_t num_nodes)
+        : _os(os), _last_node(-1), _edges_written(0)
+    {
+        static_assert(std::is_same<int32_t, node_t>::value, "Node type is not int32 anymore, adjust framing!");
+
+        _os.write(AdjacencyBlockStream::magic, sizeof(AdjacencyBlockStream::magic));
+        _write(AdjacencyBlockStream::version);
+        _write(static_cast<uint64_t>(num_nodes));
+    }
+
+    //! Writes the neighbours v > u of node u; nodes have to be written in increasing order
+    void operator()(node_t u, const std::vector<node_t> & neighbours) {
+        assert(u > _last_node);
+        assert(!neighbours.empty());
+        _last_node = u;
+
+        _write(u);
+        _write(static_cast<uint32_t>(neighbours.size()));
+        _os.write(reinterpret_cast<const char*>(neighbours.data()), neighbours.size() * sizeof(node_t));
+        _edges_written += neighbours.size();
+    }
+
+    //! Writes the terminating block and flushes the stream
+    void finish() {
+        _write(AdjacencyBlockStream::end_of_stream);
+        _write(static_cast<uint32_t>(0));
+        _os.flush();
+    }
+
+    edgeid_t edges_written() const {
+        return _edges_written;
+    }
+};
+
+/**
+ * Reads a stream written by AdjacencyBlockWriter and provides its edges (u, v)
+ * with u < v in increasing order using the STXXL stream interface.
+ */
+class AdjacencyBlockReader {
+public:
+    using value_type = edge_t;
+
+private:
+    std::istream & _is;
+    uint64_t _num_nodes;
+    std::vector<node_t> _neighbours;
+    size_t _index;
+    value_type _current;
+    bool _empty;
+
+    template <typename T>
+    bool _read(T & value) {
+        return static_cast<bool>(_is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    //! Throws if the stream ends before the terminating block, e.g. if the writer died
+    void _read_block() {
+        node_t u;
+        uint32_t count = 0;
+        while (!count) {
+            if (!_read(u) || !_read(count))
+                throw std::runtime_error("Adjacency block stream ended without terminating block");
+
+            if (u == AdjacencyBlockStream::end_of_stream) {
+                _empty = true;
+                return;
+            }
+        }
+
+        _neighbours.resize(count);
+        _is.read(reinterpret_cast<char*>(_neighbours.data()), count * sizeof(node_t));
+        if (static_cast<size_t>(_is.gcount()) != count * sizeof(node_t))
+            throw std::runtime_error("Adjacency block stream ended within a block");
+
+        _current.first = u;
+        _index = 0;
+    }
+
+public:
+    //! Throws if the stream does not start with a valid header or is truncated
+    explicit AdjacencyBlockReader(std::istream & is)
+        : _is(is), _num_nodes(0), _index(0), _current(0, 0), _empty(false)
+    {
+        char magic[4];
+        uint32_t version;
+        if (!_is.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, AdjacencyBlockStream::magic)
+            || !_read(version) || version != AdjacencyBlockStream::version || !_read(_num_nodes))
+            throw std::runtime_error("Input is not an adjacency block stream of version 1");
+
+        _read_block();
+        if (!_empty)
+            _current.second = _neighbours[0];
+    }
+
+    uint64_t num_nodes() const {
+        return _num_nodes;
+    }
+
+    bool empty() const {
+        return _empty;
+    }
+
+    const value_type & operator*() const {
+        assert(!empty());
+        return _current;
+    }
+
+    const value_type * operator->() const {
+        return &operator*();
+    }
+
+    AdjacencyBlockReader & operator++() {
+        assert(!empty());
+        if (++_index == _neighbours.size())
+            _read_block();
+
+        if (!_empty)
+            _current.second = _neighbours[_index];
+
+        return *this;
+    }
+};
@@ -2,11 +2,19 @@
 
 #include<vector>
 #include<list>
-#include<thread>
+#include<deque>
+#include<memory>
+#include<chrono>
 #include<future>
+#include<iostream>
+
+#include <Utils/ThreadPool.h>
 
 #define ASYNC_PUSHER_STATS
 
+//! Buffers pushed elements and forwards each filled buffer to the target
+//! asynchronously. The buffers are pushed one after another by a SerialTaskQueue,
+//! i.e. the target is never accessed concurrently and sees the original order.
 template <class TargetT, typename T>
 class AsyncPusher {
     using BufferType = std::vector<T>;
@@ -18,19 +26,16 @@ class AsyncPusher {
     const unsigned int _number_of_buffers;
 
     // Buffer stores
-    std::list<std::unique_ptr<BufferType>> _target_buffers;
     std::list<std::unique_ptr<BufferType>> _empty_buffers;
+    std::deque<std::pair<std::unique_ptr<BufferType>, std::future<void>>> _target_buffers;
 
     // Push interface
     BufIt _push_it;
     BufIt _push_end;
 
     // Multi-Threading
-    std::future<void> _pusher_done;
-    std::mutex _list_mutex;
-    std::condition_variable _target_cv;
-    std::condition_variable _empty_cv;
-    std::atomic_bool _done_pushing;
+    SerialTaskQueue _pusher;
+    bool _done_pushing;
 
     // Statistics
 #ifdef ASYNC_PUSHER_STATS
@@ -44,26 +49,33 @@ class AsyncPusher {
     uint64_t _stat_items_pushed_to_target;
 #endif
 
+    //! Returns the oldest buffer handed to the pusher once it has been pushed
+    void _reclaim_buffer() {
+        assert(!_target_buffers.empty());
+        _pusher.wait(_target_buffers.front().second);
+        _empty_buffers.push_back(std::move(_target_buffers.front().first));
+        _target_buffers.pop_front();
+    }
+
     void _fetch_push_buffer(bool push_current) {
         #ifdef ASYNC_PUSHER_STATS
             auto begin = std::chrono::high_resolution_clock::now();
         #endif
-        { // CRITICAL_SECTION
-            std::unique_lock <std::mutex> lck(_list_mutex);
-
-            if (push_current) {
-                // move the most recently filled buffer into the target list
-                _target_buffers.emplace_back(nullptr);
-                std::swap(_target_buffers.back(), _empty_buffers.front());
-                _empty_buffers.pop_front();
 
-                // wake pusher thread
-                _target_cv.notify_one();
-            }
+        if (push_current) {
+            // hand the most recently filled buffer to the pusher
+            std::unique_ptr<BufferType> buf = std::move(_empty_buffers.front());
+            _empty_buffers.pop_front();
 
-            // wait for a buffer
-            _empty_cv.wait(lck, [&]() { return !_empty_buffers.empty(); });
+            BufferType * ptr = buf.get();
+            auto pushed = _pusher.submit([this, ptr] () {_push_buffer(*ptr);});
+            _target_buffers.emplace_back(std::move(buf), std::move(pushed));
         }
+
+        // wait for a buffer
+        if (_empty_buffers.empty())
+            _reclaim_buffer();
+
         #ifdef ASYNC_PUSHER_STATS
             auto end = std::chrono::high_resolution_clock::now();
             _stat_wait_for_empty += std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
@@ -77,52 +89,12 @@ class AsyncPusher {
         _push_end = buf.end();
     }
 
-    void _pusher_main() {
-        bool first_iteration = true;
-        while(1) {
-            #ifdef ASYNC_PUSHER_STATS
-                auto begin = std::chrono::high_resolution_clock::now();
-            #endif
-            {
-                std::unique_lock<std::mutex> lck(_list_mutex);
-
-                if (!first_iteration) {
-                    // we need to return the buffer
-                    _empty_buffers.emplace_back(nullptr);
-                    std::swap(_target_buffers.front(), _empty_buffers.back());
-                    _target_buffers.pop_front();
-
-                    // wake a lazy producer
-                    _empty_cv.notify_one();
-                }
-
-                // wait for buffer to push
-                _target_cv.wait(lck, [&]() { return !_target_buffers.empty() || _done_pushing; });
-            }
-            #ifdef ASYNC_PUSHER_STATS
-                auto end = std::chrono::high_resolution_clock::now();
-                _stat_wait_for_filled += std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
+    void _push_buffer(const BufferType & buf) {
+        for(const auto & e : buf) {
+            _target.push(e);
+            #ifndef NDEBUG
+                _stat_items_pushed_to_target++;
             #endif
-
-            // stop here
-            if (_target_buffers.empty()) {
-                assert(_done_pushing);
-                assert(_stat_items_received == _stat_items_pushed_to_target);
-
-                std::cout << "Bye" << std::endl;
-                return;
-            }
-
-            // push into target
-            for(const auto & e : *_target_buffers.front()) {
-                _target.push(e);
-                #ifndef NDEBUG
-                    _stat_items_pushed_to_target++;
-                #endif
-            }
-
-
-            first_iteration = false;
         }
     }
 
@@ -131,6 +103,7 @@ public:
         : _target(target)
         , _buffer_size(elements_in_buffer)
         , _number_of_buffers(number_of_buffers)
+        , _pusher("AsyncPusher")
         , _done_pushing(false)
         , _stat_wait_for_empty(0)
         , _stat_wait_for_filled(0)
@@ -148,8 +121,6 @@ public:
         }
 
         _fetch_push_buffer(false);
-
-        _pusher_done = std::async(std::launch::async, &AsyncPusher::_pusher_main, this);
     }
 
     ~AsyncPusher() {
@@ -189,7 +160,6 @@ public:
         }
 
         _done_pushing = true;
-        _target_cv.notify_one();
 
         if (wait)
             waitForPusher();
@@ -197,8 +167,18 @@ public:
 
     void waitForPusher() {
         assert(_done_pushing);
-        if (_pusher_done.valid())
-            _pusher_done.get();
+
+        #ifdef ASYNC_PUSHER_STATS
+            auto begin = std::chrono::high_resolution_clock::now();
+        #endif
+
+        while (!_target_buffers.empty())
+            _reclaim_buffer();
+
+        #ifdef ASYNC_PUSHER_STATS
+            auto end = std::chrono::high_resolution_clock::now();
+            _stat_wait_for_filled += std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
+        #endif
 
         assert(_stat_items_received == _stat_items_pushed_to_target);
     }
@@ -213,7 +193,8 @@ public:
             ptr->resize(_buffer_size);
         }
 
-        _pusher_done = std::async(std::launch::async, &AsyncPusher::_pusher_main, this);
+        _done_pushing = false;
+        _fetch_push_buffer(false);
     }
 
     void report_stats(const std::string & name) {
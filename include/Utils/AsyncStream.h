@@ -2,6 +2,8 @@
 
 #include <stxxl/bits/common/utils.h>
 
+#include <Utils/ThreadPool.h>
+
 #include <thread>
 #include <future>
 #include <chrono>
@@ -55,7 +57,10 @@ protected:
        _batch_time = _target_batch_time;
        //std::cout << "Request " << elements << " elements to be produced async" << std::endl;
 
-       _producer_future =  std::async(std::launch::async, [] (StreamIn& stream, BufferType & buf, size_t num) {
+       StreamIn & stream = _producing_stream;
+       BufferType & buf = _produce_buffer;
+       _producer_future = ThreadPool::instance().submit([&stream, &buf, elements] () {
+           const size_t num = elements;
            auto begin = std::chrono::high_resolution_clock::now();
 
            auto it = buf.begin();
@@ -66,7 +71,7 @@ protected:
 
 
            return std::make_pair(Iterator(it), double(num) * 1.0e9 / std::chrono::duration_cast<std::chrono::nanoseconds>(end-begin).count());
-       }, std::ref(_producing_stream), std::ref(_produce_buffer), elements);
+       }, "AsyncStream", this);
     }
 
     void _receive_buffer() {
@@ -80,7 +85,7 @@ protected:
          #endif
 
           // wait for produer
-          std::tie(_consume_end, rate) = _producer_future.get();
+          std::tie(_consume_end, rate) = ThreadPool::instance().wait(_producer_future, this);
 
           #ifdef ASYNC_STREAM_STATS
              auto end = std::chrono::high_resolution_clock::now();
@@ -129,7 +134,7 @@ public:
 
     ~AsyncStream() {
        if (_producer_future.valid())
-          _producer_future.wait();
+          ThreadPool::instance().wait(_producer_future, this);
     }
 
     //! Needs to be called before the first access to the streaming interface
@@ -143,7 +148,7 @@ public:
     //! @warning You have to call acquire again
     void restart(bool auto_acquire) {
        if (_producer_future.valid())
-          _producer_future.wait();
+          ThreadPool::instance().wait(_producer_future, this);
 
        _batch_time = _target_batch_time * initial_batch_time_factor;
        _start_producing();
@@ -0,0 +1,78 @@
+#pragma once
+/**
+ * @file
+ * @brief  Bloom filter over 64 bit keys
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <defs.h>
+#include <Utils/RandomSeeds.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Approximate set of 64 bit keys without false negatives
+ *
+ * The number of bits is the largest power of two fitting into the memory
+ * budget; the number of hash functions is chosen to minimise the false positive
+ * rate for the expected number of keys. The probe positions are derived from a
+ * single SplitMix64 hash using double hashing.
+ */
+class BloomFilter {
+    std::vector<uint64_t> _words;
+    uint64_t _bit_mask;
+    unsigned int _num_hashes;
+
+public:
+    //! @param bytes  Memory budget of the bit array (at least 8 bytes are used)
+    //! @param expected_keys  Number of keys expected to be inserted before the next clear()
+    BloomFilter(size_t bytes, size_t expected_keys) {
+        size_t num_words = 1;
+        while (2 * num_words * sizeof(uint64_t) <= bytes)
+            num_words *= 2;
+
+        _words.assign(num_words, 0);
+        _bit_mask = 64 * num_words - 1;
+
+        const double bits_per_key = 64.0 * num_words / std::max<size_t>(1, expected_keys);
+        _num_hashes = static_cast<unsigned int>(std::min(16.0, std::max(1.0, std::round(bits_per_key * std::log(2.0)))));
+    }
+
+    void insert(uint64_t key) {
+        const uint64_t hash = splitmix64(key);
+        const uint64_t step = (hash >> 32) | 1;
+        uint64_t pos = hash;
+        for (unsigned int i = 0; i < _num_hashes; ++i, pos += step) {
+            const uint64_t bit = pos & _bit_mask;
+            _words[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    //! False if the key has not been inserted since the last clear()
+    bool contains(uint64_t key) const {
+        const uint64_t hash = splitmix64(key);
+        const uint64_t step = (hash >> 32) | 1;
+        uint64_t pos = hash;
+        for (unsigned int i = 0; i < _num_hashes; ++i, pos += step) {
+            const uint64_t bit = pos & _bit_mask;
+            if (!(_words[bit / 64] & (uint64_t(1) << (bit % 64))))
+                return false;
+        }
+        return true;
+    }
+
+    void clear() {
+        std::fill(_words.begin(), _words.end(), 0);
+    }
+
+    size_t bytes() const {
+        return _words.size() * sizeof(uint64_t);
+    }
+
+    unsigned int numHashes() const {
+        return _num_hashes;
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+/**
+ * @file
+ * @brief  Sorter forming its runs with the radix sort of IntSort.h
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <stxxl/sorter>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <defs.h>
+#include <Utils/IntSort.h>
+
+/**
+ * @brief Drop-in replacement of stxxl::sorter for messages with bounded integer keys
+ *
+ * Elements are collected in an internal buffer that is sorted by the integer key
+ * extracted by KeyExtract, using the parallel radix sort of intsort. The key has to
+ * be monotonic w.r.t. the comparator (cmp(a, b) implies key(a) <= key(b)); elements
+ * with equal keys are ordered by the comparator afterwards. As the radix sort is
+ * stable, ranges of equal keys that were pushed in order need no further work.
+ *
+ * Sorted buffers become runs of an STXXL runs creator which are merged by an STXXL
+ * runs merger. If all elements fit into a single buffer, no I/O is performed.
+ *
+ * In contrast to stxxl::sorter, rewinding is not supported; size() is the number
+ * of elements not yet consumed as for the STXXL merger.
+ */
+template <typename ValueType, typename CompareType, typename KeyExtract,
+          unsigned BlockSize = STXXL_DEFAULT_BLOCK_SIZE(ValueType)>
+class IntSorter {
+public:
+    using value_type = ValueType;
+    using key_type = decltype(std::declval<KeyExtract>()(std::declval<const ValueType&>()));
+
+protected:
+    using sorter_type = stxxl::sorter<ValueType, CompareType, BlockSize>;
+    using runs_creator_type = stxxl::stream::runs_creator<stxxl::stream::from_sorted_sequences<ValueType>,
+        CompareType, BlockSize, STXXL_DEFAULT_ALLOC_STRATEGY>;
+    using runs_merger_type = typename sorter_type::runs_merger_type;
+
+    CompareType _cmp;
+    KeyExtract _key_extract;
+    const size_t _memory;
+    const size_t _buffer_capacity;
+
+    enum State {
+        Pushing,
+        ReadingBuffer,
+        ReadingRuns
+    };
+    State _state;
+
+    std::vector<ValueType> _buffer;
+    key_type _max_key;
+    size_t _buffer_pos;
+
+    // created lazily once the buffer overflows for the first time
+    std::unique_ptr<runs_creator_type> _runs_creator;
+    std::unique_ptr<runs_merger_type> _runs_merger;
+    size_t _size;
+
+    void _sort_buffer() {
+        intsort::sort(_buffer, _key_extract, _max_key);
+
+        // restore the order of the comparator within ranges of equal keys
+        for (auto begin = _buffer.begin(); begin != _buffer.end();) {
+            const key_type key = _key_extract(*begin);
+            auto end = begin + 1;
+            for (; end != _buffer.end() && _key_extract(*end) == key; ++end) {}
+
+            if (end - begin > 1 && !std::is_sorted(begin, end, _cmp))
+                std::sort(begin, end, _cmp);
+
+            begin = end;
+        }
+
+        assert(std::is_sorted(_buffer.cbegin(), _buffer.cend(), _cmp));
+    }
+
+    void _flush_buffer() {
+        if (_buffer.empty())
+            return;
+
+        _sort_buffer();
+
+        if (!_runs_creator)
+            _runs_creator.reset(new runs_creator_type(_cmp, _memory / 4));
+
+        for (const auto & value : _buffer)
+            _runs_creator->push(value);
+        _runs_creator->finish();
+
+        _buffer.clear();
+        _max_key = 0;
+    }
+
+public:
+    IntSorter(const CompareType & cmp, size_t memory, const KeyExtract & key_extract = KeyExtract())
+        : _cmp(cmp)
+        , _key_extract(key_extract)
+        , _memory(memory)
+        // the radix sort requires a second buffer of the same size
+        , _buffer_capacity(std::max<size_t>(1, memory / 4 / sizeof(ValueType)))
+        , _state(Pushing)
+        , _max_key(0)
+        , _buffer_pos(0)
+        , _size(0)
+    { }
+
+    IntSorter(const IntSorter &) = delete;
+
+    void push(const value_type & value) {
+        assert(_state == Pushing);
+
+        if (UNLIKELY(_buffer.size() == _buffer_capacity))
+            _flush_buffer();
+
+        if (UNLIKELY(_buffer.capacity() == 0))
+            _buffer.reserve(_buffer_capacity);
+
+        _max_key = std::max(_max_key, _key_extract(value));
+        _buffer.push_back(value);
+        _size++;
+    }
+
+    //! Finishes the input and switches to the output phase
+    void sort() {
+        assert(_state == Pushing);
+
+        if (!_runs_creator) {
+            _sort_buffer();
+            _buffer_pos = 0;
+            _state = ReadingBuffer;
+            return;
+        }
+
+        _flush_buffer();
+        std::vector<ValueType>().swap(_buffer);
+
+        _runs_merger.reset(new runs_merger_type(_cmp, _memory / 2));
+        _runs_merger->initialize(_runs_creator->result());
+        _state = ReadingRuns;
+    }
+
+    //! Removes all elements and returns to the input phase
+    void clear() {
+        _runs_merger.reset();
+        _runs_creator.reset();
+        _buffer.clear();
+        _max_key = 0;
+        _buffer_pos = 0;
+        _size = 0;
+        _state = Pushing;
+    }
+
+    //! Number of elements pushed, or not yet consumed in the output phase
+    size_t size() const {
+        switch (_state) {
+            case ReadingBuffer: return _buffer.size() - _buffer_pos;
+            case ReadingRuns:   return _runs_merger->size();
+            default:            return _size;
+        }
+    }
+
+//! @name STXXL Streaming Interface
+//! @{
+    bool empty() const {
+        return !size();
+    }
+
+    const value_type & operator*() const {
+        assert(!empty());
+        return _state == ReadingBuffer ? _buffer[_buffer_pos] : **_runs_merger;
+    }
+
+    const value_type * operator->() const {
+        return &operator*();
+    }
+
+    IntSorter & operator++() {
+        assert(!empty());
+        if (_state == ReadingBuffer) {
+            ++_buffer_pos;
+        } else {
+            ++(*_runs_merger);
+        }
+        return *this;
+    }
+//! @}
+};
@@ -0,0 +1,328 @@
+#pragma once
+/**
+ * @file
+ * @brief  Priority queue for monotone integer keys based on key windows
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <stxxl/vector>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include <defs.h>
+
+/**
+ * @brief Drop-in replacement of the STXXL priority queue for monotone integer keys
+ *
+ * The interface and the comparator convention follow stxxl::priority_queue: the
+ * comparator is "less priority", i.e. top() is the element x for which
+ * cmp(x, y) is false for all other y. KeyExtract maps an element to an integer
+ * key which has to be monotonic w.r.t. the priority, and pushed elements must
+ * not have a smaller key than the last element popped (as it is the case for
+ * messages sent to later swaps).
+ *
+ * Keys are grouped into windows of window_keys consecutive keys. Elements of
+ * future windows are appended unsorted to the buffer of their window; if these
+ * buffers exceed the memory budget, they are written as a single sorted run to
+ * external memory. Once all elements of the current window are consumed, the
+ * next non-empty window is gathered from its buffer and the prefixes of the runs
+ * when its first element is popped, and it is sorted by counting its keys.
+ * Elements pushed into the current window go into a small binary heap.
+ */
+template <typename ValueType, typename CompareType, typename KeyExtract,
+          unsigned BlockSize = STXXL_DEFAULT_BLOCK_SIZE(ValueType)>
+class MonotoneBucketPQ {
+public:
+    using value_type = ValueType;
+    using comparator_type = CompareType;
+    using size_type = uint64_t;
+    using key_type = uint64_t;
+
+protected:
+    using RunVector = typename stxxl::VECTOR_GENERATOR<ValueType, 1, 1, BlockSize>::result;
+
+    struct Run {
+        RunVector data;
+        std::unique_ptr<typename RunVector::bufreader_type> reader;
+    };
+
+    struct WindowBuffer {
+        std::vector<ValueType> values; ///< unsorted
+        ValueType min;
+    };
+
+    CompareType _cmp;
+    KeyExtract _key_extract;
+    const size_t _max_buffered;
+    const key_type _window_keys;
+
+    size_type _size;
+
+    // current window [_window_begin, _window_begin + _window_keys)
+    bool _active;
+    key_type _window_begin;
+    std::vector<ValueType> _current; ///< sorted by ascending priority
+    size_t _current_pos;
+    std::priority_queue<ValueType, std::vector<ValueType>, CompareType> _late;
+
+    // future windows
+    std::map<key_type, WindowBuffer> _buffers; ///< indexed by window
+    size_t _buffered;
+    std::vector<std::unique_ptr<Run>> _runs;
+    constexpr static size_t _max_runs = 16;
+
+    // sorting
+    std::vector<ValueType> _sort_tmp;
+    std::vector<uint32_t> _key_counts;
+
+    // statistics
+    uint64_t _stat_spilled;
+    uint64_t _stat_windows;
+
+    key_type _window(const ValueType & value) const {
+        return _key_extract(value) / _window_keys;
+    }
+
+    //! Ascending priority, i.e. the order in which elements are popped
+    bool _before(const ValueType & a, const ValueType & b) const {
+        return _cmp(b, a);
+    }
+
+    bool _current_empty() const {
+        return _current_pos == _current.size() && _late.empty();
+    }
+
+    //! Sorts the elements of one window: counting sort by key, then ties by the comparator
+    void _sort_window(std::vector<ValueType> & values) {
+        if (values.size() < _window_keys / 8) {
+            std::sort(values.begin(), values.end(), [this] (const ValueType & a, const ValueType & b) {return _before(a, b);});
+            return;
+        }
+
+        _key_counts.assign(_window_keys + 1, 0);
+        for (const auto & v : values)
+            _key_counts[_key_extract(v) - _window_begin + 1]++;
+        for (key_type k = 1; k <= _window_keys; ++k)
+            _key_counts[k] += _key_counts[k - 1];
+
+        _sort_tmp.resize(values.size());
+        for (const auto & v : values)
+            _sort_tmp[_key_counts[_key_extract(v) - _window_begin]++] = v;
+        std::swap(values, _sort_tmp);
+
+        // _key_counts[k] now is the end of key k
+        size_t begin = 0;
+        for (key_type k = 0; k < _window_keys; ++k) {
+            const size_t end = _key_counts[k];
+            if (end - begin > 1)
+                std::sort(values.begin() + begin, values.begin() + end, [this] (const ValueType & a, const ValueType & b) {return _before(a, b);});
+            begin = end;
+        }
+    }
+
+    //! Writes all buffered elements of future windows as one sorted run
+    void _spill() {
+        std::unique_ptr<Run> run(new Run);
+        {
+            typename RunVector::bufwriter_type writer(run->data);
+            for (auto & it : _buffers) {
+                auto & values = it.second.values;
+                std::sort(values.begin(), values.end(), [this] (const ValueType & a, const ValueType & b) {return _before(a, b);});
+                for (const auto & v : values)
+                    writer << v;
+            }
+            writer.finish();
+        }
+
+        _stat_spilled += _buffered;
+        _buffers.clear();
+        _buffered = 0;
+
+        run->reader.reset(new typename RunVector::bufreader_type(run->data));
+        _runs.push_back(std::move(run));
+
+        if (_runs.size() > _max_runs)
+            _merge_runs();
+    }
+
+    //! Replaces all runs by a single one to bound the memory of the run readers
+    void _merge_runs() {
+        auto later = [this] (const Run* a, const Run* b) {return _before(**b->reader, **a->reader);};
+        std::priority_queue<Run*, std::vector<Run*>, decltype(later)> heads(later);
+        for (auto & run : _runs)
+            heads.push(run.get());
+
+        std::unique_ptr<Run> merged(new Run);
+        {
+            typename RunVector::bufwriter_type writer(merged->data);
+            while (!heads.empty()) {
+                Run* run = heads.top();
+                heads.pop();
+
+                writer << **run->reader;
+                ++*run->reader;
+                if (!run->reader->empty())
+                    heads.push(run);
+            }
+            writer.finish();
+        }
+
+        _runs.clear();
+        merged->reader.reset(new typename RunVector::bufreader_type(merged->data));
+        _runs.push_back(std::move(merged));
+    }
+
+    //! Smallest element of the future windows; requires _current_empty()
+    const ValueType & _future_top() const {
+        const ValueType * result = _buffers.empty() ? nullptr : &_buffers.begin()->second.min;
+        for (const auto & run : _runs) {
+            const ValueType & head = **run->reader;
+            if (!result || _before(head, *result))
+                result = &head;
+        }
+        assert(result);
+        return *result;
+    }
+
+    //! Makes the next non-empty window the current one; requires _current_empty()
+    void _activate_next_window() {
+        assert(_current_empty());
+        assert(_size > 0);
+
+        key_type window = std::numeric_limits<key_type>::max();
+        if (!_buffers.empty())
+            window = _buffers.begin()->first;
+        for (const auto & run : _runs)
+            window = std::min(window, _window(**run->reader));
+
+        _active = true;
+        _window_begin = window * _window_keys;
+        _current.clear();
+        _current_pos = 0;
+
+        auto it = _buffers.find(window);
+        if (it != _buffers.end()) {
+            std::swap(_current, it->second.values);
+            _buffered -= _current.size();
+            _buffers.erase(it);
+        }
+
+        // runs are sorted; consume their prefixes belonging to the window
+        for (auto & run : _runs) {
+            auto & reader = *run->reader;
+            for (; !reader.empty() && _window(*reader) == window; ++reader)
+                _current.push_back(*reader);
+        }
+        _runs.erase(std::remove_if(_runs.begin(), _runs.end(), [] (const std::unique_ptr<Run> & run) {return run->reader->empty();}), _runs.end());
+
+        assert(!_current.empty());
+        _sort_window(_current);
+        _stat_windows++;
+    }
+
+public:
+    //! @param bytes  Memory for elements of future windows before they are spilled
+    //! @param window_keys  Number of consecutive keys sorted together
+    explicit MonotoneBucketPQ(size_t bytes, key_type window_keys = key_type(1) << 16,
+                              const CompareType & cmp = CompareType(), const KeyExtract & key_extract = KeyExtract())
+        : _cmp(cmp)
+        , _key_extract(key_extract)
+        , _max_buffered(std::max<size_t>(1, bytes / sizeof(ValueType)))
+        , _window_keys(std::max<key_type>(1, window_keys))
+        , _size(0)
+        , _active(false)
+        , _window_begin(0)
+        , _current_pos(0)
+        , _late(cmp)
+        , _buffered(0)
+        , _stat_spilled(0)
+        , _stat_windows(0)
+    {}
+
+    MonotoneBucketPQ(const MonotoneBucketPQ &) = delete;
+
+    bool empty() const {
+        return !_size;
+    }
+
+    size_type size() const {
+        return _size;
+    }
+
+    void push(const ValueType & value) {
+        _size++;
+
+        const key_type key = _key_extract(value);
+        if (_active && key < _window_begin + _window_keys) {
+            assert(key >= _window_begin);
+            _late.push(value);
+            return;
+        }
+
+        WindowBuffer & buffer = _buffers[key / _window_keys];
+        if (buffer.values.empty() || _before(value, buffer.min))
+            buffer.min = value;
+        buffer.values.push_back(value);
+
+        if (++_buffered > _max_buffered)
+            _spill();
+    }
+
+    const ValueType & top() const {
+        assert(!empty());
+        if (_current_empty())
+            return _future_top();
+        if (_current_pos == _current.size())
+            return _late.top();
+        if (_late.empty() || _before(_current[_current_pos], _late.top()))
+            return _current[_current_pos];
+        return _late.top();
+    }
+
+    void pop() {
+        assert(!empty());
+
+        // windows are only activated once their first element is popped as
+        // the element popped bounds the keys of future pushes
+        if (_current_empty())
+            _activate_next_window();
+
+        if (_current_pos == _current.size()
+            || (!_late.empty() && !_before(_current[_current_pos], _late.top()))) {
+            _late.pop();
+        } else {
+            _current_pos++;
+        }
+
+        _size--;
+    }
+
+    //! Removes all elements
+    void clear() {
+        _size = 0;
+        _active = false;
+        _current.clear();
+        _current_pos = 0;
+        _late = decltype(_late)(_cmp);
+        _buffers.clear();
+        _buffered = 0;
+        _runs.clear();
+    }
+
+    //! Number of elements written to external memory so far
+    uint64_t spilledElements() const {
+        return _stat_spilled;
+    }
+
+    //! Number of windows sorted so far
+    uint64_t sortedWindows() const {
+        return _stat_windows;
+    }
+};
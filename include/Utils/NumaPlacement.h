@@ -0,0 +1,228 @@
+#pragma once
+/**
+ * @file
+ * @brief  NUMA-aware placement of the threads of the parallel engines
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Pins the threads of a parallel region to the NUMA nodes of the machine
+ *
+ * Thread tid of a team of num_threads threads is assigned to node
+ * tid * num_nodes / num_threads, i.e. consecutive threads share a socket and every
+ * socket gets the same number of threads. The placement only depends on tid, so
+ * per-thread state that is allocated (first-touched) by thread tid in one parallel
+ * region stays local to thread tid in all later regions, even though OpenMP may
+ * hand the team ids to different OS threads.
+ *
+ * The topology is read from sysfs (/sys/devices/system/node); without it, or if
+ * placement is disabled, all calls are no-ops. Threads are bound to all cores of
+ * their node rather than a single core so that nested parallelism and helper
+ * threads still have room on the socket.
+ */
+class NumaPlacement {
+public:
+    //! Page allocation counters of a node (see /sys/devices/system/node/node*/numastat)
+    struct NodeCounters {
+        uint64_t local_node = 0; ///< pages allocated on this node by a thread running on it
+        uint64_t other_node = 0; ///< pages allocated on this node by a thread running on another node
+    };
+
+    /**
+     * @brief Binds the calling thread to its node for the lifetime of the object
+     *
+     * Put at the beginning of a parallel region; the previous affinity is restored
+     * at its end, so threads created later (e.g. by the master thread) do not
+     * inherit the binding.
+     */
+    class ThreadPin {
+    #ifdef __linux__
+        cpu_set_t _previous;
+    #endif
+        bool _pinned;
+
+    public:
+        ThreadPin(int tid, int num_threads)
+            : _pinned(false)
+        {
+        #ifdef __linux__
+            const NumaPlacement & placement = NumaPlacement::instance();
+            if (!placement.enabled())
+                return;
+
+            if (pthread_getaffinity_np(pthread_self(), sizeof(_previous), &_previous))
+                return;
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (const unsigned int cpu : placement.cpusOfNode(placement.nodeOfThread(tid, num_threads)))
+                CPU_SET(cpu, &set);
+
+            _pinned = !pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        #else
+            (void)tid;
+            (void)num_threads;
+        #endif
+        }
+
+        ~ThreadPin() {
+        #ifdef __linux__
+            if (_pinned)
+                pthread_setaffinity_np(pthread_self(), sizeof(_previous), &_previous);
+        #endif
+        }
+
+        ThreadPin(const ThreadPin &) = delete;
+    };
+
+protected:
+    const bool _enabled;
+    std::vector<unsigned int> _nodes; ///< ids of the nodes having cpus
+    std::vector<std::vector<unsigned int>> _node_cpus;
+
+    static bool& _config() {
+        static bool enabled = false;
+        return enabled;
+    }
+
+    //! Parses lists as "0-3,8-11" used by sysfs
+    static std::vector<unsigned int> _parse_list(const std::string & list) {
+        std::vector<unsigned int> result;
+        std::istringstream is(list);
+        for (std::string range; std::getline(is, range, ','); ) {
+            if (range.empty() || range == "\n")
+                continue;
+
+            const auto dash = range.find('-');
+            const unsigned int first = std::stoul(range.substr(0, dash));
+            const unsigned int last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+            for (unsigned int i = first; i <= last; ++i)
+                result.push_back(i);
+        }
+        return result;
+    }
+
+    static std::string _read_line(const std::string & path) {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    explicit NumaPlacement(bool enabled)
+        : _enabled(enabled)
+    {
+        for (const unsigned int node : _parse_list(_read_line("/sys/devices/system/node/online"))) {
+            auto cpus = _parse_list(_read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+            if (cpus.empty())
+                continue; // memory-only node
+
+            _nodes.push_back(node);
+            _node_cpus.push_back(std::move(cpus));
+        }
+
+        if (_nodes.empty()) {
+            // no sysfs; treat the machine as a single node
+            _nodes.push_back(0);
+            _node_cpus.emplace_back();
+            for (unsigned int cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                _node_cpus.back().push_back(cpu);
+        }
+    }
+
+public:
+    //! Enables placement; only effective if called before the first use of instance()
+    static void configure(bool enable) {
+        _config() = enable;
+    }
+
+    static const NumaPlacement & instance() {
+        static NumaPlacement placement(_config());
+        return placement;
+    }
+
+    NumaPlacement(const NumaPlacement &) = delete;
+
+    //! Placement is only worthwhile with more than one node
+    bool enabled() const {
+        return _enabled && _nodes.size() > 1;
+    }
+
+    unsigned int numNodes() const {
+        return _nodes.size();
+    }
+
+    //! Index (not sysfs id) of the node thread tid is placed on
+    unsigned int nodeOfThread(int tid, int num_threads) const {
+        if (num_threads <= 0)
+            return 0;
+        return static_cast<unsigned int>(static_cast<uint64_t>(tid) * _nodes.size() / num_threads);
+    }
+
+    const std::vector<unsigned int> & cpusOfNode(unsigned int node) const {
+        return _node_cpus[node];
+    }
+
+//! @name Allocation counters
+//! @{
+    //! Current counters of all nodes; empty without sysfs
+    std::vector<NodeCounters> counters() const {
+        std::vector<NodeCounters> result;
+        for (const unsigned int node : _nodes) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/numastat");
+            if (!in)
+                return {};
+
+            NodeCounters counters;
+            std::string key;
+            uint64_t value;
+            while (in >> key >> value) {
+                if (key == "local_node") counters.local_node = value;
+                if (key == "other_node") counters.other_node = value;
+            }
+            result.push_back(counters);
+        }
+        return result;
+    }
+
+    //! Prints the pages allocated on each node since begin (obtained by counters())
+    void reportCounters(std::ostream & os, const std::vector<NodeCounters> & begin) const {
+        const auto end = counters();
+        if (end.size() != begin.size())
+            return;
+
+        uint64_t local = 0;
+        uint64_t other = 0;
+        for (size_t i = 0; i < end.size(); ++i) {
+            const uint64_t node_local = end[i].local_node - begin[i].local_node;
+            const uint64_t node_other = end[i].other_node - begin[i].other_node;
+            os << "NUMA node " << _nodes[i]
+               << " local_pages " << node_local
+               << " remote_pages " << node_other
+               << std::endl;
+            local += node_local;
+            other += node_other;
+        }
+
+        os << "NUMA local page fraction " << std::setprecision(4)
+           << (local + other ? static_cast<double>(local) / (local + other) : 1.0)
+           << std::endl;
+    }
+//! @}
+};
@@ -0,0 +1,73 @@
+#pragma once
+/**
+ * @file
+ * @brief  Counter-based derivation of independent random streams from a master seed
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <defs.h>
+#include <limits>
+
+//! Finalizer of SplitMix64; a bijection on 64 bit integers with good avalanche behaviour
+inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Derives seeds of random streams identified by (phase, index) from a master seed
+ *
+ * In contrast to stxxl::get_next_seed(), the seed of a stream depends neither on
+ * the order in which streams are requested nor on the number of threads requesting
+ * them. Parallel code should, hence, derive one stream per unit of work (e.g. per
+ * community) instead of per thread.
+ */
+class RandomSeeds {
+    uint64_t _master;
+
+public:
+    explicit RandomSeeds(uint64_t master) : _master(splitmix64(master)) {}
+
+    //! Key of the stream (phase, index), can be used as seed of a 64 bit engine
+    uint64_t key(uint64_t phase, uint64_t index = 0) const {
+        return splitmix64(splitmix64(_master ^ splitmix64(phase)) + index);
+    }
+
+    //! Non-zero seed of the stream (phase, index); zero is reserved for "draw a seed" in several classes
+    seed_t operator()(uint64_t phase, uint64_t index = 0) const {
+        const seed_t seed = static_cast<seed_t>(key(phase, index) >> 32);
+        return seed ? seed : 1;
+    }
+
+    //! Independent seeds for the sub-streams of the stream (phase, index)
+    RandomSeeds substreams(uint64_t phase, uint64_t index = 0) const {
+        return RandomSeeds(key(phase, index));
+    }
+};
+
+/**
+ * @brief Counter-based SplitMix64 engine
+ *
+ * Cheap to construct; intended for short streams such as a single trade, where
+ * each stream is seeded with RandomSeeds::key.
+ */
+class SplitMix64Engine {
+    uint64_t _state;
+
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64Engine(uint64_t seed) : _state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t x = _state;
+        _state += 0x9e3779b97f4a7c15ull;
+        return splitmix64(x);
+    }
+};
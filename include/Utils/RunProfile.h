@@ -0,0 +1,207 @@
+#pragma once
+/**
+ * @file
+ * @brief  Machine-readable per-run records of the swap engines
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <stxxl/stats>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Collects the phases and counters of a run and writes them as one JSON line
+ *
+ * Every phase records its wall time and the I/O volume reported by stxxl::stats
+ * between beginPhase() and the next beginPhase() or endRun(). Since stxxl::stats
+ * is global, I/O of concurrent tasks (e.g. the pipelined write-back) is included.
+ * Counters are named integers or doubles, e.g. sorter sizes or rejected swaps.
+ *
+ * The profile is disabled unless an output stream is set; then all calls return
+ * immediately. Phase and counter names have to be string literals. Several
+ * profiles may share an output stream; the records are written under a global lock.
+ *
+ * Example line:
+ * {"engine":"EdgeSwapTFP","run":3,"seconds":1.5,"read_bytes":0,"written_bytes":0,
+ *  "phases":{"simulate_swaps":{"seconds":0.4,"read_bytes":0,"written_bytes":0}},
+ *  "swaps":1000,"performed":998}
+ */
+class RunProfile {
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Phase {
+        const char* name;
+        double seconds;
+        uint64_t read_bytes;
+        uint64_t written_bytes;
+    };
+
+    struct Counter {
+        const char* name;
+        uint64_t integer;
+        double real;
+        bool integral;
+    };
+
+    std::ostream* _output;
+
+    const char* _engine;
+    uint64_t _run;
+    bool _in_run;
+
+    Clock::time_point _run_begin;
+    stxxl::stats_data _run_io_begin;
+
+    const char* _phase;
+    Clock::time_point _phase_begin;
+    stxxl::stats_data _phase_io_begin;
+
+    std::vector<Phase> _phases;
+    std::vector<Counter> _counters;
+
+    Counter & _counter(const char* name, bool integral) {
+        for (auto & c : _counters) {
+            if (c.name == name || !strcmp(c.name, name))
+                return c;
+        }
+        _counters.push_back(Counter{name, 0, 0.0, integral});
+        return _counters.back();
+    }
+
+    void _end_phase(const Clock::time_point & now, const stxxl::stats_data & io) {
+        if (!_phase)
+            return;
+
+        const stxxl::stats_data delta = io - _phase_io_begin;
+        _phases.push_back(Phase{_phase,
+                                std::chrono::duration<double>(now - _phase_begin).count(),
+                                delta.get_read_volume(), delta.get_written_volume()});
+        _phase = nullptr;
+    }
+
+    //! Serializes the writes of all profiles, which may share an output stream
+    static std::mutex & _output_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+public:
+    RunProfile()
+        : _output(nullptr), _engine(""), _run(0), _in_run(false), _phase(nullptr)
+    {}
+
+    //! Enables the profile; nullptr disables it
+    void setOutput(std::ostream* output) {
+        _output = output;
+        _in_run = false;
+    }
+
+    bool enabled() const {
+        return _output;
+    }
+
+    void beginRun(const char* engine, uint64_t run) {
+        if (!_output)
+            return;
+
+        _engine = engine;
+        _run = run;
+        _in_run = true;
+        _phases.clear();
+        _counters.clear();
+        _phase = nullptr;
+
+        _run_begin = Clock::now();
+        _run_io_begin = stxxl::stats_data(*stxxl::stats::get_instance());
+    }
+
+    //! Ends the current phase (if any) and starts a new one
+    void beginPhase(const char* name) {
+        if (!_in_run)
+            return;
+
+        const auto now = Clock::now();
+        const stxxl::stats_data io(*stxxl::stats::get_instance());
+        _end_phase(now, io);
+
+        _phase = name;
+        _phase_begin = now;
+        _phase_io_begin = io;
+    }
+
+    void set(const char* name, uint64_t value) {
+        if (!_in_run) return;
+        _counter(name, true).integer = value;
+    }
+
+    void setReal(const char* name, double value) {
+        if (!_in_run) return;
+        _counter(name, false).real = value;
+    }
+
+    void add(const char* name, uint64_t value) {
+        if (!_in_run) return;
+        _counter(name, true).integer += value;
+    }
+
+    //! Keeps the maximum of all values reported for name
+    void max(const char* name, uint64_t value) {
+        if (!_in_run) return;
+        Counter & c = _counter(name, true);
+        c.integer = std::max(c.integer, value);
+    }
+
+    //! Ends the current phase and writes the record of the run
+    void endRun() {
+        if (!_in_run)
+            return;
+
+        const auto now = Clock::now();
+        const stxxl::stats_data io(*stxxl::stats::get_instance());
+        _end_phase(now, io);
+        _in_run = false;
+
+        const stxxl::stats_data run_io = io - _run_io_begin;
+
+        std::ostringstream line;
+        line << std::setprecision(9);
+        line << "{\"engine\":\"" << _engine << "\""
+             << ",\"run\":" << _run
+             << ",\"seconds\":" << std::chrono::duration<double>(now - _run_begin).count()
+             << ",\"read_bytes\":" << run_io.get_read_volume()
+             << ",\"written_bytes\":" << run_io.get_written_volume()
+             << ",\"phases\":{";
+
+        for (size_t i = 0; i < _phases.size(); ++i) {
+            const Phase & p = _phases[i];
+            line << (i ? "," : "") << "\"" << p.name << "\":{"
+                 << "\"seconds\":" << p.seconds
+                 << ",\"read_bytes\":" << p.read_bytes
+                 << ",\"written_bytes\":" << p.written_bytes << "}";
+        }
+        line << "}";
+
+        for (const auto & c : _counters) {
+            line << ",\"" << c.name << "\":";
+            if (c.integral) {
+                line << c.integer;
+            } else {
+                line << c.real;
+            }
+        }
+        line << "}\n";
+
+        std::lock_guard<std::mutex> lock(_output_mutex());
+        *_output << line.str() << std::flush;
+    }
+};
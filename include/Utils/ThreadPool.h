@@ -0,0 +1,324 @@
+#pragma once
+/**
+ * @file
+ * @brief  Process-wide pool of (optionally pinned) worker threads
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Shared worker threads for the helper tasks of the swap engines, AsyncStream and AsyncPusher
+ *
+ * The workers are started on first use and live until the end of the process, so
+ * short runs do not pay for creating threads. Tasks must not block except in
+ * wait(): a thread waiting for a future executes queued tasks of the same owner
+ * (e.g. the engine that submitted them) in the meantime. Hence, tasks may wait for
+ * tasks of their owner even if all workers are busy, while a short wait is not
+ * delayed by long unrelated tasks.
+ *
+ * If profiling is enabled, the number of tasks, their run time and the time they
+ * spent in the queue are accumulated per label.
+ */
+class ThreadPool {
+public:
+    struct TaskStats {
+        uint64_t tasks = 0;
+        double run_seconds = 0.0;
+        double queue_seconds = 0.0;
+    };
+
+protected:
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Task {
+        std::function<void()> function;
+        const char* label;
+        const void* owner;
+        Clock::time_point submitted;
+    };
+
+    const bool _pin;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _task_available;
+    std::deque<Task> _queue;
+    bool _stopping;
+
+    std::atomic<bool> _profiling;
+    std::mutex _stats_mutex;
+    std::map<std::string, TaskStats> _stats;
+
+    ThreadPool(unsigned int num_threads, bool pin)
+        : _pin(pin)
+        , _stopping(false)
+        , _profiling(false)
+    {
+        if (!num_threads)
+            num_threads = std::max(2u, std::thread::hardware_concurrency());
+
+        for (unsigned int i = 0; i < num_threads; ++i)
+            _workers.emplace_back(&ThreadPool::_worker_main, this, i);
+    }
+
+    static std::pair<unsigned int, bool>& _config() {
+        static std::pair<unsigned int, bool> config(0, false);
+        return config;
+    }
+
+    void _pin_thread(unsigned int index) {
+    #ifdef __linux__
+        const unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    #else
+        (void)index;
+    #endif
+    }
+
+    void _run(Task & task) {
+        if (!_profiling) {
+            task.function();
+            return;
+        }
+
+        const auto begin = Clock::now();
+        task.function();
+        const auto end = Clock::now();
+
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        TaskStats & stats = _stats[task.label];
+        stats.tasks++;
+        stats.run_seconds += std::chrono::duration<double>(end - begin).count();
+        stats.queue_seconds += std::chrono::duration<double>(begin - task.submitted).count();
+    }
+
+    void _worker_main(unsigned int index) {
+        if (_pin)
+            _pin_thread(index);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _task_available.wait(lock, [this] {return _stopping || !_queue.empty();});
+            if (_queue.empty())
+                return;
+
+            Task task = std::move(_queue.front());
+            _queue.pop_front();
+
+            lock.unlock();
+            _run(task);
+            lock.lock();
+        }
+    }
+
+    //! Executes the oldest queued task of owner in the calling thread; false if there is none
+    bool _run_pending(const void* owner) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = std::find_if(_queue.begin(), _queue.end(), [owner] (const Task & t) {return t.owner == owner;});
+            if (it == _queue.end())
+                return false;
+
+            task = std::move(*it);
+            _queue.erase(it);
+        }
+
+        _run(task);
+        return true;
+    }
+
+public:
+    //! Sets the number of workers (0 = one per hardware thread) and whether worker i is
+    //! pinned to core i; only effective if called before the first use of instance()
+    static void configure(unsigned int num_threads, bool pin) {
+        _config() = std::make_pair(num_threads, pin);
+    }
+
+    static ThreadPool & instance() {
+        static ThreadPool pool(_config().first, _config().second);
+        return pool;
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _task_available.notify_all();
+
+        for (auto & worker : _workers)
+            worker.join();
+    }
+
+    unsigned int numThreads() const {
+        return _workers.size();
+    }
+
+    //! Schedules function(); label has to be a string literal, owner groups the tasks
+    //! that wait() may execute
+    template <typename Function>
+    auto submit(Function && function, const char* label = "task", const void* owner = nullptr) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(Task{[task] () {(*task)();}, label, owner, Clock::now()});
+        }
+        _task_available.notify_one();
+
+        return result;
+    }
+
+    //! Returns future.get() and executes queued tasks of owner while the future is not ready;
+    //! the task of the future has to be submitted with the same owner
+    template <typename Future>
+    auto wait(Future & future, const void* owner = nullptr) -> decltype(future.get()) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!_run_pending(owner))
+                future.wait_for(std::chrono::microseconds(100));
+        }
+
+        return future.get();
+    }
+
+//! @name Profiling
+//! @{
+    void setProfiling(bool enable) {
+        _profiling = enable;
+    }
+
+    std::map<std::string, TaskStats> stats() {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        return _stats;
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats.clear();
+    }
+
+    void reportStats(std::ostream & os) {
+        for (const auto & it : stats()) {
+            os << "ThreadPool task " << std::setw(24) << std::left << it.first << std::right
+               << " count " << it.second.tasks
+               << " run " << it.second.run_seconds << "s"
+               << " queued " << it.second.queue_seconds << "s"
+               << std::endl;
+        }
+    }
+//! @}
+};
+
+/**
+ * @brief Executes tasks one after another in submission order on the ThreadPool
+ *
+ * Used for targets that are not thread-safe, e.g. an STXXL runs creator fed by
+ * several producers. At most one task of the queue is running at any time; no
+ * worker is occupied while the queue is empty.
+ */
+class SerialTaskQueue {
+    ThreadPool & _pool;
+    const char* _label;
+
+    std::mutex _mutex;
+    std::deque<std::function<void()>> _tasks;
+    bool _scheduled;
+    std::shared_future<void> _drain;
+
+    void _drain_tasks() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_tasks.empty()) {
+                    _scheduled = false;
+                    return;
+                }
+
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+public:
+    explicit SerialTaskQueue(const char* label = "serial", ThreadPool & pool = ThreadPool::instance())
+        : _pool(pool), _label(label), _scheduled(false)
+    {}
+
+    SerialTaskQueue(const SerialTaskQueue &) = delete;
+
+    ~SerialTaskQueue() {
+        waitAll();
+    }
+
+    template <typename Function>
+    auto submit(Function && function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.emplace_back([task] () {(*task)();});
+        if (!_scheduled) {
+            _scheduled = true;
+            _drain = _pool.submit([this] () {_drain_tasks();}, _label, this).share();
+        }
+
+        return result;
+    }
+
+    //! Returns future.get() of a task submitted to this queue
+    template <typename Future>
+    auto wait(Future & future) -> decltype(future.get()) {
+        return _pool.wait(future, this);
+    }
+
+    //! Waits until all submitted tasks are completed
+    void waitAll() {
+        while (true) {
+            std::shared_future<void> drain;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_scheduled)
+                    return;
+                drain = _drain;
+            }
+            _pool.wait(drain, this);
+        }
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+/**
+ * @file
+ * @brief  Bounded lock-free work-stealing deque
+ * @author Michael Hamann
+ * @copyright to be decided
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Chase-Lev deque of trivially copyable values with a fixed capacity
+ *
+ * The owner thread pushes and pops at the bottom (LIFO, i.e. cache-warm items
+ * first) while any other thread may steal from the top. This follows the C11
+ * formulation of Lê, Pop, Cohen and Zappa Nardelli ("Correct and Efficient
+ * Work-Stealing for Weak Memory Models", PPoPP 2013), except that the buffer is
+ * never grown: push() fails if the deque is full and the owner has to keep the
+ * item elsewhere. The indices only grow, so there is no ABA problem.
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque requires trivially copyable values");
+
+    const int64_t _mask;
+    std::unique_ptr<std::atomic<T>[]> _buffer;
+
+    // top and bottom are written by different threads; keep them on separate cache lines
+    std::atomic<int64_t> _top;
+    char _padding[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> _bottom;
+
+    static int64_t _capacity(int64_t min_capacity) {
+        int64_t capacity = 1;
+        while (capacity < min_capacity)
+            capacity *= 2;
+        return capacity;
+    }
+
+public:
+    //! The capacity is rounded up to the next power of two
+    explicit WorkStealingDeque(int64_t min_capacity = 1 << 16)
+        : _mask(_capacity(min_capacity) - 1)
+        , _buffer(new std::atomic<T>[_mask + 1])
+        , _top(0)
+        , _bottom(0)
+    {}
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+
+    int64_t capacity() const {
+        return _mask + 1;
+    }
+
+    //! Approximate number of items; exact only if no other thread accesses the deque
+    int64_t size() const {
+        return std::max<int64_t>(0, _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed));
+    }
+
+    //! Owner only; returns false if the deque is full
+    bool push(const T & value) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        if (b - t > _mask)
+            return false;
+
+        _buffer[b & _mask].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! Owner only; takes the item pushed last
+    bool pop(T & value) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // empty
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        value = _buffer[b & _mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last item; race against thieves
+            const bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    //! Any thread; takes the oldest item. May fail spuriously if it races with another thread.
+    bool steal(T & value) {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return false;
+
+        value = _buffer[t & _mask].load(std::memory_order_relaxed);
+        return _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
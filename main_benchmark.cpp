@@ -3,6 +3,7 @@
 //
 
 #include <iostream>
+#include <fstream>
 #include <chrono>
 
 #include <algorithm>
@@ -19,6 +20,7 @@
 
 #include <Utils/IOStatistics.h>
 #include <Utils/ScopedTimer.hpp>
+#include <Utils/ThreadPool.h>
 
 #include <Utils/MonotonicPowerlawRandomStream.h>
 #include <HavelHakimi/HavelHakimiIMGenerator.h>
@@ -30,10 +32,12 @@
 #include "SwapGenerator.h"
 
 #include <EdgeSwaps/EdgeSwapTFP.h>
+#include <EdgeSwaps/SwapConvergenceMonitor.h>
 
 #include <ConfigurationModel/ConfigurationModelRandom.h>
 #include <SwapStream.h>
 #include <EdgeSwaps/ModifiedEdgeSwapTFP.h>
+#include <EdgeSwaps/ModifiedEdgeSwapParallelTFP.h>
 #include <Utils/ExportGraph.h>
 
 struct RunConfig {
@@ -78,6 +82,21 @@ struct RunConfig {
     unsigned int edgeSizeFactor;
 
     double randomSwapsInCMES;
+    bool parallelCMES;
+
+    bool stopOnConvergence;
+
+    bool pipelined;
+
+    stxxl::uint64 existenceFilter;
+    stxxl::uint64 hubCache;
+    double updateLog;
+
+    unsigned int poolThreads;
+    bool pinThreads;
+    bool profileTasks;
+
+    std::string runProfile;
 
     RunConfig()
             : numNodes(10 * IntScale::Mi)
@@ -99,6 +118,15 @@ struct RunConfig {
             , noRuns(8)
             , edgeSizeFactor(1)
             , randomSwapsInCMES(0)
+            , parallelCMES(false)
+            , stopOnConvergence(false)
+            , pipelined(false)
+            , existenceFilter(0)
+            , hubCache(0)
+            , updateLog(0)
+            , poolThreads(0)
+            , pinThreads(false)
+            , profileTasks(false)
     {
         using myclock = std::chrono::high_resolution_clock;
         myclock::duration d = myclock::now() - myclock::time_point::min();
@@ -132,7 +160,7 @@ struct RunConfig {
             cp.add_uint  (CMDLINE_COMP('S', "degree-seed",  degreeDistrSeed, "Initial seed for PRNG of degree distr"));
 
             cp.add_bytes (CMDLINE_COMP('m', "num-swaps", numSwaps,   "Number of swaps to perform"));
-            cp.add_bytes (CMDLINE_COMP('r', "run-size", runSize, "Number of swaps per graph scan"));
+            cp.add_bytes (CMDLINE_COMP('r', "run-size", runSize, "Number of swaps per graph scan; 0 derives it from the internal memory and adapts it per run (EM-ES, requires -y 0)"));
             cp.add_bytes (CMDLINE_COMP('k', "batch-size", batchSize, "Batch size of PTFP"));
 
             cp.add_bytes (CMDLINE_COMP('i', "ram", internalMem, "Internal memory"));
@@ -141,10 +169,20 @@ struct RunConfig {
 
             cp.add_double(CMDLINE_COMP('x', "factor-swaps",     factorNoSwaps,    "Overwrite -m = noEdges * x"));
             cp.add_uint  (CMDLINE_COMP('y', "no-runs",      noRuns,   "Overwrite r = m / y  + 1"));
+            cp.add_flag  (CMDLINE_COMP('T', "stop-converged", stopOnConvergence, "Stop swapping once assortativity and untouched edges flatten out; -m is an upper bound"));
+            cp.add_flag  (CMDLINE_COMP('P', "pipelined", pipelined, "Overlap the write-back of a run with the scan of the next one (EM-ES)"));
+            cp.add_bytes (CMDLINE_COMP('F', "existence-filter", existenceFilter, "Memory of a Bloom filter dropping existence requests of missing edges; default: 0 (off, EM-ES)"));
+            cp.add_bytes (CMDLINE_COMP('U', "hub-cache", hubCache, "Memory of the adjacency lists of high degree nodes answering existence requests; default: 0 (off, EM-ES)"));
+            cp.add_double(CMDLINE_COMP('L', "update-log", updateLog, "Keep updates as deltas and rewrite the edges once they exceed this fraction; default: 0 (off, EM-ES)"));
+            cp.add_uint  (CMDLINE_COMP('t', "pool-threads", poolThreads, "Worker threads of the shared thread pool; default: 0 (one per hardware thread)"));
+            cp.add_flag  (CMDLINE_COMP('p', "pin-threads", pinThreads, "Pin the workers of the thread pool to cores"));
+            cp.add_flag  (CMDLINE_COMP('R', "profile-tasks", profileTasks, "Report the run and queueing time of the thread pool tasks"));
+            cp.add_string(CMDLINE_COMP('J', "run-profile", runProfile, "Append one JSON line per swap run (time, I/O, sorter sizes, rejected swaps) to this file"));
 
             cp.add_flag  (CMDLINE_COMP('H', "input-hh",    input_hh,          "use Havel Hakimi; default"));
             cp.add_flag  (CMDLINE_COMP('c', "input-cm",    input_cm,          "use Configuration Model + Rewiring"));
             cp.add_double(CMDLINE_COMP('C', "cmes-random", randomSwapsInCMES, "Include X*|E| random swaps during CMES rewiring steps; default: 0"));
+            cp.add_flag  (CMDLINE_COMP('E', "cmes-parallel", parallelCMES,   "Remove illegal edges of CMES with the parallel multigraph swaps"));
 
             cp.add_string(CMDLINE_COMP('A', "snapshots-at", snapshotsAt, "comma-sep list of phases, start:stop:step as in python allows"));
 
@@ -184,6 +222,11 @@ struct RunConfig {
             return false;
         }
 
+        if (!runSize && !noRuns && !snapshotsAt.empty()) {
+            std::cerr << "Snapshots refer to runs and hence need a fixed run size" << std::endl;
+            return false;
+        }
+
         if (scaleDegree * minDeg < 1.0) {
             std::cerr << "Scaling the minimum degree must yield at least 1.0" << std::endl;
             return false;
@@ -284,6 +327,11 @@ void benchmark(RunConfig & config) {
     stxxl::stats *stats = stxxl::stats::get_instance();
     stxxl::stats_data stats_begin(*stats);
 
+    std::ofstream run_profile;
+    if (!config.runProfile.empty())
+        run_profile.open(config.runProfile, std::ios::app);
+    std::ostream* run_profile_output = run_profile.is_open() ? &run_profile : nullptr;
+
     // Load or generate edge list
     EdgeStream edge_stream;
     {
@@ -322,44 +370,57 @@ void benchmark(RunConfig & config) {
                 {
                     IOStatistics swap_report("ES for CM");
 
-                    ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP init_algo(edge_stream, config.runSize, config.numNodes,
-                                                                       config.internalMem);
+                    const swapid_t run_length = config.runSize ? config.runSize : config.numNodes / 10;
 
-                    EdgeToEdgeSwapPusher<decltype(cmhh_gen), EdgeStream, ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP>
-                            cm_to_emes_pusher(cmhh_gen, edge_stream, init_algo);
-                    edge_stream.consume();
+                    auto remove_illegal_edges = [&] (auto & init_algo) {
+                        using init_algo_t = typename std::remove_reference<decltype(init_algo)>::type;
+                        init_algo.setRunProfile(run_profile_output);
 
+                        EdgeToEdgeSwapPusher<decltype(cmhh_gen), EdgeStream, init_algo_t>
+                                cm_to_emes_pusher(cmhh_gen, edge_stream, init_algo);
+                        edge_stream.consume();
 
-                    const edgeid_t min_swaps = edge_stream.size() * config.randomSwapsInCMES;
 
+                        const edgeid_t min_swaps = edge_stream.size() * config.randomSwapsInCMES;
 
-                    unsigned int iteration = 0;
-                    while (init_algo.runnable()) {
-                        std::cout << "[CM-ES] Remove illegal edges: Iteration " << ++iteration << std::endl;
-                        std::cout << "Graph contains " << edge_stream.size() << " edges\n"
-                                     "  " << edge_stream.selfloops() << " selfloops\n"
-                                     "  " << edge_stream.multiedges() << " multiedges"
-                        << std::endl;
 
-                        std::cout << "Swaps pending: " << init_algo.swaps_pushed() << std::endl;
+                        unsigned int iteration = 0;
+                        while (init_algo.runnable()) {
+                            std::cout << "[CM-ES] Remove illegal edges: Iteration " << ++iteration << std::endl;
+                            std::cout << "Graph contains " << edge_stream.size() << " edges\n"
+                                         "  " << edge_stream.selfloops() << " selfloops\n"
+                                         "  " << edge_stream.multiedges() << " multiedges"
+                            << std::endl;
 
-                        if (init_algo.swaps_pushed() < min_swaps * 0.75) {
-                            const swapid_t additional_swaps = min_swaps - init_algo.swaps_pushed();
+                            std::cout << "Swaps pending: " << init_algo.swaps_pushed() << std::endl;
 
-                            SwapGenerator swap_gen(additional_swaps, edge_stream.size());
-                            StreamPusher<decltype(swap_gen), decltype(init_algo)>pusher (swap_gen, init_algo);
+                            if (init_algo.swaps_pushed() < min_swaps * 0.75) {
+                                const swapid_t additional_swaps = min_swaps - init_algo.swaps_pushed();
 
-                            std::cout << "Added additional swaps: " << additional_swaps << std::endl;
-                        }
+                                SwapGenerator swap_gen(additional_swaps, edge_stream.size());
+                                StreamPusher<decltype(swap_gen), init_algo_t>pusher (swap_gen, init_algo);
+
+                                std::cout << "Added additional swaps: " << additional_swaps << std::endl;
+                            }
 
 
-                        {
-                            ScopedTimer timer("Rewiring run");
-                            init_algo.run();
+                            {
+                                ScopedTimer timer("Rewiring run");
+                                init_algo.run();
+                            }
                         }
-                    }
 
-                    std::cout << "[CM-ES] Number of iterations: " << iteration << std::endl;
+                        std::cout << "[CM-ES] Number of iterations: " << iteration << std::endl;
+                    };
+
+                    if (config.parallelCMES) {
+                        ModifiedEdgeSwapParallelTFP::ModifiedEdgeSwapParallelTFP init_algo(edge_stream, run_length);
+                        remove_illegal_edges(init_algo);
+                    } else {
+                        ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP init_algo(edge_stream, run_length, config.numNodes,
+                                                                           config.internalMem);
+                        remove_illegal_edges(init_algo);
+                    }
                 }
             }
             break;
@@ -404,7 +465,7 @@ void benchmark(RunConfig & config) {
     // Randomize with EM-ES
     {
         auto snapshotPhases =
-                config.extractPhases((config.numSwaps + config.runSize - 1) / config.runSize);
+                config.extractPhases(config.runSize ? (config.numSwaps + config.runSize - 1) / config.runSize : 0);
 
         // report phases
         {
@@ -440,12 +501,25 @@ void benchmark(RunConfig & config) {
         } else  {
             SwapGenerator swap_gen(config.numSwaps, edge_stream.size());
 
+            std::unique_ptr<SwapConvergenceMonitor> monitor;
+            if (config.stopOnConvergence)
+                monitor.reset(new SwapConvergenceMonitor(edge_stream, config.numNodes));
+
             EdgeSwapTFP::EdgeSwapTFP swap_algo(edge_stream, config.runSize, config.numNodes, config.internalMem, writeSnapshots);
+            swap_algo.setConvergenceMonitor(monitor.get());
+            swap_algo.setRunProfile(run_profile_output);
+            swap_algo.setDisplayRunSummary(config.verbose);
+            swap_algo.setPipelining(config.pipelined);
+            swap_algo.setExistenceFilter(config.existenceFilter);
+            swap_algo.setHubCache(config.hubCache);
+            if (config.updateLog > 0)
+                swap_algo.setLogStructuredUpdates(config.updateLog);
 
             {
                 IOStatistics swap_report("Randomization");
-                StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
+                const uint_t swaps_pushed = pushSwapsUntilConverged(swap_gen, swap_algo, monitor.get());
                 swap_algo.run();
+                std::cout << "Swaps pushed: " << swaps_pushed << std::endl;
             }
         }
     }
@@ -489,8 +563,14 @@ int main(int argc, char* argv[]) {
     stxxl::srandom_number32(config.randomSeed);
     stxxl::set_seed(config.randomSeed);
 
+    ThreadPool::configure(config.poolThreads, config.pinThreads);
+    ThreadPool::instance().setProfiling(config.profileTasks);
+
     benchmark(config);
 
+    if (config.profileTasks)
+        ThreadPool::instance().reportStats(std::cout);
+
     {
         const auto max_alloc = stxxl::block_manager::get_instance()->get_maximum_allocation();
         std::cout << "Maximum EM allocation: "
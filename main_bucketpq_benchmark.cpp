@@ -0,0 +1,147 @@
+/**
+ * @file main_bucketpq_benchmark.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ *
+ * Compares the STXXL priority queue and MonotoneBucketPQ on the message
+ * pattern of the dependency chains of EdgeSwapTFP: swaps are processed in
+ * order, each one receives the messages addressed to it and forwards its
+ * edges to the next swap requesting the same edge.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <stxxl/cmdline>
+#include <stxxl/priority_queue>
+
+#include <defs.h>
+#include <GenericComparator.h>
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <Utils/MonotoneBucketPQ.h>
+#include <Utils/IOStatistics.h>
+
+struct BucketPQBenchmarkParams {
+    stxxl::uint64 num_swaps;
+    stxxl::uint64 num_edges;
+    stxxl::uint64 memory;
+    stxxl::uint64 window_keys;
+    unsigned int repetitions;
+    unsigned int random_seed;
+
+    BucketPQBenchmarkParams()
+        : num_swaps(16 * IntScale::Mi)
+        , num_edges(64 * IntScale::Mi)
+        , memory(256 * IntScale::Mi)
+        , window_keys(1 << 16)
+        , repetitions(3)
+        , random_seed(1)
+    {}
+
+#if STXXL_VERSION_INTEGER > 10401
+#define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, dest, args
+#else
+    #define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, args, dest
+#endif
+
+    bool parse_cmdline(int argc, char* argv[]) {
+        stxxl::cmdline_parser cp;
+        {
+            cp.add_bytes(CMDLINE_COMP('m', "swaps", num_swaps, "Number of swaps of the run"));
+            cp.add_bytes(CMDLINE_COMP('e', "edges", num_edges, "Number of edges; determines the distance to the next swap of an edge"));
+            cp.add_bytes(CMDLINE_COMP('i', "ram", memory, "Memory of each priority queue"));
+            cp.add_bytes(CMDLINE_COMP('w', "window", window_keys, "Keys per window of MonotoneBucketPQ"));
+            cp.add_uint (CMDLINE_COMP('r', "repetitions", repetitions, "Repetitions per priority queue"));
+            cp.add_uint (CMDLINE_COMP('s', "seed", random_seed, "Initial seed for PRNG"));
+
+            if (!cp.process(argc, argv)) {
+                cp.print_usage();
+                return false;
+            }
+        }
+
+        cp.print_result();
+        return true;
+    }
+};
+
+using Msg = EdgeSwapTFP::DependencyChainEdgeMsg;
+using MsgComparator = GenericComparatorStruct<Msg>::Descending;
+
+//! Replays the dependency chain of a run: the two edges of every swap are
+//! forwarded to a later swap with probability 1/2 each, at a geometrically
+//! distributed distance as if swaps chose their edges uniformly at random.
+template <typename PQ>
+void run_pq(const std::string & label, PQ & pq, const BucketPQBenchmarkParams & config) {
+    using my_clock = std::chrono::high_resolution_clock;
+    IOStatistics report(label);
+
+    std::mt19937_64 gen(config.random_seed);
+    std::geometric_distribution<swapid_t> distance_dist(2.0 / config.num_edges);
+    std::uniform_int_distribution<node_t> node_dist;
+
+    const auto begin = my_clock::now();
+
+    uint64_t messages = 0;
+    uint64_t peak = 0;
+    for (swapid_t sid = 0; sid < config.num_swaps; ++sid) {
+        for (; !pq.empty() && pq.top().swap_id / 2 == sid; pq.pop())
+            messages++;
+
+        for (unsigned char spos = 0; spos < 2; ++spos) {
+            const swapid_t successor = sid + 1 + distance_dist(gen);
+            if (successor >= config.num_swaps)
+                continue;
+
+            pq.push(Msg{2 * successor + (gen() & 1), edge_t(node_dist(gen), node_dist(gen))});
+        }
+        peak = std::max<uint64_t>(peak, pq.size());
+    }
+    for (; !pq.empty(); pq.pop())
+        messages++;
+
+    const auto end = my_clock::now();
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+
+    std::cout << label << " time: " << seconds << "s"
+              << " messages: " << messages
+              << " peak: " << peak
+              << " rate: " << (messages / seconds / 1e6) << "M msgs/s"
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+#ifndef NDEBUG
+    std::cout << "[build with assertions]" << std::endl;
+#endif
+
+    BucketPQBenchmarkParams config;
+    if (!config.parse_cmdline(argc, argv))
+        return -1;
+
+    stxxl::stats::get_instance()->reset();
+
+    for (unsigned int rep = 0; rep < config.repetitions; ++rep) {
+        {
+            using PQ = stxxl::PRIORITY_QUEUE_GENERATOR<Msg, MsgComparator, PQ_INT_MEM, 1 << 20>::result;
+            using Block = PQ::block_type;
+            stxxl::read_write_pool<Block> pool(config.memory / 2 / Block::raw_size, config.memory / 2 / Block::raw_size);
+            PQ pq(pool);
+            run_pq("stxxl-pq", pq, config);
+        }
+
+        {
+            MonotoneBucketPQ<Msg, MsgComparator, EdgeSwapTFP::SwapIdKey<Msg>> pq(config.memory, config.window_keys);
+            run_pq("bucket-pq", pq, config);
+            std::cout << "bucket-pq windows: " << pq.sortedWindows()
+                      << " spilled: " << pq.spilledElements() << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <Utils/IOStatistics.h>
 #include <Utils/MonotonicPowerlawRandomStream.h>
 #include <Utils/NodeHash.h>
+#include <Utils/NumaPlacement.h>
 #include <DegreeStream.h>
 #include <Utils/StreamPusherRedirectStream.h>
 
@@ -34,6 +35,7 @@ struct PowerlawBenchmarkParams {
 	uint32_t num_batch_splits;
 	stxxl::uint64 insertion_buffer_size;
 	stxxl::uint64 num_max_msgs;
+	bool numa;
 
 	PowerlawBenchmarkParams() :
 		num_rounds(1),
@@ -47,7 +49,8 @@ struct PowerlawBenchmarkParams {
 		num_microchunk_splits(16),
 		num_batch_splits(1),
 		insertion_buffer_size(1000),
-		num_max_msgs(Curveball::DUMMY_LIMIT) // not a concern
+		num_max_msgs(Curveball::DUMMY_LIMIT), // not a concern
+		numa(false)
 	{
 		using my_clock = std::chrono::high_resolution_clock;
 		my_clock::duration d = my_clock::now() - my_clock::time_point::min();
@@ -78,6 +81,7 @@ struct PowerlawBenchmarkParams {
 			cp.add_uint(CMDLINE_COMP('j', "num_batch_splits", num_batch_splits, "Number of Microchunk Multiplier in a Batch"));
 			cp.add_bytes(CMDLINE_COMP('y', "insertion_buffer_size", insertion_buffer_size, "Insertion Buffer Size"));
 			cp.add_bytes(CMDLINE_COMP('l', "num_max_msgs", num_max_msgs, "Number of Max. Messages in RAM"));
+			cp.add_flag(CMDLINE_COMP('N', "numa", numa, "Pin threads to NUMA nodes and allocate per-thread buffers locally"));
 
 			if (!cp.process(argc, argv)) {
 				cp.print_usage();
@@ -122,6 +126,7 @@ void benchmark(const PowerlawBenchmarkParams& config) {
 	edge_stream.rewind();
 	degree_stream.rewind();
 	IOStatistics cb_report;
+	const auto numa_counters = NumaPlacement::instance().counters();
 	Curveball::EMCurveball<Curveball::ModHash, EdgeStream> algo(edge_stream,
 																degree_stream,
 																config.num_nodes,
@@ -138,6 +143,7 @@ void benchmark(const PowerlawBenchmarkParams& config) {
 
 	algo.run();
 	cb_report.report("CurveballStats");
+	NumaPlacement::instance().reportCounters(std::cout, numa_counters);
 
 	std::cout << "Initial edgecount " << edge_stream.size() << std::endl;
 	std::cout << "Output edgecount " << out_edge_stream.size() << std::endl;
@@ -173,6 +179,8 @@ int main(int argc, char* argv[]) {
 	stxxl::srandom_number32(config.random_seed);
 	stxxl::set_seed(config.random_seed);
 
+	NumaPlacement::configure(config.numa);
+
 	benchmark(config);
 	std::cout << "Maximum EM allocation: " << stxxl::block_manager::get_instance()->get_maximum_allocation() << std::endl;
 
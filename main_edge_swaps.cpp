@@ -11,6 +11,7 @@
 #include <EdgeStream.h>
 
 #include <Utils/IOStatistics.h>
+#include <Utils/NumaPlacement.h>
 
 #include <Utils/MonotonicPowerlawRandomStream.h>
 #include <HavelHakimi/HavelHakimiIMGenerator.h>
@@ -24,12 +25,16 @@
 #include <EdgeSwaps/EdgeSwapInternalSwaps.h>
 #include <EdgeSwaps/EdgeSwapTFP.h>
 #include <EdgeSwaps/IMEdgeSwap.h>
+#include <EdgeSwaps/ParallelIMEdgeSwap.h>
+#include <EdgeSwaps/EdgeSwapAuto.h>
 
 enum EdgeSwapAlgo {
     IM,
+    PIM,
     SEMI, // InternalSwaps
     TFP,
-    PTFP
+    PTFP,
+    AUTO
 };
 
 struct RunConfig {
@@ -61,6 +66,8 @@ struct RunConfig {
 
     unsigned int edgeSizeFactor;
 
+    bool numa;
+
     RunConfig() 
         : numNodes(10 * IntScale::Mi)
         , minDeg(2)
@@ -80,6 +87,7 @@ struct RunConfig {
         , snapshots(true)
         , frequency(0)
         , edgeSizeFactor(10)
+        , numa(false)
     {
         using myclock = std::chrono::high_resolution_clock;
         myclock::duration d = myclock::now() - myclock::time_point::min();
@@ -113,7 +121,7 @@ struct RunConfig {
 
             cp.add_bytes  (CMDLINE_COMP('i', "ram", internalMem, "Internal memory"));
 
-            cp.add_string(CMDLINE_COMP('e', "swap-algo", swap_algo_name, "SwapAlgo to use: IM, SEMI, TFP, PTFP (default)"));
+            cp.add_string(CMDLINE_COMP('e', "swap-algo", swap_algo_name, "SwapAlgo to use: IM, PIM (parallel IM), SEMI, TFP, PTFP (default), AUTO (IM if the graph fits into -i, else TFP)"));
 
             cp.add_flag(CMDLINE_COMP('v', "verbose", verbose, "Include debug information selectable at runtime"));
             
@@ -125,6 +133,7 @@ struct RunConfig {
             cp.add_flag(CMDLINE_COMP('z', "snapshots", snapshots, "Write thrillbin file every frequency-times"));
             cp.add_uint  (CMDLINE_COMP('f', "frequency",      frequency,   "Frequency for snapshots"));
             cp.add_uint  (CMDLINE_COMP('w', "edge-size-factor",  edgeSizeFactor ,   "Swap number equals # * edge_stream"));
+            cp.add_flag  (CMDLINE_COMP('N', "numa", numa, "Pin the threads of PTFP to NUMA nodes and allocate per-thread buffers locally"));
 
 
             if (!cp.process(argc, argv)) {
@@ -142,6 +151,8 @@ struct RunConfig {
             else if (0 == swap_algo_name.compare("TFP"))  { edgeSwapAlgo = TFP; }
             else if (0 == swap_algo_name.compare("SEMI")) { edgeSwapAlgo = SEMI; }
             else if (0 == swap_algo_name.compare("IM"))   { edgeSwapAlgo = IM; }
+            else if (0 == swap_algo_name.compare("PIM"))  { edgeSwapAlgo = PIM; }
+            else if (0 == swap_algo_name.compare("AUTO")) { edgeSwapAlgo = AUTO; }
             else {
                 std::cerr << "Invalid edge swap algorithm specified: " << swap_algo_name << std::endl;
                 cp.print_usage();
@@ -236,6 +247,13 @@ void benchmark(RunConfig & config) {
                 break;
             }
 
+            case PIM: {
+                ParallelIMEdgeSwap swap_algo(edge_stream);
+                StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
+                swap_algo.run();
+                break;
+            }
+
             case SEMI: {
                 EdgeSwapInternalSwaps swap_algo(edge_stream, config.runSize);
                 StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
@@ -244,9 +262,8 @@ void benchmark(RunConfig & config) {
             }
 
             case TFP: {
-                const swapid_t runSize = edge_stream.size() / 8;
-
-                EdgeSwapTFP::EdgeSwapTFP swap_algo(edge_stream, runSize, config.numNodes, config.internalMem);
+                EdgeSwapTFP::EdgeSwapTFP swap_algo(edge_stream, EdgeSwapTFP::EdgeSwapTFP::auto_run_length, config.numNodes, config.internalMem);
+                swap_algo.setDisplayRunSummary(config.verbose);
                 {
                     IOStatistics swap_report("SwapStats");
                     StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
@@ -259,8 +276,24 @@ void benchmark(RunConfig & config) {
 
             case PTFP: {
                 EdgeSwapParallelTFP::EdgeSwapParallelTFP swap_algo(edge_stream, config.runSize);
-                StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
-                swap_algo.run();
+                {
+                    IOStatistics swap_report("SwapStats");
+                    const auto numa_counters = NumaPlacement::instance().counters();
+                    StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
+                    swap_algo.run();
+                    NumaPlacement::instance().reportCounters(std::cout, numa_counters);
+                }
+                break;
+            }
+
+            case AUTO: {
+                EdgeSwapAuto swap_algo(edge_stream, config.numNodes, config.internalMem);
+                std::cout << "Selected " << (swap_algo.engine() == EdgeSwapAuto::InternalMemory ? "IM" : "TFP") << " engine" << std::endl;
+                {
+                    IOStatistics swap_report("SwapStats");
+                    StreamPusher<decltype(swap_gen), decltype(swap_algo)>(swap_gen, swap_algo);
+                    swap_algo.run();
+                }
                 break;
             }
         }
@@ -299,6 +332,8 @@ int main(int argc, char* argv[]) {
     stxxl::srandom_number32(config.randomSeed);
     stxxl::set_seed(config.randomSeed);
 
+    NumaPlacement::configure(config.numa);
+
     benchmark(config);
     std::cout << "Maximum EM allocation: " <<  stxxl::block_manager::get_instance()->get_maximum_allocation() << std::endl;    
 
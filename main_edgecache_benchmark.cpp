@@ -0,0 +1,174 @@
+/**
+ * @file main_edgecache_benchmark.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ *
+ * Compares the lookups of the flat EdgeVectorCache with the stx::btree_map
+ * it replaced: a random subset of the edges is loaded and then touched by
+ * swaps, each of which reads two cached edges and writes them back.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stxxl/cmdline>
+#include <stxxl/vector>
+#include <stx/btree_map>
+
+#include <defs.h>
+#include <EdgeSwaps/EdgeVectorCache.h>
+
+struct EdgeCacheBenchmarkParams {
+    stxxl::uint64 num_edges;
+    stxxl::uint64 num_loaded;
+    stxxl::uint64 num_swaps;
+    unsigned int repetitions;
+    unsigned int random_seed;
+
+    EdgeCacheBenchmarkParams()
+        : num_edges(16 * IntScale::Mi)
+        , num_loaded(IntScale::Mi)
+        , num_swaps(16 * IntScale::Mi)
+        , repetitions(3)
+        , random_seed(1)
+    {}
+
+#if STXXL_VERSION_INTEGER > 10401
+#define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, dest, args
+#else
+    #define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, args, dest
+#endif
+
+    bool parse_cmdline(int argc, char* argv[]) {
+        stxxl::cmdline_parser cp;
+        {
+            cp.add_bytes(CMDLINE_COMP('e', "edges", num_edges, "Number of edges in the external vector"));
+            cp.add_bytes(CMDLINE_COMP('l', "loaded", num_loaded, "Number of edges loaded into the cache"));
+            cp.add_bytes(CMDLINE_COMP('m', "swaps", num_swaps, "Number of swaps touching the cache"));
+            cp.add_uint (CMDLINE_COMP('r', "repetitions", repetitions, "Repetitions per cache"));
+            cp.add_uint (CMDLINE_COMP('s', "seed", random_seed, "Initial seed for PRNG"));
+
+            if (!cp.process(argc, argv)) {
+                cp.print_usage();
+                return false;
+            }
+        }
+
+        if (num_loaded > num_edges) {
+            std::cerr << "Cannot load more edges than the vector contains" << std::endl;
+            return false;
+        }
+
+        cp.print_result();
+        return true;
+    }
+};
+
+//! Minimal stream over the sorted ids to load
+class IdStream {
+    std::vector<int_t>::const_iterator _it;
+    const std::vector<int_t>::const_iterator _end;
+public:
+    IdStream(const std::vector<int_t> & ids) : _it(ids.cbegin()), _end(ids.cend()) {}
+    bool empty() const { return _it == _end; }
+    const int_t & operator*() const { return *_it; }
+    IdStream & operator++() { ++_it; return *this; }
+};
+
+//! Every swap reads two random cached edges and writes back the swapped edges
+template <typename Cache>
+void run_swaps(const std::string & label, Cache & cache, const std::vector<int_t> & ids, const EdgeCacheBenchmarkParams & config) {
+    using my_clock = std::chrono::high_resolution_clock;
+
+    std::mt19937_64 gen(config.random_seed);
+    std::uniform_int_distribution<size_t> id_dist(0, ids.size() - 1);
+
+    const auto begin = my_clock::now();
+
+    for (stxxl::uint64 i = 0; i < config.num_swaps; ++i) {
+        const int_t id0 = ids[id_dist(gen)];
+        const int_t id1 = ids[id_dist(gen)];
+
+        edge_t e0 = cache.getEdge(id0);
+        edge_t e1 = cache.getEdge(id1);
+        std::swap(e0.first, e1.first);
+        cache.setEdge(id0, e0);
+        cache.setEdge(id1, e1);
+    }
+
+    const auto end = my_clock::now();
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+
+    std::cout << label << " time: " << seconds << "s"
+              << " rate: " << (config.num_swaps / seconds / 1e6) << "M swaps/s"
+              << std::endl;
+}
+
+//! The layout EdgeVectorCache used before
+class BTreeEdgeCache {
+    stx::btree_map<int_t, edge_t> _edges;
+public:
+    BTreeEdgeCache(const EdgeVectorCache::vector_type & external_edges, const std::vector<int_t> & ids) {
+        for (const int_t id : ids)
+            _edges.insert(std::make_pair(id, external_edges[id]));
+    }
+
+    edge_t& getEdge(int_t id) { return _edges[id]; }
+    void setEdge(int_t id, edge_t e) { _edges[id] = e; }
+};
+
+int main(int argc, char* argv[]) {
+#ifndef NDEBUG
+    std::cout << "[build with assertions]" << std::endl;
+#endif
+
+    EdgeCacheBenchmarkParams config;
+    if (!config.parse_cmdline(argc, argv))
+        return -1;
+
+    std::mt19937_64 gen(config.random_seed);
+
+    EdgeVectorCache::vector_type edges(config.num_edges);
+    {
+        EdgeVectorCache::vector_type::bufwriter_type writer(edges);
+        for (stxxl::uint64 i = 0; i < config.num_edges; ++i)
+            writer << edge_t(i, i + 1);
+        writer.finish();
+    }
+
+    std::vector<int_t> ids;
+    {
+        std::uniform_int_distribution<int_t> id_dist(0, config.num_edges - 1);
+        ids.reserve(config.num_loaded);
+        while (ids.size() < config.num_loaded) {
+            while (ids.size() < config.num_loaded)
+                ids.push_back(id_dist(gen));
+
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+    }
+
+    for (unsigned int rep = 0; rep < config.repetitions; ++rep) {
+        {
+            BTreeEdgeCache cache(edges, ids);
+            run_swaps("btree-cache", cache, ids, config);
+        }
+
+        {
+            EdgeVectorCache cache(edges);
+            IdStream id_stream(ids);
+            cache.loadEdges(id_stream);
+            run_swaps("flat-cache", cache, ids, config);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file main_im_curveball_benchmark.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ *
+ * Compares the wall time IMEdgeSwap and IMCurveball need until the
+ * SwapConvergenceMonitor considers the graph to be mixed.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <omp.h>
+#include <stxxl/cmdline>
+
+#include <EdgeStream.h>
+#include <IMGraph.h>
+#include <SwapGenerator.h>
+#include <Curveball/IMCurveball.h>
+#include <EdgeSwaps/IMEdgeSwap.h>
+#include <EdgeSwaps/SwapConvergenceMonitor.h>
+#include <HavelHakimi/HavelHakimiIMGenerator.h>
+#include <Utils/MonotonicPowerlawRandomStream.h>
+
+struct IMCurveballBenchmarkParams {
+	stxxl::uint64 num_nodes;
+	stxxl::uint64 min_deg;
+	stxxl::uint64 max_deg;
+	double gamma;
+	int num_threads;
+	unsigned int random_seed;
+	double swaps_per_step;
+	unsigned int max_steps;
+	unsigned int window;
+	double epsilon;
+
+	IMCurveballBenchmarkParams() :
+		num_nodes(100 * UIntScale::K),
+		min_deg(2),
+		max_deg(1 * UIntScale::K),
+		gamma(-2.0),
+		num_threads(omp_get_max_threads()),
+		swaps_per_step(1.0),
+		max_steps(100),
+		window(3),
+		epsilon(1e-3)
+	{
+		using my_clock = std::chrono::high_resolution_clock;
+		my_clock::duration d = my_clock::now() - my_clock::time_point::min();
+		random_seed = d.count();
+	}
+
+#if STXXL_VERSION_INTEGER > 10401
+#define CMDLINE_COMP(chr, str, dest, args...) \
+		chr, str, dest, args
+#else
+	#define CMDLINE_COMP(chr, str, dest, args...) \
+		chr, str, args, dest
+#endif
+
+	bool parse_cmdline(int argc, char* argv[]) {
+		stxxl::cmdline_parser cp;
+		{
+			cp.add_bytes(CMDLINE_COMP('n', "num_nodes", num_nodes, "Number of Nodes"));
+			cp.add_bytes(CMDLINE_COMP('a', "min_deg", min_deg, "Min. Degree of Powerlaw Degree Distribution"));
+			cp.add_bytes(CMDLINE_COMP('b', "max_deg", max_deg, "Max. Degree of Powerlaw Degree Distribution"));
+			cp.add_double(CMDLINE_COMP('g', "gamma", gamma, "Gamma of Powerlaw Degree Distribution"));
+			cp.add_int(CMDLINE_COMP('t', "num_threads", num_threads, "Number of Threads of IMCurveball"));
+			cp.add_uint(CMDLINE_COMP('s', "seed", random_seed, "Initial Seed for PRNG"));
+			cp.add_double(CMDLINE_COMP('k', "swaps_per_step", swaps_per_step, "Swaps per Measurement Step of IMEdgeSwap as Multiple of the Number of Edges"));
+			cp.add_uint(CMDLINE_COMP('r', "max_steps", max_steps, "Max. Number of Steps (Global Trades for IMCurveball)"));
+			cp.add_uint(CMDLINE_COMP('w', "window", window, "Number of Flat Steps until Convergence"));
+			cp.add_double(CMDLINE_COMP('e', "epsilon", epsilon, "Max. Change of a Flat Step"));
+
+			if (!cp.process(argc, argv)) {
+				cp.print_usage();
+				return false;
+			}
+		}
+
+		cp.print_result();
+		return true;
+	}
+};
+
+template <typename EdgeIterator>
+void observe_step(SwapConvergenceMonitor& monitor, EdgeIterator begin, EdgeIterator end) {
+	monitor.begin_run();
+	for (; begin != end; ++begin)
+		monitor.observe(*begin);
+	monitor.end_run();
+}
+
+void benchmark(const IMCurveballBenchmarkParams& config) {
+	using my_clock = std::chrono::high_resolution_clock;
+
+	// Build edge list
+	std::vector<degree_t> degrees;
+	std::vector<edge_t> edges;
+	{
+		HavelHakimiIMGenerator hh_gen(HavelHakimiIMGenerator::PushDirection::DecreasingDegree);
+		MonotonicPowerlawRandomStream<false> degree_sequence(config.min_deg,
+															 config.max_deg,
+															 config.gamma,
+															 config.num_nodes,
+															 1.0,
+															 stxxl::get_next_seed());
+
+		for (; !degree_sequence.empty(); ++degree_sequence)
+			hh_gen.push(*degree_sequence);
+
+		hh_gen.generate();
+
+		degrees.resize(config.num_nodes, 0);
+		for (; !hh_gen.empty(); ++hh_gen) {
+			edges.push_back(*hh_gen);
+			++degrees[hh_gen->first];
+			++degrees[hh_gen->second];
+		}
+
+		std::sort(edges.begin(), edges.end());
+	}
+
+	const edgeid_t num_edges = edges.size();
+	std::cout << "Edges: " << num_edges << std::endl;
+
+	SwapConvergenceMonitor::Parameters monitor_params;
+	monitor_params.window = config.window;
+	monitor_params.epsilon = config.epsilon;
+	monitor_params.sample_size = num_edges;
+	monitor_params.seed = config.random_seed;
+
+	EdgeStream initial_edges;
+	for (const edge_t& e : edges)
+		initial_edges.push(e);
+	initial_edges.consume();
+
+	// IMEdgeSwap
+	{
+		SwapConvergenceMonitor monitor(initial_edges, config.num_nodes, monitor_params);
+
+		IMGraph graph(degrees);
+		for (const edge_t& e : edges)
+			graph.addEdge(e);
+
+		IMEdgeSwap swap_algo(graph);
+		const uint_t swaps_per_step = std::max<uint_t>(1, config.swaps_per_step * num_edges);
+
+		my_clock::duration elapsed(0);
+		std::vector<edge_t> current_edges;
+		unsigned int step = 0;
+
+		for (; step < config.max_steps && !monitor.converged(); ++step) {
+			auto begin = my_clock::now();
+			for (SwapGenerator swap_gen(swaps_per_step, num_edges); !swap_gen.empty(); ++swap_gen)
+				swap_algo.push(*swap_gen);
+			elapsed += my_clock::now() - begin;
+
+			current_edges.clear();
+			for (auto it = graph.getEdges(); !it.empty(); ++it)
+				current_edges.push_back(*it);
+			std::sort(current_edges.begin(), current_edges.end());
+
+			observe_step(monitor, current_edges.cbegin(), current_edges.cend());
+		}
+
+		swap_algo.run();
+
+		std::cout << "IMEdgeSwap " << (monitor.converged() ? "converged" : "did not converge")
+				  << " after " << step * swaps_per_step << " swaps in "
+				  << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms;"
+				  << " assortativity " << monitor.assortativity()
+				  << " untouched initial edges " << monitor.untouched_fraction() << std::endl;
+	}
+
+	// IMCurveball
+	{
+		SwapConvergenceMonitor monitor(initial_edges, config.num_nodes, monitor_params);
+
+		auto begin = my_clock::now();
+		Curveball::IMCurveball curveball(degrees, edges, config.num_threads, config.random_seed);
+		my_clock::duration elapsed = my_clock::now() - begin;
+
+		unsigned int step = 0;
+		for (; step < config.max_steps && !monitor.converged(); ++step) {
+			begin = my_clock::now();
+			curveball.run(1);
+			elapsed += my_clock::now() - begin;
+
+			const auto current_edges = curveball.getEdges();
+			observe_step(monitor, current_edges.cbegin(), current_edges.cend());
+		}
+
+		std::cout << "IMCurveball " << (monitor.converged() ? "converged" : "did not converge")
+				  << " after " << step << " global trades in "
+				  << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms;"
+				  << " assortativity " << monitor.assortativity()
+				  << " untouched initial edges " << monitor.untouched_fraction() << std::endl;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	#ifndef NDEBUG
+	std::cout << "[Built with assertions]" << std::endl;
+	#endif
+
+	// print arguments
+	for (int i = 0; i < argc; ++i)
+		std::cout << argv[i] << " ";
+	std::cout << std::endl;
+
+	IMCurveballBenchmarkParams config;
+	if (!config.parse_cmdline(argc, argv))
+		return -1;
+
+	stxxl::srandom_number32(config.random_seed);
+	stxxl::set_seed(config.random_seed);
+
+	benchmark(config);
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file main_intsorter_benchmark.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ *
+ * Compares stxxl::sorter and IntSorter on the EdgeSwapMsg and
+ * ExistenceRequestMsg messages of EdgeSwapTFP.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stxxl/cmdline>
+#include <stxxl/sorter>
+
+#include <defs.h>
+#include <TupleHelper.h>
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <Utils/IntSorter.h>
+#include <Utils/IOStatistics.h>
+
+struct IntSorterBenchmarkParams {
+    stxxl::uint64 num_messages;
+    stxxl::uint64 num_edges;
+    stxxl::uint64 num_nodes;
+    stxxl::uint64 memory;
+    unsigned int repetitions;
+    unsigned int random_seed;
+
+    IntSorterBenchmarkParams()
+        : num_messages(64 * IntScale::Mi)
+        , num_edges(64 * IntScale::Mi)
+        , num_nodes(4 * IntScale::Mi)
+        , memory(2 * IntScale::Gi)
+        , repetitions(3)
+        , random_seed(1)
+    {}
+
+#if STXXL_VERSION_INTEGER > 10401
+#define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, dest, args
+#else
+    #define CMDLINE_COMP(chr, str, dest, args...) \
+        chr, str, args, dest
+#endif
+
+    bool parse_cmdline(int argc, char* argv[]) {
+        stxxl::cmdline_parser cp;
+        {
+            cp.add_bytes(CMDLINE_COMP('m', "messages", num_messages, "Number of messages per sorter"));
+            cp.add_bytes(CMDLINE_COMP('e', "edges", num_edges, "Number of edges requested by EdgeSwapMsg"));
+            cp.add_bytes(CMDLINE_COMP('n', "nodes", num_nodes, "Number of nodes of ExistenceRequestMsg edges"));
+            cp.add_bytes(CMDLINE_COMP('i', "ram", memory, "Memory of each sorter"));
+            cp.add_uint (CMDLINE_COMP('r', "repetitions", repetitions, "Repetitions per sorter"));
+            cp.add_uint (CMDLINE_COMP('s', "seed", random_seed, "Initial seed for PRNG"));
+
+            if (!cp.process(argc, argv)) {
+                cp.print_usage();
+                return false;
+            }
+        }
+
+        cp.print_result();
+        return true;
+    }
+};
+
+template <typename Sorter, typename Msg, typename Comparator>
+void run_sorter(const std::string & label, const std::vector<Msg> & messages, Sorter & sorter) {
+    using my_clock = std::chrono::high_resolution_clock;
+    IOStatistics report(label);
+
+    const auto begin = my_clock::now();
+    for (const auto & msg : messages)
+        sorter.push(msg);
+
+    const auto pushed = my_clock::now();
+    sorter.sort();
+
+    const auto sorted = my_clock::now();
+    Comparator cmp;
+    Msg last;
+    uint64_t count = 0;
+    for (; !sorter.empty(); ++sorter, ++count) {
+        if (count && cmp(*sorter, last)) {
+            std::cerr << label << ": output not sorted at position " << count << std::endl;
+            abort();
+        }
+        last = *sorter;
+    }
+    const auto consumed = my_clock::now();
+
+    if (count != messages.size()) {
+        std::cerr << label << ": expected " << messages.size() << " messages, got " << count << std::endl;
+        abort();
+    }
+
+    auto seconds = [] (my_clock::time_point a, my_clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    };
+
+    std::cout << label << " push: " << seconds(begin, pushed) << "s"
+              << " sort: " << seconds(pushed, sorted) << "s"
+              << " consume: " << seconds(sorted, consumed) << "s"
+              << " total: " << seconds(begin, consumed) << "s"
+              << " rate: " << (messages.size() / seconds(begin, consumed) / 1e6) << "M msgs/s"
+              << std::endl;
+}
+
+template <typename Msg, typename Comparator, typename KeyExtract>
+void compare(const std::string & name, const std::vector<Msg> & messages, const IntSorterBenchmarkParams & config) {
+    for (unsigned int rep = 0; rep < config.repetitions; ++rep) {
+        {
+            stxxl::sorter<Msg, Comparator> sorter(Comparator{}, config.memory);
+            run_sorter<decltype(sorter), Msg, Comparator>(name + "-stxxl", messages, sorter);
+        }
+
+        {
+            IntSorter<Msg, Comparator, KeyExtract> sorter(Comparator{}, config.memory);
+            run_sorter<decltype(sorter), Msg, Comparator>(name + "-intsort", messages, sorter);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+#ifndef NDEBUG
+    std::cout << "[build with assertions]" << std::endl;
+#endif
+
+    IntSorterBenchmarkParams config;
+    if (!config.parse_cmdline(argc, argv))
+        return -1;
+
+    stxxl::stats::get_instance()->reset();
+
+    std::mt19937_64 gen(config.random_seed);
+
+    // swaps request two random edges each and are pushed in order of their ids
+    {
+        using namespace EdgeSwapTFP;
+        std::uniform_int_distribution<edgeid_t> edge_dist(0, config.num_edges - 1);
+
+        std::vector<EdgeSwapMsg> messages;
+        messages.reserve(config.num_messages);
+        for (swapid_t sid = 0; messages.size() < config.num_messages; ++sid)
+            messages.emplace_back(edge_dist(gen), sid);
+
+        compare<EdgeSwapMsg, GenericComparatorStruct<EdgeSwapMsg>::Ascending, EdgeSwapMsgKey>("EdgeSwapMsg", messages, config);
+    }
+
+    // existence requests of random normalized edges, pushed in order of the swaps
+    {
+        using namespace EdgeSwapTFP;
+        std::uniform_int_distribution<node_t> node_dist(0, config.num_nodes - 1);
+        std::bernoulli_distribution flag_dist(0.5);
+
+        std::vector<ExistenceRequestMsg> messages;
+        messages.reserve(config.num_messages);
+        for (swapid_t sid = 0; messages.size() < config.num_messages; ++sid) {
+            edge_t e(node_dist(gen), node_dist(gen));
+            e.normalize();
+            messages.emplace_back(e, sid / 2, flag_dist(gen));
+        }
+
+        compare<ExistenceRequestMsg, GenericComparatorStruct<ExistenceRequestMsg>::Ascending, ExistenceRequestMsgKey>("ExistenceRequestMsg", messages, config);
+    }
+
+    return 0;
+}
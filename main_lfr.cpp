@@ -1,5 +1,6 @@
 #include <iostream>
 #include <chrono>
+#include <memory>
 
 #include <stxxl/cmdline>
 
@@ -8,12 +9,14 @@
 #include <LFR/LFR.h>
 #include <LFR/LFRCommunityAssignBenchmark.h>
 #include <Utils/ExportGraph.h>
+#include <Utils/AdjacencyBlockStream.h>
 
 enum OutputFileType {
 	METIS,
 	THRILLBIN,
 	EDGELIST,
-	SNAP
+	SNAP,
+	BINSTREAM
 };
 
 class RunConfig {
@@ -55,6 +58,7 @@ public:
   std::string output_filename, partition_filename;
   std::string output_filetype;
   OutputFileType outputFileType = METIS;
+  std::streambuf* stdout_buffer = nullptr; ///< original buffer of std::cout if the graph is streamed to stdout
 
   MonotonicPowerlawRandomStream<false>::Parameters node_distribution_param;
   MonotonicPowerlawRandomStream<false>::Parameters community_distribution_param;
@@ -63,6 +67,10 @@ public:
   bool lfr_bench_comassign;
   bool lfr_bench_comassign_retry;
 
+  bool swap_convergence;
+  stxxl::uint64 curveball_min_edges;
+  unsigned int community_threads;
+
   RunConfig() :
 	  number_of_nodes      (100000),
 	  number_of_communities( 10000),
@@ -79,7 +87,10 @@ public:
 	  max_bytes(10*UIntScale::Gi),
 	  lfr_bench_rounds(100),
 	  lfr_bench_comassign(false),
-	  lfr_bench_comassign_retry(false)
+	  lfr_bench_comassign_retry(false),
+	  swap_convergence(false),
+	  curveball_min_edges(std::numeric_limits<stxxl::uint64>::max()),
+	  community_threads(16)
   {
 	  using myclock = std::chrono::high_resolution_clock;
 	  myclock::duration d = myclock::now() - myclock::time_point::min();
@@ -117,13 +128,16 @@ public:
 	  cp.add_double(CMDLINE_COMP('m', "mixing",        mixing,         "Fraction node edge being inter-community"));
 	  cp.add_bytes(CMDLINE_COMP('b', "max-bytes", max_bytes, "Maximum number of bytes of main memory to use"));
 
-	  cp.add_string(CMDLINE_COMP('o', "output", output_filename, "Output filename; the generated graph will be written as METIS graph"));
+	  cp.add_string(CMDLINE_COMP('o', "output", output_filename, "Output filename; the generated graph will be written as METIS graph; - is stdout for BINSTREAM"));
 	  cp.add_string(CMDLINE_COMP('p', "partition-output", partition_filename, "Partition output filename; every line contains a node and the communities of the node separated by spaces"));
 
 	  cp.add_uint(CMDLINE_COMP('d', "lfr-bench-rounds", lfr_bench_rounds, "# of rounds for LFR benchmarks"));
 	  cp.add_flag(CMDLINE_COMP('e', "lfr-comassign", lfr_bench_comassign, "Perform LFR comassign benchmark"));
 	  cp.add_flag(CMDLINE_COMP('f', "lfr-comassign-retry", lfr_bench_comassign_retry, "Perform LFR comassign retry benchmark"));
-	  cp.add_string(CMDLINE_COMP('t', "output-filetype", output_filetype, "Output filetype; METIS, THRILLBIN, ..."));
+	  cp.add_string(CMDLINE_COMP('t', "output-filetype", output_filetype, "Output filetype; METIS, THRILLBIN, EDGELIST, SNAP, BINSTREAM (adjacency blocks written while merging, see Utils/AdjacencyBlockStream.h)"));
+	  cp.add_flag(CMDLINE_COMP('q', "swap-convergence", swap_convergence, "Stop EM edge swaps once the graph is mixed instead of always performing 10*m swaps"));
+	  cp.add_bytes(CMDLINE_COMP('u', "curveball-min-edges", curveball_min_edges, "Randomize internal communities with at least this many edges using Curveball instead of edge swaps"));
+	  cp.add_uint(CMDLINE_COMP('w', "community-threads", community_threads, "Max. number of communities generated concurrently; determines the memory share of a community (output does not depend on the number of threads)"));
 
 	  assert(number_of_communities < std::numeric_limits<community_t>::max());
 
@@ -146,11 +160,17 @@ public:
 		  else if (0 == output_filetype.compare("THRILLBIN"))  { outputFileType = THRILLBIN; }
 		  else if (0 == output_filetype.compare("EDGELIST")) { outputFileType = EDGELIST; }
 		  else if (0 == output_filetype.compare("SNAP")) { outputFileType = SNAP; }
+		  else if (0 == output_filetype.compare("BINSTREAM")) { outputFileType = BINSTREAM; }
 		  else {
 			  std::cerr << "Invalid or no output file type specified, using default ThrillBin file type" << std::endl;
 			  cp.print_usage();
 			  return false;
 		  }
+
+		  // keep stdout free of log messages if the graph is streamed to it
+		  if (outputFileType == BINSTREAM && output_filename == "-")
+			  stdout_buffer = std::cout.rdbuf(std::cerr.rdbuf());
+
 		  std::cout << "Using filetype: " << output_filetype << std::endl;
 	  }
 
@@ -163,10 +183,6 @@ public:
 };
 
 int main(int argc, char* argv[]) {
-#ifndef NDEBUG
-	std::cout << "[build with assertions]" << std::endl;
-#endif
-
 	omp_set_nested(1);
 	omp_set_num_threads(1);
 
@@ -174,6 +190,10 @@ int main(int argc, char* argv[]) {
 	if (!config.parse_cmdline(argc, argv))
 		return -1;
 
+#ifndef NDEBUG
+	std::cout << "[build with assertions]" << std::endl;
+#endif
+
 	stxxl::srandom_number32(config.randomSeed);
 	stxxl::set_seed(config.randomSeed);
 
@@ -187,6 +207,10 @@ int main(int argc, char* argv[]) {
 	oconfig.constDegree.overlappingNodes = config.overlapping_nodes;
 
 	lfr.setOverlap(LFR::OverlapMethod::constDegree, oconfig);
+	lfr.setSeed(config.randomSeed);
+	lfr.setSwapConvergence(config.swap_convergence);
+	lfr.setMaxCommunityThreads(config.community_threads);
+	lfr.setCommunityCurveball(static_cast<edgeid_t>(std::min<stxxl::uint64>(config.curveball_min_edges, std::numeric_limits<edgeid_t>::max())));
 
 	if (config.lfr_bench_comassign) {
 		LFR::LFRCommunityAssignBenchmark bench(lfr);
@@ -195,9 +219,28 @@ int main(int argc, char* argv[]) {
 		LFR::LFRCommunityAssignBenchmark bench(lfr);
 		bench.computeRetryRate(config.lfr_bench_rounds);
 	} else {
+		// stream the graph while it is merged instead of exporting it afterwards
+		std::unique_ptr<std::ostream> stream_output;
+		std::unique_ptr<AdjacencyBlockWriter> block_writer;
+		if (config.outputFileType == BINSTREAM && !config.output_filename.empty()) {
+			if (config.stdout_buffer)
+				stream_output.reset(new std::ostream(config.stdout_buffer));
+			else
+				stream_output.reset(new std::ofstream(config.output_filename, std::ios::trunc | std::ios::binary));
+
+			block_writer.reset(new AdjacencyBlockWriter(*stream_output, config.node_distribution_param.numberOfNodes));
+			AdjacencyBlockWriter & writer = *block_writer;
+			lfr.setAdjacencyCallback([&writer] (node_t u, const std::vector<node_t> & neighbours) {
+				writer(u, neighbours);
+			});
+		}
+
 		lfr.run();
 
-		if (!config.output_filename.empty()) {
+		if (block_writer) {
+			block_writer->finish();
+			std::cout << "[export_as_binstream] Streamed " << block_writer->edges_written() << " edges" << std::endl;
+		} else if (!config.output_filename.empty()) {
 			lfr.get_edges().rewind();
 
 			// Output to file
@@ -214,6 +257,9 @@ int main(int argc, char* argv[]) {
 						break;
 					case SNAP:
 						export_as_snap(lfr.get_edges(), config.node_distribution_param.numberOfNodes, config.output_filename);
+						break;
+					case BINSTREAM:
+						break; // already written by the callback
 				}
 			}
 		}
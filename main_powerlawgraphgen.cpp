@@ -34,6 +34,7 @@
 #include <ConfigurationModel/ConfigurationModelRandom.h>
 #include <SwapStream.h>
 #include <EdgeSwaps/ModifiedEdgeSwapTFP.h>
+#include <EdgeSwaps/ModifiedEdgeSwapParallelTFP.h>
 #include <Utils/ExportGraph.h>
 
 enum OutputFileType {
@@ -81,6 +82,7 @@ struct RunConfig {
 		unsigned int edgeSizeFactor;
 
 		double randomSwapsInCMES;
+		bool parallelCMES;
 
 		RunConfig()
 			: numNodes(10 * IntScale::Mi)
@@ -101,6 +103,7 @@ struct RunConfig {
 			, noRuns(8)
 			, edgeSizeFactor(1)
 			, randomSwapsInCMES(0)
+			, parallelCMES(false)
 		{
 			using myclock = std::chrono::high_resolution_clock;
 			myclock::duration d = myclock::now() - myclock::time_point::min();
@@ -146,6 +149,7 @@ struct RunConfig {
 				cp.add_flag  (CMDLINE_COMP('H', "input-hh",    input_hh,          "use Havel Hakimi; default"));
 				cp.add_flag  (CMDLINE_COMP('c', "input-cm",    input_cm,          "use Configuration Model + Rewiring"));
 				cp.add_double(CMDLINE_COMP('C', "cmes-random", randomSwapsInCMES, "Include X*|E| random swaps during CMES rewiring steps; default: 0"));
+				cp.add_flag  (CMDLINE_COMP('E', "cmes-parallel", parallelCMES,   "Remove illegal edges of CMES with the parallel multigraph swaps"));
 
 				cp.add_string(CMDLINE_COMP('I', "input-file", inputFile, "read edge list from file"));
 				cp.add_string(CMDLINE_COMP('q', "output-filename", output_filename, "Output filename"));
@@ -258,44 +262,54 @@ void generate(RunConfig & config) {
 				{
 					IOStatistics swap_report("ES for CM");
 
-					ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP init_algo(edge_stream, config.runSize, config.numNodes,
-																														 config.internalMem);
+					auto remove_illegal_edges = [&] (auto & init_algo) {
+						using init_algo_t = typename std::remove_reference<decltype(init_algo)>::type;
 
-					EdgeToEdgeSwapPusher<decltype(cmhh_gen), EdgeStream, ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP>
-						cm_to_emes_pusher(cmhh_gen, edge_stream, init_algo);
-					edge_stream.consume();
+						EdgeToEdgeSwapPusher<decltype(cmhh_gen), EdgeStream, init_algo_t>
+							cm_to_emes_pusher(cmhh_gen, edge_stream, init_algo);
+						edge_stream.consume();
 
 
-					const edgeid_t min_swaps = edge_stream.size() * config.randomSwapsInCMES;
+						const edgeid_t min_swaps = edge_stream.size() * config.randomSwapsInCMES;
 
 
-					unsigned int iteration = 0;
-					while (init_algo.runnable()) {
-						std::cout << "[CM-ES] Remove illegal edges: Iteration " << ++iteration << std::endl;
-						std::cout << "Graph contains " << edge_stream.size() << " edges\n"
-							"  " << edge_stream.selfloops() << " selfloops\n"
-												"  " << edge_stream.multiedges() << " multiedges"
-											<< std::endl;
+						unsigned int iteration = 0;
+						while (init_algo.runnable()) {
+							std::cout << "[CM-ES] Remove illegal edges: Iteration " << ++iteration << std::endl;
+							std::cout << "Graph contains " << edge_stream.size() << " edges\n"
+								"  " << edge_stream.selfloops() << " selfloops\n"
+													"  " << edge_stream.multiedges() << " multiedges"
+												<< std::endl;
 
-						std::cout << "Swaps pending: " << init_algo.swaps_pushed() << std::endl;
+							std::cout << "Swaps pending: " << init_algo.swaps_pushed() << std::endl;
 
-						if (init_algo.swaps_pushed() < min_swaps * 0.75) {
-							const swapid_t additional_swaps = min_swaps - init_algo.swaps_pushed();
+							if (init_algo.swaps_pushed() < min_swaps * 0.75) {
+								const swapid_t additional_swaps = min_swaps - init_algo.swaps_pushed();
 
-							SwapGenerator swap_gen(additional_swaps, edge_stream.size());
-							StreamPusher<decltype(swap_gen), decltype(init_algo)>pusher (swap_gen, init_algo);
+								SwapGenerator swap_gen(additional_swaps, edge_stream.size());
+								StreamPusher<decltype(swap_gen), init_algo_t>pusher (swap_gen, init_algo);
 
-							std::cout << "Added additional swaps: " << additional_swaps << std::endl;
-						}
+								std::cout << "Added additional swaps: " << additional_swaps << std::endl;
+							}
 
 
-						{
-							ScopedTimer timer("Rewiring run");
-							init_algo.run();
+							{
+								ScopedTimer timer("Rewiring run");
+								init_algo.run();
+							}
 						}
-					}
 
-					std::cout << "[CM-ES] Number of iterations: " << iteration << std::endl;
+						std::cout << "[CM-ES] Number of iterations: " << iteration << std::endl;
+					};
+
+					if (config.parallelCMES) {
+						ModifiedEdgeSwapParallelTFP::ModifiedEdgeSwapParallelTFP init_algo(edge_stream, config.runSize);
+						remove_illegal_edges(init_algo);
+					} else {
+						ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP init_algo(edge_stream, config.runSize, config.numNodes,
+						                                                   config.internalMem);
+						remove_illegal_edges(init_algo);
+					}
 				}
 			}
 				break;
@@ -340,6 +354,7 @@ void generate(RunConfig & config) {
 			SwapGenerator swap_gen(config.numSwaps, edge_stream.size());
 
 			EdgeSwapTFP::EdgeSwapTFP swap_algo(edge_stream, config.runSize, config.numNodes, config.internalMem);
+			swap_algo.setDisplayRunSummary(config.verbose);
 
 			{
 				IOStatistics swap_report("Randomization");
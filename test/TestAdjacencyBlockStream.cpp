@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include <Utils/AdjacencyBlockStream.h>
+
+class TestAdjacencyBlockStream : public ::testing::Test {};
+
+TEST_F(TestAdjacencyBlockStream, roundTrip) {
+    const std::vector<edge_t> edges = {{0, 1}, {0, 5}, {2, 3}, {2, 4}, {2, 7}, {6, 7}};
+
+    std::stringstream buffer;
+    {
+        AdjacencyBlockWriter writer(buffer, 8);
+        std::vector<node_t> neighbours;
+        for (size_t i = 0; i < edges.size(); ++i) {
+            neighbours.push_back(edges[i].second);
+            if (i + 1 == edges.size() || edges[i + 1].first != edges[i].first) {
+                writer(edges[i].first, neighbours);
+                neighbours.clear();
+            }
+        }
+        writer.finish();
+
+        ASSERT_EQ(writer.edges_written(), static_cast<edgeid_t>(edges.size()));
+    }
+
+    AdjacencyBlockReader reader(buffer);
+    ASSERT_EQ(reader.num_nodes(), 8u);
+
+    std::vector<edge_t> result;
+    for (; !reader.empty(); ++reader)
+        result.push_back(*reader);
+
+    ASSERT_EQ(result, edges);
+}
+
+TEST_F(TestAdjacencyBlockStream, emptyGraph) {
+    std::stringstream buffer;
+    AdjacencyBlockWriter writer(buffer, 3);
+    writer.finish();
+
+    AdjacencyBlockReader reader(buffer);
+    ASSERT_EQ(reader.num_nodes(), 3u);
+    ASSERT_TRUE(reader.empty());
+}
+
+TEST_F(TestAdjacencyBlockStream, rejectsOtherInput) {
+    std::stringstream buffer("3 2 0\n2\n1 3\n2\n");
+    ASSERT_THROW(AdjacencyBlockReader reader(buffer), std::runtime_error);
+}
+
+TEST_F(TestAdjacencyBlockStream, rejectsTruncatedInput) {
+    std::stringstream buffer;
+    {
+        AdjacencyBlockWriter writer(buffer, 8);
+        writer(0, {1, 5});
+        writer(2, {3, 4, 7});
+        writer.finish();
+    }
+    const std::string complete = buffer.str();
+
+    auto read_all = [] (const std::string & data) {
+        std::stringstream truncated(data);
+        AdjacencyBlockReader reader(truncated);
+        for (; !reader.empty(); ++reader);
+    };
+
+    // header 16 bytes, first block 16 bytes, second block 20 bytes, terminator 8 bytes
+    ASSERT_NO_THROW(read_all(complete));
+    ASSERT_THROW(read_all(complete.substr(0, 32)), std::runtime_error); // missing terminator
+    ASSERT_THROW(read_all(complete.substr(0, 36)), std::runtime_error); // within a block header
+    ASSERT_THROW(read_all(complete.substr(0, 44)), std::runtime_error); // within the neighbours
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <Utils/BloomFilter.h>
+
+TEST(TestBloomFilter, noFalseNegatives) {
+    BloomFilter filter(1 << 16, 10000);
+
+    std::mt19937_64 gen(1);
+    std::vector<uint64_t> keys(10000);
+    for (auto & key : keys) {
+        key = gen();
+        filter.insert(key);
+    }
+
+    for (const auto key : keys)
+        ASSERT_TRUE(filter.contains(key));
+}
+
+TEST(TestBloomFilter, falsePositiveRate) {
+    // 2^19 bits for 2^15 keys, i.e. 16 bits per key
+    BloomFilter filter(1 << 16, 1 << 15);
+    ASSERT_EQ(filter.bytes(), size_t(1) << 16);
+
+    for (uint64_t key = 0; key < (1 << 15); ++key)
+        filter.insert(key);
+
+    unsigned int false_positives = 0;
+    for (uint64_t key = 1 << 15; key < (1 << 17); ++key)
+        false_positives += filter.contains(key);
+
+    // the expected rate is below 0.1%
+    ASSERT_LT(false_positives, (1u << 17) / 100);
+}
+
+TEST(TestBloomFilter, clear) {
+    BloomFilter filter(1024, 100);
+    for (uint64_t key = 0; key < 100; ++key)
+        filter.insert(key);
+
+    filter.clear();
+
+    unsigned int positives = 0;
+    for (uint64_t key = 0; key < 100; ++key)
+        positives += filter.contains(key);
+    ASSERT_EQ(positives, 0u);
+}
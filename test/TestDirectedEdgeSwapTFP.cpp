@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include <EdgeSwaps/DirectedEdgeSwapTFP.h>
+
+#include "TestGraphs.h"
+#include "TestSwapReference.h"
+
+class TestDirectedEdgeSwapTFP : public ::testing::Test {
+protected:
+    const node_t _num_nodes = 300;
+
+    //! Executes the swaps in runs of run_length swaps and returns the arcs
+    std::vector<edge_t> _randomize(const std::vector<edge_t> & input, const std::vector<SwapDescriptor> & swaps,
+                                   swapid_t run_length, node_t num_nodes) const {
+        EdgeStream arcs;
+        TestGraphs::fill(arcs, input);
+
+        EdgeSwapTFP::DirectedEdgeSwapTFP algo(arcs, run_length, num_nodes, 1llu << 28);
+        SwapReference::pushInRuns(algo, swaps, run_length);
+
+        return TestGraphs::read(arcs);
+    }
+
+    //! Result of a single swap of the first two arcs
+    std::vector<edge_t> _swap_first_arcs(const std::vector<edge_t> & input, node_t num_nodes) const {
+        return _randomize(input, {SwapDescriptor(0, 1, false)}, 1, num_nodes);
+    }
+
+    void _check_reference(swapid_t num_swaps, swapid_t run_length) const {
+        const auto input = TestGraphs::randomGraph(_num_nodes, 3000, true);
+        const auto swaps = SwapReference::swaps(num_swaps, input.size());
+
+        std::vector<edge_t> reference(input);
+        const swapid_t performed = SwapReference::simulate(reference, swaps, run_length, SwapReference::directedSwap);
+        ASSERT_GT(performed, swaps.size() / 4);
+
+        ASSERT_EQ(_randomize(input, swaps, run_length, _num_nodes), reference);
+    }
+};
+
+TEST_F(TestDirectedEdgeSwapTFP, matchesSequentialSwaps) {
+    _check_reference(3000, 3000);
+}
+
+TEST_F(TestDirectedEdgeSwapTFP, matchesSequentialSwapsOfMultipleRuns) {
+    // the arcs are decoded and encoded again by every run
+    _check_reference(4 * 3000 + 123, 500);
+}
+
+TEST_F(TestDirectedEdgeSwapTFP, preservesInAndOutDegrees) {
+    const auto input = TestGraphs::randomGraph(_num_nodes, 3000, true);
+    const auto result = _randomize(input, SwapReference::swaps(4 * input.size(), input.size()), 500, _num_nodes);
+
+    ASSERT_EQ(result.size(), input.size());
+    ASSERT_NE(result, input);
+
+    std::vector<degree_t> out_degrees(_num_nodes, 0);
+    std::vector<degree_t> in_degrees(_num_nodes, 0);
+    for (const auto & arc : input) {
+        out_degrees[arc.first]++;
+        in_degrees[arc.second]++;
+    }
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        const auto & arc = result[i];
+        ASSERT_FALSE(arc.is_loop());
+        if (i) ASSERT_LT(result[i-1], arc); // sorted without multi-arcs
+
+        out_degrees[arc.first]--;
+        in_degrees[arc.second]--;
+    }
+
+    for (node_t u = 0; u < _num_nodes; ++u) {
+        ASSERT_EQ(out_degrees[u], 0) << "u=" << u;
+        ASSERT_EQ(in_degrees[u], 0) << "u=" << u;
+    }
+}
+
+TEST_F(TestDirectedEdgeSwapTFP, reverseArcsAreNoDuplicates) {
+    // (0, 2) x (3, 1) yields (0, 1), the reverse of an existing arc;
+    // (1, 0) x (3, 4) yields (1, 4), which exists
+    const std::vector<edge_t> input {{0, 2}, {1, 0}, {1, 4}, {3, 1}, {3, 4}};
+    const std::vector<SwapDescriptor> swaps {SwapDescriptor(0, 3, false), SwapDescriptor(1, 4, false)};
+
+    const std::vector<edge_t> expected {{0, 1}, {1, 0}, {1, 4}, {3, 2}, {3, 4}};
+    ASSERT_EQ(_randomize(input, swaps, swaps.size(), 5), expected);
+
+    // the randomized arcs keep reciprocal pairs, but never the same arc twice
+    const auto result = _randomize(TestGraphs::randomGraph(_num_nodes, 3000, true),
+                                   SwapReference::swaps(4 * 3000, 3000), 500, _num_nodes);
+    const std::set<edge_t> arcs(result.begin(), result.end());
+    ASSERT_EQ(arcs.size(), result.size());
+
+    size_t reciprocal = 0;
+    for (const auto & arc : result)
+        reciprocal += arcs.count(edge_t(arc.second, arc.first));
+    ASSERT_GT(reciprocal, 0u);
+}
+
+TEST_F(TestDirectedEdgeSwapTFP, loopsAtNodeIdBoundaries) {
+    // the loop (u, u) is encoded as {u, u + n}, i.e. EdgeSwapTFP checks the _loop_offset n;
+    // the arcs (n-1, 0) and (0, n-1) are encoded as {n-1, n} and {0, 2n-1}
+    const node_t n = 4;
+
+    // loops at the first and last node id are rejected
+    {
+        const std::vector<edge_t> input {{0, 1}, {2, 0}};
+        ASSERT_EQ(_swap_first_arcs(input, n), input);
+    }
+    {
+        const std::vector<edge_t> input {{1, 3}, {3, 2}};
+        ASSERT_EQ(_swap_first_arcs(input, n), input);
+    }
+    {
+        const std::vector<edge_t> input {{0, 3}, {3, 0}};
+        ASSERT_EQ(_swap_first_arcs(input, n), input);
+    }
+
+    // arcs between the first and the last node id are no loops
+    {
+        const std::vector<edge_t> expected {{0, 3}, {2, 1}};
+        ASSERT_EQ(_swap_first_arcs({{0, 1}, {2, 3}}, n), expected);
+    }
+    {
+        const std::vector<edge_t> expected {{1, 2}, {3, 0}};
+        ASSERT_EQ(_swap_first_arcs({{1, 0}, {3, 2}}, n), expected);
+    }
+}
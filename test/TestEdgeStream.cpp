@@ -73,3 +73,26 @@ TEST_F(TestEdgeStream, fillReadRereadReset) {
         check_against_ref(es, reference);
     }
 }
+
+TEST_F(TestEdgeStream, payloadsFollowEdges) {
+    BasicEdgeStream<double> es;
+    std::vector<std::pair<edge_t, double>> reference;
+
+    for(node_t u = 0; u < 1000; u += 3) {
+        for(node_t v = u + 1; v < u + 5; v += 2) {
+            reference.emplace_back(edge_t(u, v), 0.5 * u + v);
+            es.push(reference.back().first, reference.back().second);
+        }
+    }
+
+    es.consume();
+    for(unsigned int pass = 0; pass < 2; pass++, es.rewind()) {
+        for(const auto & edge : reference) {
+            ASSERT_FALSE(es.empty());
+            ASSERT_EQ(*es, edge.first);
+            ASSERT_EQ(es.payload(), edge.second);
+            ++es;
+        }
+        ASSERT_TRUE(es.empty());
+    }
+}
@@ -6,6 +6,7 @@
 #include <EdgeSwaps/EdgeSwapFullyInternal.h>
 #include <EdgeSwaps/EdgeSwapParallelTFP.h>
 #include <EdgeSwaps/IMEdgeSwap.h>
+#include <EdgeSwaps/ParallelIMEdgeSwap.h>
 
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
@@ -43,7 +44,8 @@ namespace {
       EdgeSwapTFP::EdgeSwapTFP,
       EdgeSwapParallelTFP::EdgeSwapParallelTFP,
 //      EdgeSwapFullyInternal<EdgeVector, SwapVector>,
-      IMEdgeSwap
+      IMEdgeSwap,
+      ParallelIMEdgeSwap
    >;
 
    TYPED_TEST_CASE(TestEdgeSwap, TestEdgeSwapImplementations);
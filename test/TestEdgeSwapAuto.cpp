@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <EdgeSwaps/EdgeSwapAuto.h>
+#include <SwapGenerator.h>
+
+#include "TestGraphs.h"
+
+class TestEdgeSwapAuto : public ::testing::Test {
+protected:
+    const node_t _num_nodes = 2000;
+
+    void _randomize_and_check(size_t im_memory, EdgeSwapAuto::Engine expected) {
+        const auto input = TestGraphs::powerlawGraph(_num_nodes);
+        const auto degrees = TestGraphs::degrees(input, _num_nodes);
+        const edgeid_t num_edges = input.size();
+
+        EdgeStream edges;
+        TestGraphs::fill(edges, input);
+
+        EdgeSwapAuto algo(edges, _num_nodes, im_memory);
+        ASSERT_EQ(algo.engine(), expected);
+
+        for (SwapGenerator swap_gen(num_edges, num_edges, 1); !swap_gen.empty(); ++swap_gen)
+            algo.push(*swap_gen);
+        algo.run();
+
+        // the result has been written back into the edge stream
+        edges.rewind();
+        ASSERT_EQ(edges.size(), num_edges);
+
+        const auto result = TestGraphs::read(edges);
+        for (size_t i = 0; i < result.size(); ++i) {
+            ASSERT_FALSE(result[i].is_loop());
+            if (i)
+                ASSERT_LT(result[i - 1], result[i]);
+        }
+
+        ASSERT_EQ(degrees, TestGraphs::degrees(result, _num_nodes));
+        ASSERT_NE(input, result);
+    }
+};
+
+TEST_F(TestEdgeSwapAuto, selectsEngineByMemory) {
+    ASSERT_EQ(EdgeSwapAuto::selectEngine(1000, 10000, 1llu << 30), EdgeSwapAuto::InternalMemory);
+    ASSERT_EQ(EdgeSwapAuto::selectEngine(1000, 10000, 1llu << 10), EdgeSwapAuto::ExternalMemory);
+    ASSERT_EQ(EdgeSwapAuto::selectEngine(1000, IMGraph::maxEdges(), 1llu << 40), EdgeSwapAuto::ExternalMemory);
+}
+
+TEST_F(TestEdgeSwapAuto, internalMemory) {
+    _randomize_and_check(1llu << 30, EdgeSwapAuto::InternalMemory);
+}
+
+TEST_F(TestEdgeSwapAuto, externalMemory) {
+    _randomize_and_check(SORTER_MEM, EdgeSwapAuto::ExternalMemory);
+}
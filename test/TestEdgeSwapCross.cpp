@@ -14,6 +14,7 @@
 #include <EdgeSwaps/EdgeSwapParallelTFP.h>
 #include <EdgeSwaps/EdgeSwapFullyInternal.h>
 #include <EdgeSwaps/IMEdgeSwap.h>
+#include <EdgeSwaps/ParallelIMEdgeSwap.h>
 
 
 #ifdef EDGE_SWAP_DEBUG_VECTOR
@@ -78,7 +79,8 @@ namespace {
       EdgeSwapInternalSwaps,
       EdgeSwapTFP::EdgeSwapTFP,
       EdgeSwapParallelTFP::EdgeSwapParallelTFP,
-      IMEdgeSwap
+      IMEdgeSwap,
+      ParallelIMEdgeSwap
    >;
 
    TYPED_TEST_CASE(TestEdgeSwapCross, TestEdgeSwapCrossImplementations);
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <SwapGenerator.h>
+
+#include "TestGraphs.h"
+#include "TestRunProfileRecords.h"
+
+using RunProfileRecords::field;
+
+class TestEdgeSwapTFPRequestScreening : public ::testing::Test {
+protected:
+    const node_t _num_nodes = 2000;
+    const swapid_t _run_length = 500;
+
+    struct Result {
+        std::vector<edge_t> edges;
+        std::vector<std::string> records; ///< run profile of each run
+    };
+
+    //! Runs four times as many swaps as edges with an existence filter of filter_bytes
+    //! and a hub cache of hub_bytes (0 disables either)
+    Result _randomize(size_t filter_bytes, size_t hub_bytes = 0) {
+        EdgeStream edges;
+        TestGraphs::fill(edges, TestGraphs::powerlawGraph(_num_nodes));
+
+        std::ostringstream profile;
+        {
+            EdgeSwapTFP::EdgeSwapTFP algo(edges, _run_length, _num_nodes, 1llu << 30);
+            algo.setRunProfile(&profile);
+            algo.setExistenceFilter(filter_bytes);
+            algo.setHubCache(hub_bytes);
+            for (SwapGenerator swap_gen(4 * edges.size(), edges.size(), 1); !swap_gen.empty(); ++swap_gen)
+                algo.push(*swap_gen);
+            algo.run();
+        }
+
+        return Result{TestGraphs::read(edges), RunProfileRecords::lines(profile.str())};
+    }
+
+    //! A false negative of the screening reports an existing edge as missing,
+    //! i.e. the swaps would differ from those of the unscreened engine
+    void _check_same_swaps(const Result & screened, const Result & unscreened) {
+        ASSERT_EQ(screened.edges, unscreened.edges);
+        ASSERT_EQ(screened.records.size(), unscreened.records.size());
+        for (size_t i = 0; i < screened.records.size(); ++i) {
+            ASSERT_EQ(field(screened.records[i], "performed"), field(unscreened.records[i], "performed"));
+            ASSERT_EQ(field(screened.records[i], "rejected_multi_edge"), field(unscreened.records[i], "rejected_multi_edge"));
+        }
+    }
+};
+
+TEST_F(TestEdgeSwapTFPRequestScreening, existenceFilterDropsRequests) {
+    const auto unscreened = _randomize(0);
+    const auto screened = _randomize(1 << 20);
+
+    _check_same_swaps(screened, unscreened);
+
+    // the filter is rebuilt by the update pass of every run
+    for (size_t i = 0; i < screened.records.size(); ++i) {
+        const std::string & record = screened.records[i];
+        const uint64_t screened_requests = field(record, "screened_requests");
+        const uint64_t dropped_requests = field(record, "dropped_requests");
+        ASSERT_GT(screened_requests, 0u);
+        ASSERT_GT(dropped_requests, 0u);
+        ASSERT_LE(dropped_requests, screened_requests);
+        ASSERT_EQ(field(record, "hub_cache_hits"), 0u);
+
+        ASSERT_EQ(field(record, "existence_request_sorter") + dropped_requests,
+                  field(unscreened.records[i], "existence_request_sorter"));
+    }
+}
+
+TEST_F(TestEdgeSwapTFPRequestScreening, saturatedExistenceFilterKeepsSwaps) {
+    // almost every request is a false positive of a tiny filter and has to be sorted
+    _check_same_swaps(_randomize(64), _randomize(0));
+}
+
+TEST_F(TestEdgeSwapTFPRequestScreening, hubCacheAnswersHubRequests) {
+    const auto unscreened = _randomize(0);
+
+    // the budget covers the adjacency lists of a few hubs only
+    const auto screened = _randomize(0, 1 << 10);
+    _check_same_swaps(screened, unscreened);
+
+    for (size_t i = 0; i < screened.records.size(); ++i) {
+        const std::string & record = screened.records[i];
+        const uint64_t hits = field(record, "hub_cache_hits");
+        const uint64_t dropped_requests = field(record, "dropped_requests");
+        ASSERT_GT(hits, 0u);
+        ASSERT_EQ(field(record, "screened_requests"), hits);
+        ASSERT_LE(dropped_requests, hits);
+
+        // requests of edges without hub endpoint are sorted as before
+        const uint64_t sorted = field(record, "existence_request_sorter");
+        ASSERT_EQ(sorted + dropped_requests, field(unscreened.records[i], "existence_request_sorter"));
+        ASSERT_GT(sorted, hits);
+    }
+}
+
+TEST_F(TestEdgeSwapTFPRequestScreening, hubCacheWithExistenceFilter) {
+    const auto unscreened = _randomize(0);
+    const auto screened = _randomize(1 << 16, 1 << 10);
+    _check_same_swaps(screened, unscreened);
+
+    for (const auto & record : screened.records) {
+        ASSERT_GT(field(record, "hub_cache_hits"), 0u);
+        ASSERT_GT(field(record, "screened_requests"), field(record, "hub_cache_hits"));
+    }
+}
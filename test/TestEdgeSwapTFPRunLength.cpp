@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <SwapGenerator.h>
+
+#include "TestGraphs.h"
+
+class TestEdgeSwapTFPRunLength : public ::testing::Test {
+protected:
+    std::vector<edge_t> _randomize(swapid_t run_length, swapid_t & final_run_length, bool pipelined = false) {
+        const node_t num_nodes = 2000;
+
+        EdgeStream edges;
+        TestGraphs::fill(edges, TestGraphs::powerlawGraph(num_nodes));
+
+        EdgeSwapTFP::EdgeSwapTFP algo(edges, run_length, num_nodes, 1llu << 30);
+        algo.setPipelining(pipelined);
+        for (SwapGenerator swap_gen(4 * edges.size(), edges.size(), 1); !swap_gen.empty(); ++swap_gen)
+            algo.push(*swap_gen);
+        algo.run();
+
+        final_run_length = algo.runLength();
+
+        return TestGraphs::read(edges);
+    }
+};
+
+TEST_F(TestEdgeSwapTFPRunLength, fixedRunLengthIsKept) {
+    swapid_t final_run_length;
+    _randomize(500, final_run_length);
+    ASSERT_EQ(final_run_length, 500u);
+}
+
+TEST_F(TestEdgeSwapTFPRunLength, autoRunLengthIsReproducible) {
+    swapid_t run_length;
+    const auto first = _randomize(EdgeSwapTFP::EdgeSwapTFP::auto_run_length, run_length);
+    ASSERT_GT(run_length, 0u);
+    ASSERT_LE(run_length, first.size());
+
+    // the run lengths only depend on the swaps and the graph, not on timing
+    swapid_t second_run_length;
+    const auto second = _randomize(EdgeSwapTFP::EdgeSwapTFP::auto_run_length, second_run_length);
+    ASSERT_EQ(run_length, second_run_length);
+    ASSERT_EQ(first, second);
+
+    for (size_t i = 1; i < first.size(); ++i) {
+        ASSERT_LT(first[i - 1], first[i]);
+        ASSERT_FALSE(first[i].is_loop());
+    }
+}
+
+TEST_F(TestEdgeSwapTFPRunLength, pipeliningKeepsResult) {
+    swapid_t run_length;
+    const auto sequential = _randomize(500, run_length);
+    const auto pipelined = _randomize(500, run_length, true);
+    ASSERT_EQ(sequential, pipelined);
+}
+
+TEST_F(TestEdgeSwapTFPRunLength, shortRunKeepsAutoRunLength) {
+    const node_t num_nodes = 2000;
+
+    EdgeStream edges;
+    TestGraphs::fill(edges, TestGraphs::powerlawGraph(num_nodes));
+
+    EdgeSwapTFP::EdgeSwapTFP algo(edges, EdgeSwapTFP::EdgeSwapTFP::auto_run_length, num_nodes, 1llu << 30);
+    const swapid_t initial_run_length = algo.runLength();
+
+    // a forced run of a few swaps says nothing about the load of a full run
+    SwapGenerator swap_gen(4 * edges.size() + 10, edges.size(), 1);
+    for (int i = 0; i < 10; ++i, ++swap_gen)
+        algo.push(*swap_gen);
+    algo.run();
+    ASSERT_EQ(algo.runLength(), initial_run_length);
+
+    for (; !swap_gen.empty(); ++swap_gen)
+        algo.push(*swap_gen);
+    algo.run();
+    ASSERT_GE(algo.runLength(), initial_run_length);
+}
@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <EdgeSwaps/EdgeUpdateLog.h>
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <SwapGenerator.h>
+
+#include "TestGraphs.h"
+#include "TestRunProfileRecords.h"
+
+class TestEdgeUpdateLog : public ::testing::Test {
+protected:
+    struct CountingObserver {
+        edgeid_t edges = 0;
+        void begin_run() { edges = 0; }
+        void observe(const edge_t &) { ++edges; }
+        void end_run() {}
+    };
+
+    std::vector<edge_t> _read(EdgeUpdateLog & log) {
+        std::vector<edge_t> result;
+        for (log.rewind(); !log.empty(); ++log)
+            result.push_back(*log);
+        return result;
+    }
+
+    //! Randomizes the test graph with EdgeSwapTFP; max_levels = 0 rewrites the edges in every run
+    std::vector<edge_t> _randomize(double max_delta_fraction, unsigned int max_levels, bool pipelined,
+                                   std::vector<std::string> & records) {
+        const node_t num_nodes = 2000;
+
+        EdgeStream edges;
+        TestGraphs::fill(edges, TestGraphs::powerlawGraph(num_nodes));
+
+        std::ostringstream profile;
+        {
+            EdgeSwapTFP::EdgeSwapTFP algo(edges, 500, num_nodes, 1llu << 30);
+            algo.setRunProfile(&profile);
+            algo.setPipelining(pipelined);
+            if (max_levels)
+                algo.setLogStructuredUpdates(max_delta_fraction, max_levels);
+            for (SwapGenerator swap_gen(4 * edges.size(), edges.size(), 1); !swap_gen.empty(); ++swap_gen)
+                algo.push(*swap_gen);
+            algo.run();
+        }
+
+        records = RunProfileRecords::lines(profile.str());
+        return TestGraphs::read(edges);
+    }
+};
+
+TEST_F(TestEdgeUpdateLog, mergesDeltas) {
+    const node_t num_nodes = 100;
+    std::mt19937_64 gen(1);
+
+    std::set<edge_t> reference;
+    while (reference.size() < 1000) {
+        edge_t e(static_cast<node_t>(gen() % num_nodes), static_cast<node_t>(gen() % num_nodes));
+        e.normalize();
+        if (!e.is_loop())
+            reference.insert(e);
+    }
+
+    EdgeStream base;
+    for (const auto & e : reference)
+        base.push(e);
+    base.consume();
+
+    EdgeUpdateLog log(base);
+    log.setCompaction(0.25, 4);
+
+    unsigned int compactions = 0;
+    for (unsigned int run = 0; run < 20; ++run) {
+        const auto view = _read(log);
+        ASSERT_EQ(view, std::vector<edge_t>(reference.cbegin(), reference.cend()));
+
+        // invalidate every tenth edge and insert as many new ones
+        BoolStream valid;
+        std::vector<edge_t> removed;
+        for (const auto & e : view) {
+            const bool keep = gen() % 10;
+            valid.push(keep);
+            if (!keep)
+                removed.push_back(e);
+        }
+        valid.consume();
+
+        for (const auto & e : removed)
+            reference.erase(e);
+
+        std::set<edge_t> inserted;
+        while (inserted.size() < removed.size()) {
+            edge_t e(static_cast<node_t>(gen() % num_nodes), static_cast<node_t>(gen() % num_nodes));
+            e.normalize();
+            if (!e.is_loop() && !reference.count(e))
+                inserted.insert(e);
+        }
+        reference.insert(inserted.cbegin(), inserted.cend());
+
+        EdgeStream updates;
+        for (const auto & e : inserted)
+            updates.push(e);
+        updates.consume();
+
+        log.pushDelta(valid, updates);
+        log.rewind();
+
+        const bool compact = log.needsCompaction();
+        compactions += compact;
+
+        CountingObserver observer;
+        EdgeUpdateLog::ScanStream<CountingObserver> scan(log, &observer, compact);
+        for (unsigned int i = 0; i < 100 && !scan.empty(); ++i, ++scan) {}
+        scan.finish();
+
+        ASSERT_EQ(observer.edges, static_cast<edgeid_t>(reference.size()));
+        if (compact) {
+            ASSERT_EQ(log.levels(), 0u);
+            ASSERT_EQ(log.deltaEdges(), 0);
+        }
+    }
+
+    ASSERT_GT(compactions, 0u);
+
+    // a compaction writes the view into the base stream
+    {
+        log.rewind();
+        EdgeUpdateLog::ScanStream<CountingObserver> scan(log, nullptr, true);
+        scan.finish();
+    }
+
+    ASSERT_EQ(log.levels(), 0u);
+    std::vector<edge_t> compacted;
+    for (base.rewind(); !base.empty(); ++base)
+        compacted.push_back(*base);
+    ASSERT_EQ(compacted, std::vector<edge_t>(reference.cbegin(), reference.cend()));
+}
+
+TEST_F(TestEdgeUpdateLog, mergesInsertsAndTombstonesOfAllLevels) {
+    EdgeStream base;
+    for (const auto & e : {edge_t(1, 2), edge_t(2, 3), edge_t(3, 4)})
+        base.push(e);
+    base.consume();
+
+    EdgeUpdateLog log(base);
+    ASSERT_FALSE(log.enabled());
+    ASSERT_EQ(_read(log), std::vector<edge_t>({{1, 2}, {2, 3}, {3, 4}}));
+
+    log.setCompaction(10.0, 8);
+    ASSERT_TRUE(log.enabled());
+
+    auto push = [&] (std::vector<bool> bits, std::vector<edge_t> inserts) {
+        BoolStream valid;
+        for (const bool b : bits)
+            valid.push(b);
+        valid.consume();
+
+        EdgeStream updates;
+        for (const auto & e : inserts)
+            updates.push(e);
+        updates.consume();
+
+        log.pushDelta(valid, updates);
+    };
+
+    // an insert before the first edge of the base
+    push({false, true, true}, {{0, 1}});
+    ASSERT_EQ(_read(log), std::vector<edge_t>({{0, 1}, {2, 3}, {3, 4}}));
+
+    // tombstones of edges inserted by the previous delta and of the last edge
+    push({false, true, false}, {{1, 5}, {4, 5}});
+    ASSERT_EQ(_read(log), std::vector<edge_t>({{1, 5}, {2, 3}, {4, 5}}));
+    ASSERT_EQ(log.levels(), 2u);
+    ASSERT_EQ(log.deltaEdges(), 3);
+
+    // a scan without compaction keeps the base stream
+    {
+        log.rewind();
+        CountingObserver observer;
+        EdgeUpdateLog::ScanStream<CountingObserver> scan(log, &observer, false);
+        scan.finish();
+        ASSERT_EQ(observer.edges, 3);
+    }
+    ASSERT_EQ(log.levels(), 2u);
+
+    std::vector<edge_t> base_edges;
+    for (base.rewind(); !base.empty(); ++base)
+        base_edges.push_back(*base);
+    ASSERT_EQ(base_edges, std::vector<edge_t>({{1, 2}, {2, 3}, {3, 4}}));
+    ASSERT_EQ(_read(log), std::vector<edge_t>({{1, 5}, {2, 3}, {4, 5}}));
+}
+
+TEST_F(TestEdgeUpdateLog, compactionThresholds) {
+    // 100 edges {0, v}
+    EdgeStream base;
+    for (node_t v = 1; v <= 100; ++v)
+        base.push(edge_t(0, v));
+    base.consume();
+
+    // replaces the first k edges of the view by {1, v} edges of the next free v
+    node_t next = 2;
+    auto replace_first = [&] (EdgeUpdateLog & log, edgeid_t k) {
+        BoolStream valid;
+        for (edgeid_t i = 0; i < 100; ++i)
+            valid.push(i >= k);
+        valid.consume();
+
+        EdgeStream updates;
+        for (edgeid_t i = 0; i < k; ++i)
+            updates.push(edge_t(1, next++));
+        updates.consume();
+
+        log.pushDelta(valid, updates);
+        log.rewind();
+    };
+
+    auto compact = [] (EdgeUpdateLog & log) {
+        log.rewind();
+        EdgeUpdateLog::ScanStream<CountingObserver> scan(log, nullptr, true);
+        scan.finish();
+    };
+
+    {
+        // by volume: more than 10% of the edges in the deltas
+        EdgeUpdateLog log(base);
+        log.setCompaction(0.1, 100);
+
+        replace_first(log, 5);
+        ASSERT_FALSE(log.needsCompaction());
+        replace_first(log, 5);
+        ASSERT_FALSE(log.needsCompaction());
+        replace_first(log, 1);
+        ASSERT_EQ(log.deltaEdges(), 11);
+        ASSERT_TRUE(log.needsCompaction());
+
+        const auto view = _read(log);
+        compact(log);
+        ASSERT_EQ(log.levels(), 0u);
+        ASSERT_EQ(log.deltaEdges(), 0);
+        ASSERT_FALSE(log.needsCompaction());
+        ASSERT_EQ(_read(log), view);
+    }
+
+    {
+        // by number of deltas
+        EdgeUpdateLog log(base);
+        log.setCompaction(10.0, 3);
+
+        replace_first(log, 1);
+        replace_first(log, 1);
+        ASSERT_FALSE(log.needsCompaction());
+        replace_first(log, 1);
+        ASSERT_TRUE(log.needsCompaction());
+
+        const auto view = _read(log);
+        compact(log);
+        ASSERT_EQ(log.levels(), 0u);
+        ASSERT_EQ(_read(log), view);
+
+        // the compacted base is the view
+        std::vector<edge_t> base_edges;
+        for (base.rewind(); !base.empty(); ++base)
+            base_edges.push_back(*base);
+        ASSERT_EQ(base_edges, view);
+    }
+}
+
+TEST_F(TestEdgeUpdateLog, edgeSwapTFPCompactsByLevels) {
+    std::vector<std::string> records;
+    const auto rewritten = _randomize(0.0, 0, false, records);
+
+    ASSERT_EQ(rewritten, _randomize(10.0, 4, true, records));
+    ASSERT_EQ(rewritten, _randomize(10.0, 4, false, records));
+
+    // the deltas accumulate until the update pass of the fourth one compacts them
+    uint64_t max_levels = 0;
+    unsigned int compactions = 0;
+    for (const auto & record : records) {
+        const uint64_t levels = RunProfileRecords::field(record, "update_log_levels");
+        ASSERT_LT(levels, 4u);
+        ASSERT_EQ(levels == 0, RunProfileRecords::field(record, "update_log_edges") == 0);
+        max_levels = std::max(max_levels, levels);
+        compactions += !levels;
+    }
+    ASSERT_EQ(max_levels, 3u);
+    ASSERT_GT(compactions, 0u);
+}
+
+TEST_F(TestEdgeUpdateLog, edgeSwapTFPCompactsByVolume) {
+    std::vector<std::string> records;
+    const auto rewritten = _randomize(0.0, 0, false, records);
+
+    ASSERT_EQ(rewritten, _randomize(0.3, 100, false, records));
+
+    uint64_t max_levels = 0;
+    for (const auto & record : records) {
+        ASSERT_LE(RunProfileRecords::field(record, "update_log_edges"), 0.3 * rewritten.size());
+        max_levels = std::max(max_levels, RunProfileRecords::field(record, "update_log_levels"));
+    }
+    ASSERT_GT(max_levels, 1u);
+}
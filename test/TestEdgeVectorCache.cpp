@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <EdgeSwaps/EdgeVectorCache.h>
+
+class TestEdgeVectorCache : public ::testing::Test {
+protected:
+    //! Minimal stream over the sorted ids to load
+    class IdStream {
+        std::vector<int_t>::const_iterator _it;
+        const std::vector<int_t>::const_iterator _end;
+    public:
+        IdStream(const std::vector<int_t> & ids) : _it(ids.cbegin()), _end(ids.cend()) {}
+        bool empty() const { return _it == _end; }
+        const int_t & operator*() const { return *_it; }
+        IdStream & operator++() { ++_it; return *this; }
+    };
+};
+
+TEST_F(TestEdgeVectorCache, loadsSetsAndFlushes) {
+    const int_t num_edges = 1000;
+
+    EdgeVectorCache::vector_type edges;
+    for (int_t i = 0; i < num_edges; ++i)
+        edges.push_back(edge_t(i, i + num_edges));
+
+    std::mt19937_64 gen(1);
+    std::vector<int_t> ids;
+    for (int_t i = 0; i < num_edges; ++i)
+        if (gen() % 4 == 0)
+            ids.push_back(i);
+    ids.push_back(ids.back()); // duplicates are loaded once
+
+    EdgeVectorCache cache(edges);
+    IdStream id_stream(ids);
+    cache.loadEdges(id_stream);
+    ASSERT_EQ(cache.size(), ids.size() - 1);
+
+    for (const int_t id : ids)
+        ASSERT_EQ(cache.getEdge(id), edge_t(id, id + num_edges));
+
+    // reverse the cached edges; flushing normalizes them
+    std::vector<edge_t> expected;
+    for (int_t i = 0; i < num_edges; ++i)
+        expected.push_back(edge_t(i, i + num_edges));
+
+    for (size_t i = 0; i + 1 < ids.size(); ++i) {
+        const edge_t e(ids[i] + 2 * num_edges, ids[i]);
+        cache.setEdge(ids[i], e);
+        ASSERT_EQ(cache.getEdge(ids[i]), e);
+        expected[ids[i]] = edge_t(ids[i], ids[i] + 2 * num_edges);
+    }
+
+    cache.flushEdges();
+    ASSERT_EQ(cache.size(), 0u);
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(static_cast<int_t>(edges.size()), num_edges);
+    for (int_t i = 0; i < num_edges; ++i)
+        ASSERT_EQ(edges[i], expected[i]) << "i=" << i;
+}
+
+TEST_F(TestEdgeVectorCache, setEdgeRejectsIdsNotLoaded) {
+    EdgeVectorCache::vector_type edges;
+    for (int_t i = 0; i < 10; ++i)
+        edges.push_back(edge_t(i, i + 10));
+
+    const std::vector<int_t> ids {2, 5, 7};
+    EdgeVectorCache cache(edges);
+    IdStream id_stream(ids);
+    cache.loadEdges(id_stream);
+
+    // ids before, between and after the loaded ones
+    for (const int_t id : {0, 3, 6, 9})
+        ASSERT_THROW(cache.setEdge(id, edge_t(id, 20)), std::runtime_error);
+
+    cache.setEdge(5, edge_t(5, 20));
+    cache.flushEdges();
+
+    std::vector<edge_t> expected;
+    for (int_t i = 0; i < 10; ++i)
+        expected.push_back(edge_t(i, i == 5 ? 20 : i + 10));
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT_EQ(edges.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(edges[i], expected[i]) << "i=" << i;
+}
+
+TEST_F(TestEdgeVectorCache, setEdgeOnEmptyCacheThrows) {
+    EdgeVectorCache::vector_type edges;
+    edges.push_back(edge_t(0, 1));
+
+    EdgeVectorCache cache(edges);
+    ASSERT_THROW(cache.setEdge(0, edge_t(0, 2)), std::runtime_error);
+}
@@ -0,0 +1,79 @@
+#pragma once
+/**
+ * @file
+ * @brief  Input graphs shared by the tests of the swap engines
+ */
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <defs.h>
+#include <EdgeStream.h>
+#include <HavelHakimi/HavelHakimiIMGenerator.h>
+#include <Utils/MonotonicPowerlawRandomStream.h>
+
+namespace TestGraphs {
+    //! Havel-Hakimi realization of a powerlaw degree sequence in [2, max_degree] with
+    //! exponent -2; the edges are normalized and in the order of the generator
+    inline std::vector<edge_t> powerlawGraph(node_t num_nodes, degree_t max_degree = 100, unsigned int seed = 1) {
+        HavelHakimiIMGenerator hh_gen(HavelHakimiIMGenerator::PushDirection::DecreasingDegree);
+        MonotonicPowerlawRandomStream<false> degree_sequence(2, max_degree, -2, num_nodes, 1.0, seed);
+        for (; !degree_sequence.empty(); ++degree_sequence)
+            hh_gen.push(*degree_sequence);
+        hh_gen.generate();
+
+        std::vector<edge_t> edges;
+        for (; !hh_gen.empty(); ++hh_gen)
+            edges.push_back(*hh_gen);
+
+        return edges;
+    }
+
+    //! Random graph with num_edges sorted edges without loops and multi-edges; the first
+    //! endpoints are skewed towards small ids. If directed, the edges are arcs and about
+    //! a tenth of them is reciprocal, otherwise they are normalized.
+    inline std::vector<edge_t> randomGraph(node_t num_nodes, size_t num_edges, bool directed, unsigned int seed = 1) {
+        std::mt19937_64 gen(seed);
+        std::set<edge_t> edges;
+        while (edges.size() < num_edges) {
+            edge_t edge(std::min(gen() % num_nodes, gen() % num_nodes), gen() % num_nodes);
+            if (edge.is_loop())
+                continue;
+
+            if (!directed) {
+                edge.normalize();
+            } else if (gen() % 10 == 0 && edges.size() + 1 < num_edges) {
+                edges.insert(edge_t(edge.second, edge.first));
+            }
+            edges.insert(edge);
+        }
+
+        return std::vector<edge_t>(edges.begin(), edges.end());
+    }
+
+    inline std::vector<degree_t> degrees(const std::vector<edge_t> & edges, node_t num_nodes) {
+        std::vector<degree_t> result(num_nodes, 0);
+        for (const auto & e : edges) {
+            ++result[e.first];
+            ++result[e.second];
+        }
+        return result;
+    }
+
+    //! Appends the edges to stream and prepares it for reading
+    inline void fill(EdgeStream & stream, const std::vector<edge_t> & edges) {
+        for (const auto & e : edges)
+            stream.push(e);
+        stream.consume();
+    }
+
+    //! Reads stream from its begin
+    inline std::vector<edge_t> read(EdgeStream & stream) {
+        std::vector<edge_t> result;
+        for (stream.rewind(); !stream.empty(); ++stream)
+            result.push_back(*stream);
+        return result;
+    }
+}
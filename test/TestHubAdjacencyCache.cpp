@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include <EdgeSwaps/HubAdjacencyCache.h>
+
+class TestHubAdjacencyCache : public ::testing::Test {
+protected:
+    // star around node 0, a triangle 1-2-3 and the edge 4-5
+    std::vector<edge_t> _edges() const {
+        std::vector<edge_t> edges = {
+            {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5},
+            {1, 2}, {1, 3}, {2, 3}, {4, 5}
+        };
+        return edges;
+    }
+
+    void _fill(EdgeStream & stream, const std::vector<edge_t> & edges) const {
+        for (const auto & e : edges)
+            stream.push(e);
+        stream.consume();
+    }
+};
+
+TEST_F(TestHubAdjacencyCache, selectsHighestDegrees) {
+    EdgeStream stream;
+    _fill(stream, _edges());
+
+    // node 0 has degree 5 and costs 5 * 4 + 4 + 16 bytes
+    HubAdjacencyCache cache(stream, 6, 40);
+    ASSERT_EQ(cache.numHubs(), 1u);
+    ASSERT_EQ(cache.numEdges(), 5u);
+
+    ASSERT_TRUE(cache.covers(edge_t(0, 3)));
+    ASSERT_FALSE(cache.covers(edge_t(1, 2)));
+
+    for (node_t v = 1; v < 6; ++v)
+        ASSERT_TRUE(cache.contains(edge_t(0, v)));
+
+    // the stream is rewound for the engine
+    ASSERT_EQ(*stream, edge_t(0, 1));
+}
+
+TEST_F(TestHubAdjacencyCache, matchesGraph) {
+    const auto edges = _edges();
+    const std::set<edge_t> edge_set(edges.cbegin(), edges.cend());
+
+    EdgeStream stream;
+    _fill(stream, edges);
+
+    HubAdjacencyCache cache(stream, 6, 1 << 20);
+    ASSERT_EQ(cache.numHubs(), 6u);
+
+    for (node_t u = 0; u < 6; ++u) {
+        for (node_t v = u + 1; v < 6; ++v) {
+            ASSERT_TRUE(cache.covers(edge_t(u, v)));
+            ASSERT_EQ(cache.contains(edge_t(u, v)), edge_set.count(edge_t(u, v)) > 0);
+        }
+    }
+}
+
+TEST_F(TestHubAdjacencyCache, observesRewrittenGraph) {
+    EdgeStream stream;
+    _fill(stream, _edges());
+    HubAdjacencyCache cache(stream, 6, 1 << 20);
+
+    // swap {1,2}, {4,5} into {1,4}, {2,5}; degrees are preserved
+    std::vector<edge_t> swapped = {
+        {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5},
+        {1, 3}, {1, 4}, {2, 3}, {2, 5}
+    };
+
+    cache.begin_run();
+    for (const auto & e : swapped)
+        cache.observe(e);
+    cache.end_run();
+
+    ASSERT_FALSE(cache.contains(edge_t(1, 2)));
+    ASSERT_FALSE(cache.contains(edge_t(4, 5)));
+    ASSERT_TRUE(cache.contains(edge_t(1, 4)));
+    ASSERT_TRUE(cache.contains(edge_t(2, 5)));
+}
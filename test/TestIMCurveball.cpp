@@ -0,0 +1,60 @@
+/**
+ * @file TestIMCurveball.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <Curveball/IMCurveball.h>
+
+#include "TestGraphs.h"
+
+class TestIMCurveball : public ::testing::TestWithParam<int> {
+};
+
+TEST_P(TestIMCurveball, keepsDegreesAndSimplicity) {
+	const node_t num_nodes = 2001; // odd to have a node without partner
+	const int num_threads = GetParam();
+
+	auto edges = TestGraphs::powerlawGraph(num_nodes, 100, stxxl::get_next_seed());
+	const auto degrees = TestGraphs::degrees(edges, num_nodes);
+	std::sort(edges.begin(), edges.end());
+
+	Curveball::IMCurveball algo(degrees, edges, num_threads, 1);
+	algo.run(5);
+
+	const auto result = algo.getEdges();
+	ASSERT_EQ(result.size(), edges.size());
+
+	for (size_t i = 0; i < result.size(); ++i) {
+		ASSERT_LT(result[i].first, result[i].second);
+		if (i)
+			ASSERT_LT(result[i - 1], result[i]);
+	}
+
+	ASSERT_EQ(degrees, TestGraphs::degrees(result, num_nodes));
+	ASSERT_NE(edges, result);
+}
+
+TEST_P(TestIMCurveball, independentOfThreadCount) {
+	const node_t num_nodes = 1000;
+
+	auto edges = TestGraphs::powerlawGraph(num_nodes, 50, 1);
+	const auto degrees = TestGraphs::degrees(edges, num_nodes);
+	std::sort(edges.begin(), edges.end());
+
+	Curveball::IMCurveball reference(degrees, edges, 1, 42);
+	reference.run(3);
+
+	Curveball::IMCurveball algo(degrees, edges, GetParam(), 42);
+	algo.run(3);
+
+	ASSERT_EQ(reference.getEdges(), algo.getEdges());
+}
+
+INSTANTIATE_TEST_CASE_P(IMCurveballThreads, TestIMCurveball, ::testing::Values(1, 4));
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <Utils/IntSorter.h>
+
+class TestIntSorter : public ::testing::TestWithParam<size_t> {
+protected:
+    template <typename Msg, typename KeyExtract>
+    void _compare_with_std_sort(const std::vector<Msg> & messages) {
+        using Comparator = typename GenericComparatorStruct<Msg>::Ascending;
+
+        std::vector<Msg> expected(messages);
+        std::sort(expected.begin(), expected.end(), Comparator());
+
+        // the memory decides whether the sorter stays internal or merges runs
+        IntSorter<Msg, Comparator, KeyExtract> sorter(Comparator(), GetParam());
+
+        for (int round = 0; round < 2; ++round) {
+            for (const auto & msg : messages)
+                sorter.push(msg);
+            ASSERT_EQ(sorter.size(), messages.size());
+
+            sorter.sort();
+            ASSERT_EQ(sorter.size(), messages.size());
+
+            for (size_t i = 0; i < expected.size(); ++i, ++sorter) {
+                ASSERT_FALSE(sorter.empty());
+                ASSERT_EQ(sorter->to_tuple(), expected[i].to_tuple()) << "i=" << i;
+            }
+            ASSERT_TRUE(sorter.empty());
+
+            sorter.clear();
+        }
+    }
+};
+
+TEST_P(TestIntSorter, edgeSwapMsg) {
+    using namespace EdgeSwapTFP;
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<edgeid_t> edge_dist(0, 100000);
+
+    std::vector<EdgeSwapMsg> messages;
+    for (swapid_t sid = 0; sid < 3000000; ++sid)
+        messages.emplace_back(edge_dist(gen), sid);
+
+    _compare_with_std_sort<EdgeSwapMsg, EdgeSwapMsgKey>(messages);
+}
+
+TEST_P(TestIntSorter, existenceRequestMsg) {
+    using namespace EdgeSwapTFP;
+    std::mt19937_64 gen(2);
+    std::uniform_int_distribution<node_t> node_dist(0, 1000);
+
+    // few distinct edges to obtain long ranges of equal keys in arbitrary order
+    std::vector<ExistenceRequestMsg> messages;
+    for (swapid_t sid = 0; sid < 3000000; ++sid) {
+        edge_t e(node_dist(gen), node_dist(gen));
+        e.normalize();
+        messages.emplace_back(e, (sid * 7919) % 3000000, sid & 1);
+    }
+
+    _compare_with_std_sort<ExistenceRequestMsg, ExistenceRequestMsgKey>(messages);
+}
+
+INSTANTIATE_TEST_CASE_P(IntSorterMemory, TestIntSorter, ::testing::Values(1llu << 30, 64llu << 20));
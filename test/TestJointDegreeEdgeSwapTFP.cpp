@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <vector>
+
+#include <stxxl/stream>
+
+#include <EdgeSwaps/JointDegreeEdgeSwapTFP.h>
+
+#include "TestGraphs.h"
+
+class TestJointDegreeEdgeSwapTFP : public ::testing::Test {
+protected:
+    const node_t _num_nodes = 2000;
+
+    //! Havel-Hakimi graph relabelled such that the ids are monotonic in the realized degrees
+    std::vector<edge_t> _generate_graph() const {
+        auto edges = TestGraphs::powerlawGraph(_num_nodes);
+
+        const auto degrees = TestGraphs::degrees(edges, _num_nodes);
+        std::vector<node_t> order(_num_nodes);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&] (node_t u, node_t v) {return degrees[u] > degrees[v];});
+
+        std::vector<node_t> label(_num_nodes);
+        for (node_t i = 0; i < _num_nodes; ++i)
+            label[order[i]] = i;
+
+        for (auto & edge : edges) {
+            edge = edge_t(label[edge.first], label[edge.second]);
+            edge.normalize();
+        }
+        std::sort(edges.begin(), edges.end());
+
+        return edges;
+    }
+
+    //! Number of edges per pair of endpoint degrees
+    std::map<std::pair<degree_t, degree_t>, edgeid_t> _joint_degrees(const std::vector<edge_t> & edges, const std::vector<degree_t> & degrees) const {
+        std::map<std::pair<degree_t, degree_t>, edgeid_t> joint_degrees;
+        for (const auto & edge : edges)
+            joint_degrees[std::minmax(degrees[edge.first], degrees[edge.second])]++;
+        return joint_degrees;
+    }
+
+    //! Checks that the randomized edges form a simple graph with the joint degrees of input
+    void _check_result(EdgeStream & edges, const std::vector<edge_t> & input, const std::vector<degree_t> & degrees) const {
+        const auto result = TestGraphs::read(edges);
+        for (size_t i = 0; i < result.size(); ++i) {
+            ASSERT_FALSE(result[i].is_loop());
+            if (i) ASSERT_LT(result[i - 1], result[i]); // sorted without multi-edges
+        }
+
+        ASSERT_EQ(result.size(), input.size());
+        ASSERT_NE(result, input);
+        ASSERT_EQ(TestGraphs::degrees(result, _num_nodes), degrees);
+        ASSERT_EQ(_joint_degrees(result, degrees), _joint_degrees(input, degrees));
+    }
+};
+
+TEST_F(TestJointDegreeEdgeSwapTFP, degreeClasses) {
+    std::vector<degree_t> degrees {5, 5, 3, 2, 2, 2, 1};
+    auto degree_stream = stxxl::stream::streamify(degrees.cbegin(), degrees.cend());
+    EdgeSwapTFP::DegreeClasses classes(degree_stream);
+
+    ASSERT_EQ(classes.numNodes(), 7);
+    ASSERT_EQ(classes.numClasses(), 4u);
+    ASSERT_EQ(classes.classOf(1), 0u);
+    ASSERT_EQ(classes.classOf(2), 1u);
+    ASSERT_EQ(classes.classOf(5), 2u);
+    ASSERT_EQ(classes.degreeOf(6), 1);
+
+    std::vector<degree_t> unsorted {1, 3, 2};
+    auto unsorted_stream = stxxl::stream::streamify(unsorted.cbegin(), unsorted.cend());
+    ASSERT_THROW(EdgeSwapTFP::DegreeClasses invalid(unsorted_stream), std::runtime_error);
+}
+
+TEST_F(TestJointDegreeEdgeSwapTFP, preservesJointDegrees) {
+    const auto input = _generate_graph();
+    const auto degrees = TestGraphs::degrees(input, _num_nodes);
+
+    auto degree_stream = stxxl::stream::streamify(degrees.cbegin(), degrees.cend());
+    EdgeSwapTFP::DegreeClasses classes(degree_stream);
+
+    EdgeStream edges;
+    TestGraphs::fill(edges, input);
+
+    EdgeSwapTFP::JointDegreeEdgeSwapTFP algo(edges, classes, 500, 1llu << 28);
+    algo.run(4 * input.size(), 1);
+
+    _check_result(edges, input, degrees);
+}
+
+TEST_F(TestJointDegreeEdgeSwapTFP, multipleRunsWithShortFinalRun) {
+    const auto input = _generate_graph();
+    const auto degrees = TestGraphs::degrees(input, _num_nodes);
+
+    auto degree_stream = stxxl::stream::streamify(degrees.cbegin(), degrees.cend());
+    EdgeSwapTFP::DegreeClasses classes(degree_stream);
+
+    EdgeStream edges;
+    TestGraphs::fill(edges, input);
+
+    // every call ends with a partial run; the last one consists of a few swaps only
+    const swapid_t run_length = 500;
+    EdgeSwapTFP::JointDegreeEdgeSwapTFP algo(edges, classes, run_length, 1llu << 28);
+    algo.run(3 * run_length + 123, 1);
+    algo.run(run_length + 1, 2);
+    algo.run(7, 3);
+
+    _check_result(edges, input, degrees);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <Utils/MonotoneBucketPQ.h>
+
+// parameters: memory in bytes, keys per window
+class TestMonotoneBucketPQ : public ::testing::TestWithParam<std::tuple<size_t, uint64_t>> {
+protected:
+    using Msg = EdgeSwapTFP::DependencyChainEdgeMsg;
+    using Comparator = GenericComparatorStruct<Msg>::Descending;
+    using PQ = MonotoneBucketPQ<Msg, Comparator, EdgeSwapTFP::SwapIdKey<Msg>>;
+
+    //! Processes swaps in order and sends messages to later swaps as the
+    //! dependency chain does; the result has to match std::priority_queue
+    void _compare_with_std_pq(PQ & pq, swapid_t num_swaps, swapid_t max_distance, unsigned int seed) {
+        std::priority_queue<Msg, std::vector<Msg>, Comparator> expected;
+
+        std::mt19937_64 gen(seed);
+        std::uniform_int_distribution<swapid_t> distance_dist(1, max_distance);
+        std::uniform_int_distribution<node_t> node_dist(0, 100);
+
+        for (swapid_t sid = 0; sid < num_swaps; ++sid) {
+            while (!expected.empty() && expected.top().swap_id == sid) {
+                ASSERT_FALSE(pq.empty());
+                ASSERT_EQ(pq.top().to_tuple(), expected.top().to_tuple()) << "sid=" << sid;
+                pq.pop();
+                expected.pop();
+            }
+            ASSERT_EQ(pq.size(), expected.size());
+
+            for (unsigned int i = gen() % 4; i; --i) {
+                const Msg msg(sid + distance_dist(gen), edge_t(node_dist(gen), node_dist(gen)));
+                pq.push(msg);
+                expected.push(msg);
+            }
+        }
+
+        for (; !expected.empty(); expected.pop(), pq.pop()) {
+            ASSERT_FALSE(pq.empty());
+            ASSERT_EQ(pq.top().to_tuple(), expected.top().to_tuple());
+        }
+        ASSERT_TRUE(pq.empty());
+    }
+};
+
+TEST_P(TestMonotoneBucketPQ, shortDistances) {
+    PQ pq(std::get<0>(GetParam()), std::get<1>(GetParam()));
+    _compare_with_std_pq(pq, 200000, 100, 1);
+}
+
+TEST_P(TestMonotoneBucketPQ, longDistances) {
+    PQ pq(std::get<0>(GetParam()), std::get<1>(GetParam()));
+    _compare_with_std_pq(pq, 200000, 50000, 2);
+}
+
+TEST_P(TestMonotoneBucketPQ, reuseAfterEmpty) {
+    PQ pq(std::get<0>(GetParam()), std::get<1>(GetParam()));
+    _compare_with_std_pq(pq, 50000, 5000, 3);
+    pq.clear();
+    _compare_with_std_pq(pq, 50000, 5000, 4);
+}
+
+TEST(TestMonotoneBucketPQ, spillsToExternalMemory) {
+    using Msg = EdgeSwapTFP::DependencyChainEdgeMsg;
+    using Comparator = GenericComparatorStruct<Msg>::Descending;
+    MonotoneBucketPQ<Msg, Comparator, EdgeSwapTFP::SwapIdKey<Msg>> pq(1000 * sizeof(Msg), 64);
+
+    // all messages target future windows, hence most of them are spilled
+    for (swapid_t sid = 100000; sid > 0; --sid)
+        pq.push(Msg(sid, edge_t(0, 1)));
+    ASSERT_GT(pq.spilledElements(), 90000u);
+
+    for (swapid_t sid = 1; sid <= 100000; ++sid, pq.pop()) {
+        ASSERT_FALSE(pq.empty());
+        ASSERT_EQ(pq.top().swap_id, sid);
+    }
+    ASSERT_TRUE(pq.empty());
+}
+
+INSTANTIATE_TEST_CASE_P(TestMonotoneBucketPQ, TestMonotoneBucketPQ,
+    ::testing::Combine(::testing::Values(size_t(4) << 10, size_t(64) << 20),
+                       ::testing::Values(uint64_t(1), uint64_t(1000), uint64_t(1) << 16)));
@@ -4,6 +4,7 @@
 #include <EdgeSwaps/EdgeSwapInternalSwaps.h>
 #include <EdgeSwaps/ModifiedEdgeSwapTFP.h>
 #include <EdgeSwaps/EdgeSwapParallelTFP.h>
+#include <EdgeSwaps/ModifiedEdgeSwapParallelTFP.h>
 #include <EdgeSwaps/IMEdgeSwap.h>
 #include <ConfigurationModel/ConfigurationModelRandom.h>
 #include <Utils/StreamPusher.h>
@@ -46,7 +47,8 @@ namespace {
 	  // EdgeSwapFullyInternal<EdgeVector, SwapVector>,
 
       //EdgeSwapInternalSwaps,
-      ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP, IMEdgeSwap
+      ModifiedEdgeSwapTFP::ModifiedEdgeSwapTFP, IMEdgeSwap,
+      ModifiedEdgeSwapParallelTFP::ModifiedEdgeSwapParallelTFP
       //EdgeSwapParallelTFP::EdgeSwapParallelTFP,
    	>;
 
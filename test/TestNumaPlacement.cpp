@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <Utils/NumaPlacement.h>
+
+namespace {
+    class TestableNumaPlacement : public NumaPlacement {
+    public:
+        TestableNumaPlacement() : NumaPlacement(true) {}
+
+        using NumaPlacement::_parse_list;
+    };
+}
+
+TEST(TestNumaPlacement, parsesSysfsLists) {
+    ASSERT_EQ(TestableNumaPlacement::_parse_list("0-3,8-9,12"), (std::vector<unsigned int>{0, 1, 2, 3, 8, 9, 12}));
+    ASSERT_EQ(TestableNumaPlacement::_parse_list("5"), (std::vector<unsigned int>{5}));
+    ASSERT_TRUE(TestableNumaPlacement::_parse_list("").empty());
+}
+
+TEST(TestNumaPlacement, threadsAreSpreadEvenlyOverNodes) {
+    TestableNumaPlacement placement;
+    ASSERT_GE(placement.numNodes(), 1u);
+
+    for (int num_threads : {1, 2, 3, 8, 13}) {
+        std::vector<unsigned int> threads_per_node(placement.numNodes(), 0);
+        unsigned int previous = 0;
+        for (int tid = 0; tid < num_threads; ++tid) {
+            const unsigned int node = placement.nodeOfThread(tid, num_threads);
+            ASSERT_LT(node, placement.numNodes());
+            ASSERT_GE(node, previous); // neighbouring threads share a node
+            ASSERT_FALSE(placement.cpusOfNode(node).empty());
+            previous = node;
+            threads_per_node[node]++;
+        }
+
+        if (static_cast<unsigned int>(num_threads) >= placement.numNodes()) {
+            for (const unsigned int count : threads_per_node) {
+                ASSERT_GE(count, num_threads / placement.numNodes());
+                ASSERT_LE(count, num_threads / placement.numNodes() + 1);
+            }
+        }
+    }
+
+    // pinning is a no-op for the process-wide instance unless configured
+    NumaPlacement::ThreadPin pin(0, 1);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <vector>
+
+#include <EdgeSwaps/PayloadEdgeSwapTFP.h>
+
+#include "TestGraphs.h"
+#include "TestSwapReference.h"
+
+class TestPayloadEdgeSwapTFP : public ::testing::Test {
+protected:
+    using weighted_edge_t = std::pair<edge_t, uint32_t>;
+
+    const node_t _num_nodes = 300;
+
+    //! Exposes the node ids stored by a stream in write mode
+    template <typename Payload>
+    class InspectableEdgeStream : public BasicEdgeStream<Payload> {
+    public:
+        std::vector<node_t> storedNodes() const {
+            std::vector<node_t> result;
+            for (typename BasicEdgeStream<Payload>::em_reader_t reader(*this->_em_buffer); !reader.empty(); ++reader)
+                result.push_back(*reader);
+            return result;
+        }
+    };
+
+    //! Random graph whose i-th edge has the weight i
+    std::vector<weighted_edge_t> _generate_edges(size_t num_edges) const {
+        std::vector<weighted_edge_t> result;
+        for (const auto & edge : TestGraphs::randomGraph(_num_nodes, num_edges, false))
+            result.emplace_back(edge, result.size());
+        return result;
+    }
+
+    //! Executes the swaps in runs of run_length swaps and returns the edges with their weights
+    std::vector<weighted_edge_t> _randomize(const std::vector<weighted_edge_t> & input, const std::vector<SwapDescriptor> & swaps,
+                                            swapid_t run_length) const {
+        BasicEdgeStream<uint32_t> edges;
+        for (const auto & edge : input)
+            edges.push(edge.first, edge.second);
+        edges.consume();
+
+        EdgeSwapTFP::PayloadEdgeSwapTFP<uint32_t> algo(edges, run_length, _num_nodes, 1llu << 28);
+        SwapReference::pushInRuns(algo, swaps, run_length);
+
+        std::vector<weighted_edge_t> result;
+        for (edges.rewind(); !edges.empty(); ++edges)
+            result.emplace_back(*edges, edges.payload());
+        return result;
+    }
+
+    void _check_reference(swapid_t num_swaps, swapid_t run_length) const {
+        const auto input = _generate_edges(3000);
+        const auto swaps = SwapReference::swaps(num_swaps, input.size());
+
+        std::vector<weighted_edge_t> reference(input);
+        const swapid_t performed = SwapReference::simulate(reference, swaps, run_length, SwapReference::undirectedSwap);
+        ASSERT_GT(performed, swaps.size() / 4);
+
+        ASSERT_EQ(_randomize(input, swaps, run_length), reference);
+    }
+};
+
+TEST_F(TestPayloadEdgeSwapTFP, payloadFollowsItsEdgeId) {
+    const std::vector<weighted_edge_t> input {{{0, 1}, 10}, {{2, 3}, 20}};
+
+    // {0, 1} x {2, 3} yields {1, 2} for edge id 0 and {0, 3} for edge id 1
+    {
+        const std::vector<weighted_edge_t> expected {{{0, 3}, 20}, {{1, 2}, 10}};
+        ASSERT_EQ(_randomize(input, {SwapDescriptor(0, 1, true)}, 1), expected);
+    }
+
+    // {0, 1} x {2, 3} yields {0, 2} for edge id 0 and {1, 3} for edge id 1
+    {
+        const std::vector<weighted_edge_t> expected {{{0, 2}, 10}, {{1, 3}, 20}};
+        ASSERT_EQ(_randomize(input, {SwapDescriptor(0, 1, false)}, 1), expected);
+    }
+}
+
+TEST_F(TestPayloadEdgeSwapTFP, matchesSequentialSwaps) {
+    _check_reference(3000, 3000);
+}
+
+TEST_F(TestPayloadEdgeSwapTFP, payloadsSurviveMultipleRuns) {
+    // every run writes the payloads back in the order of the new edge ids
+    _check_reference(4 * 3000 + 123, 500);
+}
+
+TEST_F(TestPayloadEdgeSwapTFP, topologyMatchesEdgeSwapTFP) {
+    const auto input = _generate_edges(3000);
+    const auto swaps = SwapReference::swaps(4 * input.size(), input.size());
+
+    const auto result = _randomize(input, swaps, 500);
+
+    // the payloads must not change the swaps
+    EdgeStream edges;
+    for (const auto & edge : input)
+        edges.push(edge.first);
+    edges.consume();
+
+    EdgeSwapTFP::EdgeSwapTFP algo(edges, 500, _num_nodes, 1llu << 28);
+    SwapReference::pushInRuns(algo, swaps, 500);
+
+    ASSERT_EQ(result.size(), input.size());
+    std::vector<bool> seen(input.size(), false);
+    edges.rewind();
+    for (const auto & edge : result) {
+        ASSERT_FALSE(edges.empty());
+        ASSERT_EQ(edge.first, *edges);
+        ++edges;
+
+        // every weight is kept exactly once
+        ASSERT_LT(edge.second, input.size());
+        ASSERT_FALSE(seen[edge.second]);
+        seen[edge.second] = true;
+    }
+    ASSERT_TRUE(edges.empty());
+}
+
+TEST_F(TestPayloadEdgeSwapTFP, emptyPayloadKeepsEdgeStreamLayout) {
+    static_assert(std::is_same<EdgeStream, BasicEdgeStream<EmptyPayload>>::value, "EdgeStream has no payload");
+
+    const auto input = _generate_edges(1000);
+    InspectableEdgeStream<EmptyPayload> topology;
+    InspectableEdgeStream<uint32_t> weighted;
+    for (const auto & edge : input) {
+        topology.push(edge.first);
+        weighted.push(edge.first, edge.second);
+    }
+
+    // the adjacency lists of the first nodes, separated by INVALID_NODE, as before payloads
+    std::vector<node_t> expected;
+    node_t first = 0;
+    for (const auto & edge : input) {
+        for (; first < edge.first.first; ++first)
+            expected.push_back(INVALID_NODE);
+        expected.push_back(edge.first.second);
+    }
+
+    ASSERT_EQ(topology.storedNodes(), expected);
+    ASSERT_EQ(weighted.storedNodes(), expected);
+}
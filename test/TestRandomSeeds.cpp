@@ -0,0 +1,56 @@
+/**
+ * @file TestRandomSeeds.cpp
+ * @date 18. October 2026
+ *
+ * @author Michael Hamann
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include <Utils/RandomSeeds.h>
+
+class TestRandomSeeds : public ::testing::Test {
+};
+
+TEST_F(TestRandomSeeds, streamsAreReproducible) {
+    const RandomSeeds a(1234);
+    const RandomSeeds b(1234);
+
+    // the seed of a stream does not depend on the order of requests
+    const seed_t late = b(7, 3);
+    ASSERT_EQ(a(0, 0), b(0, 0));
+    ASSERT_EQ(a(7, 3), late);
+    ASSERT_EQ(a.substreams(2, 5)(1), b.substreams(2, 5)(1));
+}
+
+TEST_F(TestRandomSeeds, streamsDiffer) {
+    const RandomSeeds seeds(1234);
+    std::set<uint64_t> keys;
+
+    for (uint64_t phase = 0; phase < 16; ++phase) {
+        for (uint64_t index = 0; index < 256; ++index) {
+            ASSERT_NE(seeds(phase, index), 0u);
+            keys.insert(seeds.key(phase, index));
+        }
+    }
+
+    ASSERT_EQ(keys.size(), 16u * 256u);
+    ASSERT_NE(RandomSeeds(1)(0), RandomSeeds(2)(0));
+}
+
+TEST_F(TestRandomSeeds, engineIsReproducible) {
+    SplitMix64Engine a(99);
+    SplitMix64Engine b(99);
+    SplitMix64Engine c(100);
+
+    bool differs = false;
+    for (int i = 0; i < 100; ++i) {
+        const auto x = a();
+        ASSERT_EQ(x, b());
+        differs |= (x != c());
+    }
+
+    ASSERT_TRUE(differs);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Utils/RunProfile.h>
+#include <EdgeSwaps/EdgeSwapTFP.h>
+#include <SwapGenerator.h>
+
+#include "TestGraphs.h"
+#include "TestRunProfileRecords.h"
+
+using RunProfileRecords::lines;
+using RunProfileRecords::field;
+
+TEST(TestRunProfile, disabledWritesNothing) {
+    RunProfile profile;
+    ASSERT_FALSE(profile.enabled());
+
+    profile.beginRun("engine", 0);
+    profile.beginPhase("phase");
+    profile.set("counter", 1);
+    profile.endRun();
+
+    std::ostringstream os;
+    profile.setOutput(&os);
+    profile.setOutput(nullptr);
+    profile.endRun();
+    ASSERT_TRUE(os.str().empty());
+}
+
+TEST(TestRunProfile, writesOneLinePerRun) {
+    std::ostringstream os;
+    RunProfile profile;
+    profile.setOutput(&os);
+
+    for (uint64_t run = 0; run < 3; ++run) {
+        profile.beginRun("engine", run);
+        profile.set("swaps", 10 * run);
+        profile.beginPhase("first");
+        profile.add("sum", 1);
+        profile.add("sum", 2);
+        profile.beginPhase("second");
+        profile.max("peak", 5);
+        profile.max("peak", 3);
+        profile.setReal("load", 0.5);
+        profile.endRun();
+    }
+
+    // counters outside of a run are ignored
+    profile.set("swaps", 1);
+
+    const auto records = lines(os.str());
+    ASSERT_EQ(records.size(), 3u);
+    for (uint64_t run = 0; run < 3; ++run) {
+        const std::string & record = records[run];
+        ASSERT_EQ(record.front(), '{');
+        ASSERT_EQ(record.back(), '}');
+        ASSERT_NE(record.find("\"engine\":\"engine\""), std::string::npos);
+        ASSERT_EQ(field(record, "run"), run);
+        ASSERT_EQ(field(record, "swaps"), 10 * run);
+        ASSERT_EQ(field(record, "sum"), 3u);
+        ASSERT_EQ(field(record, "peak"), 5u);
+        ASSERT_NE(record.find("\"load\":0.5"), std::string::npos);
+        ASSERT_NE(record.find("\"first\":{\"seconds\":"), std::string::npos);
+        ASSERT_NE(record.find("\"second\":{\"seconds\":"), std::string::npos);
+    }
+}
+
+TEST(TestRunProfile, concurrentProfilesShareOutput) {
+    std::ostringstream os;
+    const unsigned int num_threads = 4;
+    const uint64_t num_runs = 200;
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&os, t] {
+            RunProfile profile;
+            profile.setOutput(&os);
+            for (uint64_t run = 0; run < num_runs; ++run) {
+                profile.beginRun("engine", run);
+                profile.set("thread", t);
+                profile.endRun();
+            }
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    const auto records = lines(os.str());
+    ASSERT_EQ(records.size(), num_threads * num_runs);
+
+    std::vector<uint64_t> runs_per_thread(num_threads, 0);
+    for (const auto & record : records) {
+        ASSERT_EQ(record.front(), '{');
+        ASSERT_EQ(record.back(), '}');
+        const uint64_t t = field(record, "thread");
+        ASSERT_LT(t, num_threads);
+        ASSERT_EQ(field(record, "run"), runs_per_thread[t]++);
+    }
+}
+
+TEST(TestRunProfile, edgeSwapTFPReportsEveryRun) {
+    const node_t num_nodes = 2000;
+    const swapid_t run_length = 1000;
+
+    EdgeStream edges;
+    TestGraphs::fill(edges, TestGraphs::powerlawGraph(num_nodes));
+
+    std::ostringstream os;
+    const swapid_t num_swaps = 4 * run_length;
+    {
+        EdgeSwapTFP::EdgeSwapTFP algo(edges, run_length, num_nodes, 1llu << 30);
+        algo.setRunProfile(&os);
+        for (SwapGenerator swap_gen(num_swaps, edges.size(), 1); !swap_gen.empty(); ++swap_gen)
+            algo.push(*swap_gen);
+        algo.run();
+    }
+
+    const auto records = lines(os.str());
+    ASSERT_EQ(records.size(), num_swaps / run_length);
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const std::string & record = records[i];
+        ASSERT_EQ(field(record, "run"), i);
+
+        const uint64_t swaps = field(record, "swaps");
+        ASSERT_EQ(swaps, run_length);
+        ASSERT_EQ(field(record, "performed") + field(record, "rejected_loop")
+                  + field(record, "rejected_multi_edge") + field(record, "rejected_invalid"), swaps);
+
+        // swaps requesting the same edge form a dependency chain
+        ASSERT_GT(field(record, "requested_edges"), 0u);
+        ASSERT_LE(field(record, "requested_edges"), 2 * swaps);
+        ASSERT_GE(field(record, "max_dependency_chain"), 1u);
+        ASSERT_NE(record.find("\"perform_swaps\":{"), std::string::npos);
+    }
+}
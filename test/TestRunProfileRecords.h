@@ -0,0 +1,40 @@
+#pragma once
+/**
+ * @file
+ * @brief  Access to the JSON lines written by RunProfile in tests
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace RunProfileRecords {
+    inline std::vector<std::string> lines(const std::string & str) {
+        std::vector<std::string> result;
+        std::istringstream is(str);
+        for (std::string line; std::getline(is, line); )
+            result.push_back(line);
+        return result;
+    }
+
+    //! Integer value of the first occurrence of "key": in a record
+    inline uint64_t field(const std::string & record, const std::string & key) {
+        const std::string pattern = "\"" + key + "\":";
+        const auto pos = record.find(pattern);
+        EXPECT_NE(pos, std::string::npos) << key << " missing in " << record;
+        if (pos == std::string::npos)
+            return 0;
+        return std::stoull(record.substr(pos + pattern.size()));
+    }
+
+    //! Sum of an integer field over all records
+    inline uint64_t total(const std::vector<std::string> & records, const std::string & key) {
+        uint64_t result = 0;
+        for (const auto & record : records)
+            result += field(record, key);
+        return result;
+    }
+}
@@ -81,6 +81,44 @@ TEST_F(TestSemiLoadedSwaps, testCombinedSwaps) {
     ASSERT_EQ(*edge_list, edge_t(3, 4));
 }
 
+TEST_F(TestSemiLoadedSwaps, testOnlyLoadedSwaps) {
+    EdgeStream edge_list;
+    edge_list.push({0, 1});
+    edge_list.push({2, 3});
+    edge_list.push({4, 5});
+    edge_list.push({6, 7});
+    edge_list.consume();
+
+    EdgeSwapTFP::SemiLoadedEdgeSwapTFP algo(edge_list, 100, 8, 1llu << 30);
+
+    // same swaps as in testOnlySemiLoadedSwaps
+    algo.push(LoadedSwapDescriptor {edge_t {0, 1}, edge_t {2, 3}, true});
+    algo.push(LoadedSwapDescriptor {edge_t {6, 7}, edge_t {4, 5}, true});
+    algo.push(LoadedSwapDescriptor {edge_t {10, 12}, edge_t {6, 7}, true}); // cannot be loaded, should be ignored
+    algo.push(LoadedSwapDescriptor {edge_t {0, 1}, edge_t {4, 5}, true});
+    algo.push(LoadedSwapDescriptor {edge_t {2, 3}, edge_t {6, 7}, true});
+
+    algo.run();
+
+    auto & debug = algo.debugVector();
+
+    ASSERT_EQ(debug.size(), 4U);
+
+    ASSERT_TRUE(debug[0].performed);
+    ASSERT_TRUE(debug[1].performed);
+    ASSERT_TRUE(debug[2].performed);
+    ASSERT_TRUE(debug[3].performed);
+
+    edge_list.rewind();
+    ASSERT_EQ(*edge_list, edge_t(0, 7));
+    ++edge_list;
+    ASSERT_EQ(*edge_list, edge_t(1, 6));
+    ++edge_list;
+    ASSERT_EQ(*edge_list, edge_t(2, 5));
+    ++edge_list;
+    ASSERT_EQ(*edge_list, edge_t(3, 4));
+}
+
 TEST_F(TestSemiLoadedSwaps, testLoadedIsSameAsId) {
     EdgeStream edge_list;
     edge_list.push({0, 1});
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <EdgeStream.h>
+#include <EdgeSwaps/SwapConvergenceMonitor.h>
+
+class TestSwapConvergenceMonitor : public ::testing::Test {
+protected:
+    void _fill(EdgeStream & es, const std::vector<edge_t> & edges) {
+        for(const auto & e : edges)
+            es.push(e);
+        es.consume();
+    }
+
+    void _observe_run(SwapConvergenceMonitor & monitor, const std::vector<edge_t> & edges) {
+        monitor.begin_run();
+        for(const auto & e : edges)
+            monitor.observe(e);
+        monitor.end_run();
+    }
+};
+
+TEST_F(TestSwapConvergenceMonitor, pathAssortativity) {
+    // the path P4 has a degree assortativity of -1/2
+    std::vector<edge_t> edges = {{0, 1}, {1, 2}, {2, 3}};
+    EdgeStream es;
+    _fill(es, edges);
+
+    SwapConvergenceMonitor monitor(es, 4);
+    ASSERT_NEAR(monitor.assortativity(), -0.5, 1e-9);
+    ASSERT_EQ(*es, edge_t(0, 1)); // stream is rewound
+
+    _observe_run(monitor, edges);
+    ASSERT_NEAR(monitor.assortativity(), -0.5, 1e-9);
+    ASSERT_DOUBLE_EQ(monitor.untouched_fraction(), 1.0);
+}
+
+TEST_F(TestSwapConvergenceMonitor, convergesOnStationaryGraph) {
+    std::vector<edge_t> initial = {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}};
+    std::vector<edge_t> swapped = {{0, 3}, {0, 4}, {1, 2}, {1, 3}, {2, 3}};
+    EdgeStream es;
+    _fill(es, initial);
+
+    SwapConvergenceMonitor::Parameters params;
+    params.window = 2;
+    params.seed = 1;
+    SwapConvergenceMonitor monitor(es, 5, params);
+
+    // a change of the graph resets the window
+    _observe_run(monitor, swapped);
+    ASSERT_FALSE(monitor.converged());
+    ASSERT_LT(monitor.untouched_fraction(), 1.0);
+
+    _observe_run(monitor, swapped);
+    ASSERT_FALSE(monitor.converged());
+
+    _observe_run(monitor, swapped);
+    ASSERT_TRUE(monitor.converged());
+    ASSERT_EQ(monitor.runs(), 3u);
+}
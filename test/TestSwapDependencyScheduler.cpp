@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <EdgeSwaps/SwapDependencyScheduler.h>
+
+class TestSwapDependencyScheduler : public ::testing::TestWithParam<int> {
+protected:
+    using task_t = SwapDependencyScheduler::task_t;
+
+    //! Random dependencies as in a swap batch: every task has up to two successors
+    //! and chains are local, i.e. often cross thread boundaries
+    void _run_batch(SwapDependencyScheduler & scheduler, int num_threads, task_t num_tasks, unsigned int seed) {
+        std::mt19937_64 prng(seed);
+        std::uniform_int_distribution<task_t> distance(1, 3 * num_threads);
+
+        std::vector<std::vector<task_t>> successors(num_tasks);
+        std::vector<uint32_t> predecessors(num_tasks, 0);
+        for (task_t i = 0; i < num_tasks; ++i) {
+            for (int k = 0; k < 2; ++k) {
+                const task_t j = i + distance(prng);
+                if (prng() % 4 && j < num_tasks) {
+                    successors[i].push_back(j);
+                    predecessors[j]++;
+                }
+            }
+        }
+
+        std::vector<std::atomic<uint32_t>> executed(num_tasks);
+        std::vector<std::atomic<uint32_t>> resolved(num_tasks);
+        for (task_t i = 0; i < num_tasks; ++i) {
+            executed[i] = 0;
+            resolved[i] = 0;
+        }
+
+        scheduler.startBatch(num_tasks);
+        for (task_t i = 0; i < num_tasks; ++i)
+            scheduler.setDependencies(i, predecessors[i]);
+
+        std::vector<std::thread> threads;
+        for (int tid = 0; tid < num_threads; ++tid) {
+            threads.emplace_back([&, tid] {
+                scheduler.run(tid, [&] (int executor, task_t task) {
+                    ASSERT_EQ(executor, tid);
+                    ASSERT_EQ(resolved[task].load(), predecessors[task]);
+                    executed[task]++;
+
+                    for (const task_t j : successors[task]) {
+                        resolved[j]++;
+                        scheduler.resolve(tid, j);
+                    }
+                });
+            });
+        }
+        for (auto & t : threads)
+            t.join();
+
+        for (task_t i = 0; i < num_tasks; ++i)
+            ASSERT_EQ(executed[i].load(), 1u) << "task " << i;
+    }
+};
+
+TEST_P(TestSwapDependencyScheduler, executesEveryTaskAfterItsPredecessors) {
+    const int num_threads = GetParam();
+    const task_t max_tasks = 20000;
+
+    // a small deque forces ready tasks into the overflow
+    SwapDependencyScheduler scheduler(num_threads, max_tasks, 16);
+    for (unsigned int batch = 0; batch < 5; ++batch)
+        _run_batch(scheduler, num_threads, max_tasks - batch * 1000, batch);
+
+    if (num_threads > 1) {
+        ASSERT_GT(scheduler.parkedTasks(), 0u);
+    }
+}
+
+TEST_P(TestSwapDependencyScheduler, chainAcrossAllThreads) {
+    const int num_threads = GetParam();
+    const task_t num_tasks = 1000;
+
+    // task i depends on i-1, i.e. all but the first task of every thread are parked
+    SwapDependencyScheduler scheduler(num_threads, num_tasks);
+    scheduler.startBatch(num_tasks);
+    for (task_t i = 0; i < num_tasks; ++i)
+        scheduler.setDependencies(i, i > 0);
+
+    std::atomic<task_t> next(0);
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; ++tid) {
+        threads.emplace_back([&, tid] {
+            scheduler.run(tid, [&] (int, task_t task) {
+                ASSERT_EQ(next.load(), task);
+                next++;
+                if (task + 1 < num_tasks)
+                    scheduler.resolve(tid, task + 1);
+            });
+        });
+    }
+    for (auto & t : threads)
+        t.join();
+
+    ASSERT_EQ(next.load(), num_tasks);
+}
+
+TEST_P(TestSwapDependencyScheduler, idleThreadsSleepUntilBatchIsDone) {
+    const int num_threads = GetParam();
+    const task_t num_tasks = 4 * num_threads;
+
+    // all tasks depend on the first one, which takes long
+    SwapDependencyScheduler scheduler(num_threads, num_tasks);
+    scheduler.startBatch(num_tasks);
+    for (task_t i = 0; i < num_tasks; ++i)
+        scheduler.setDependencies(i, i > 0);
+
+    std::vector<std::atomic<uint32_t>> executed(num_tasks);
+    for (auto & e : executed)
+        e = 0;
+
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; ++tid) {
+        threads.emplace_back([&, tid] {
+            scheduler.run(tid, [&] (int, task_t task) {
+                if (!task) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    for (task_t i = 1; i < num_tasks; ++i)
+                        scheduler.resolve(tid, i);
+                }
+                executed[task]++;
+            });
+        });
+    }
+    for (auto & t : threads)
+        t.join();
+
+    for (task_t i = 0; i < num_tasks; ++i)
+        ASSERT_EQ(executed[i].load(), 1u);
+
+    if (num_threads > 1) {
+        ASSERT_GT(scheduler.idleSleeps(), 0u);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(TestSwapDependencySchedulerInst, TestSwapDependencyScheduler, ::testing::Values(1, 2, 4, 7));
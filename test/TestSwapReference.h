@@ -0,0 +1,100 @@
+#pragma once
+/**
+ * @file
+ * @brief  Sequential reference of the swaps executed by the EdgeSwapTFP engines
+ */
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <defs.h>
+#include <Swaps.h>
+#include <SwapGenerator.h>
+
+namespace SwapReference {
+    using swap_rule_t = std::pair<edge_t, edge_t> (*)(const edge_t &, const edge_t &, bool);
+
+    //! EdgeSwapTFP: {a, b} and {c, d} become {b, c} and {a, d} (direction true) or {c, a} and {b, d}
+    inline std::pair<edge_t, edge_t> undirectedSwap(const edge_t & e0, const edge_t & e1, bool direction) {
+        edge_t t0 = direction ? edge_t(e0.second, e1.first) : edge_t(e1.first, e0.first);
+        edge_t t1 = direction ? edge_t(e0.first, e1.second) : edge_t(e0.second, e1.second);
+        t0.normalize();
+        t1.normalize();
+        return {t0, t1};
+    }
+
+    //! DirectedEdgeSwapTFP: the arcs (a, b) and (c, d) become (c, b) and (a, d)
+    inline std::pair<edge_t, edge_t> directedSwap(const edge_t & a0, const edge_t & a1, bool) {
+        return {edge_t(a1.first, a0.second), edge_t(a0.first, a1.second)};
+    }
+
+    inline edge_t & edgeOf(edge_t & edge) { return edge; }
+
+    template <typename Payload>
+    edge_t & edgeOf(std::pair<edge_t, Payload> & edge) { return edge.first; }
+
+    //! Swaps of SwapGenerator for a graph with num_edges edges
+    inline std::vector<SwapDescriptor> swaps(swapid_t num_swaps, edgeid_t num_edges, seed_t seed = 2) {
+        std::vector<SwapDescriptor> result;
+        for (SwapGenerator swap_gen(num_swaps, num_edges, seed); !swap_gen.empty(); ++swap_gen)
+            result.push_back(*swap_gen);
+        return result;
+    }
+
+    /**
+     * Executes the swaps one after another in runs of run_length swaps. Within a run,
+     * the swaps refer to the ids of the edges sorted at the begin of the run, which is
+     * what the engines do if run() is called after every run, see pushInRuns().
+     * An edge is either an edge_t or a pair of an edge_t and its payload; a new edge
+     * replaces the edge of the same id and keeps its payload. A swap is rejected if it
+     * yields a loop or an existing edge.
+     *
+     * @return Number of performed swaps
+     */
+    template <typename Edge>
+    swapid_t simulate(std::vector<Edge> & edges, const std::vector<SwapDescriptor> & swaps, swapid_t run_length, swap_rule_t rule) {
+        std::set<edge_t> existing;
+        for (auto & edge : edges)
+            existing.insert(edgeOf(edge));
+
+        swapid_t performed = 0;
+        for (size_t begin = 0; begin < swaps.size(); begin += run_length) {
+            const size_t end = std::min<size_t>(begin + run_length, swaps.size());
+            for (size_t i = begin; i < end; ++i) {
+                edge_t & e0 = edgeOf(edges[swaps[i].edges()[0]]);
+                edge_t & e1 = edgeOf(edges[swaps[i].edges()[1]]);
+                const auto swapped = rule(e0, e1, swaps[i].direction());
+
+                if (swapped.first.is_loop() || swapped.second.is_loop()
+                    || existing.count(swapped.first) || existing.count(swapped.second))
+                    continue;
+
+                existing.erase(e0);
+                existing.erase(e1);
+                existing.insert(swapped.first);
+                existing.insert(swapped.second);
+                e0 = swapped.first;
+                e1 = swapped.second;
+                performed++;
+            }
+
+            // the engines write the edges back in sorted order; edges are unique
+            std::sort(edges.begin(), edges.end(), [] (Edge & a, Edge & b) {return edgeOf(a) < edgeOf(b);});
+        }
+
+        return performed;
+    }
+
+    //! Pushes the swaps into algo and calls run() after every run_length swaps, so no run is
+    //! cut by the engine itself if it was constructed with at least this run length
+    template <typename Algo>
+    void pushInRuns(Algo & algo, const std::vector<SwapDescriptor> & swaps, swapid_t run_length) {
+        for (size_t i = 0; i < swaps.size(); ++i) {
+            algo.push(swaps[i]);
+            if ((i + 1) % run_length == 0 || i + 1 == swaps.size())
+                algo.run();
+        }
+    }
+}
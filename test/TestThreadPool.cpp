@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <Utils/ThreadPool.h>
+
+namespace {
+    // every level waits for a task it submitted, i.e. the recursion is
+    // deeper than the number of workers
+    unsigned int nested_sum(unsigned int depth) {
+        if (!depth)
+            return 0;
+
+        auto child = ThreadPool::instance().submit([depth] {return nested_sum(depth - 1);}, "TestThreadPool::nested");
+        return depth + ThreadPool::instance().wait(child);
+    }
+}
+
+TEST(TestThreadPool, submitAndWait) {
+    auto & pool = ThreadPool::instance();
+    ASSERT_GT(pool.numThreads(), 0u);
+
+    std::vector<std::future<unsigned int>> futures;
+    for (unsigned int i = 0; i < 100; ++i)
+        futures.push_back(pool.submit([i] {return i * i;}));
+
+    for (unsigned int i = 0; i < 100; ++i)
+        ASSERT_EQ(pool.wait(futures[i]), i * i);
+}
+
+TEST(TestThreadPool, nestedWaitsDoNotDeadlock) {
+    const unsigned int depth = 4 * ThreadPool::instance().numThreads() + 10;
+    ASSERT_EQ(nested_sum(depth), depth * (depth + 1) / 2);
+}
+
+TEST(TestThreadPool, waitOnlyExecutesTasksOfItsOwner) {
+    auto & pool = ThreadPool::instance();
+    const unsigned int num_threads = pool.numThreads();
+
+    // occupy all workers such that the waiting thread has to execute the task itself
+    std::atomic<bool> release(false);
+    std::atomic<unsigned int> blocked(0);
+    std::vector<std::future<void>> blockers;
+    for (unsigned int i = 0; i < num_threads; ++i) {
+        blockers.push_back(pool.submit([&] {
+            blocked++;
+            while (!release) std::this_thread::yield();
+        }, "TestThreadPool::blocker"));
+    }
+    while (blocked < num_threads) std::this_thread::yield();
+
+    const auto waiting_thread = std::this_thread::get_id();
+    std::atomic<unsigned int> unrelated_in_waiting_thread(0);
+    std::vector<std::future<void>> unrelated;
+    for (unsigned int i = 0; i < 10; ++i) {
+        unrelated.push_back(pool.submit([&] {
+            unrelated_in_waiting_thread += (std::this_thread::get_id() == waiting_thread);
+        }, "TestThreadPool::unrelated"));
+    }
+
+    const int owner = 0;
+    auto own = pool.submit([&] {return std::this_thread::get_id();}, "TestThreadPool::own", &owner);
+    ASSERT_EQ(pool.wait(own, &owner), waiting_thread);
+    ASSERT_EQ(unrelated_in_waiting_thread, 0u);
+
+    release = true;
+    for (auto & f : blockers)
+        f.wait();
+    for (auto & f : unrelated)
+        f.wait();
+    ASSERT_EQ(unrelated_in_waiting_thread, 0u);
+}
+
+TEST(TestThreadPool, serialQueueKeepsOrder) {
+    std::vector<unsigned int> order;
+    std::atomic<unsigned int> running(0);
+    bool overlapped = false;
+
+    {
+        SerialTaskQueue queue("TestThreadPool::serial");
+        for (unsigned int i = 0; i < 1000; ++i) {
+            queue.submit([&, i] {
+                overlapped |= (running++ != 0);
+                order.push_back(i);
+                running--;
+            });
+        }
+        queue.waitAll();
+        ASSERT_EQ(order.size(), 1000u);
+
+        auto last = queue.submit([] {return 42;});
+        ASSERT_EQ(ThreadPool::instance().wait(last), 42);
+    }
+
+    ASSERT_FALSE(overlapped);
+    for (unsigned int i = 0; i < order.size(); ++i)
+        ASSERT_EQ(order[i], i);
+}
+
+TEST(TestThreadPool, profiling) {
+    auto & pool = ThreadPool::instance();
+    pool.resetStats();
+    pool.setProfiling(true);
+
+    std::vector<std::future<void>> futures;
+    for (unsigned int i = 0; i < 10; ++i)
+        futures.push_back(pool.submit([] {}, "TestThreadPool::profiled"));
+    for (auto & f : futures)
+        pool.wait(f);
+
+    pool.setProfiling(false);
+
+    const auto stats = pool.stats();
+    ASSERT_EQ(stats.count("TestThreadPool::profiled"), 1u);
+    ASSERT_EQ(stats.at("TestThreadPool::profiled").tasks, 10u);
+    ASSERT_GE(stats.at("TestThreadPool::profiled").run_seconds, 0.0);
+
+    pool.resetStats();
+    ASSERT_TRUE(pool.stats().empty());
+}
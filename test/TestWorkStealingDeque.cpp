@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <Utils/WorkStealingDeque.h>
+
+TEST(TestWorkStealingDeque, ownerIsLifoThiefIsFifo) {
+    WorkStealingDeque<uint32_t> deque(8);
+    ASSERT_EQ(deque.capacity(), 8);
+
+    for (uint32_t i = 0; i < 8; ++i)
+        ASSERT_TRUE(deque.push(i));
+    ASSERT_FALSE(deque.push(8));
+    ASSERT_EQ(deque.size(), 8);
+
+    uint32_t value;
+    ASSERT_TRUE(deque.pop(value));
+    ASSERT_EQ(value, 7u);
+    ASSERT_TRUE(deque.steal(value));
+    ASSERT_EQ(value, 0u);
+
+    // space freed by steal() is reused
+    ASSERT_TRUE(deque.push(8));
+    ASSERT_TRUE(deque.push(9));
+    ASSERT_FALSE(deque.push(10));
+
+    std::vector<uint32_t> popped;
+    while (deque.pop(value))
+        popped.push_back(value);
+    ASSERT_EQ(popped, (std::vector<uint32_t>{9, 8, 6, 5, 4, 3, 2, 1}));
+    ASSERT_FALSE(deque.steal(value));
+}
+
+TEST(TestWorkStealingDeque, everyItemIsTakenOnce) {
+    constexpr uint32_t num_items = 200000;
+    constexpr unsigned int num_thieves = 3;
+
+    WorkStealingDeque<uint32_t> deque(64);
+    std::vector<std::atomic<uint32_t>> taken(num_items);
+    for (auto & t : taken)
+        t = 0;
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for (unsigned int i = 0; i < num_thieves; ++i) {
+        thieves.emplace_back([&] {
+            uint32_t value;
+            while (!done.load()) {
+                if (deque.steal(value))
+                    taken[value]++;
+            }
+        });
+    }
+
+    uint32_t value;
+    for (uint32_t i = 0; i < num_items; ) {
+        if (deque.push(i)) {
+            ++i;
+        } else if (deque.pop(value)) {
+            taken[value]++;
+        }
+
+        if (i % 3 == 0 && deque.pop(value))
+            taken[value]++;
+    }
+    while (deque.pop(value))
+        taken[value]++;
+
+    done = true;
+    for (auto & t : thieves)
+        t.join();
+
+    ASSERT_EQ(deque.size(), 0);
+
+    for (uint32_t i = 0; i < num_items; ++i)
+        ASSERT_EQ(taken[i].load(), 1u) << "item " << i;
+}